@@ -0,0 +1,34 @@
+/************************************************************************//**
+* @file EBackpressure.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief EBackpressure enumeration declaration.
+*
+* @details Enumeration of the behaviours of a full parse pool queue.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_BACKPRESSURE_H___
+#define ___SHADER_PARSER_BACKPRESSURE_H___
+
+#include "ShaderParserPrerequisites.h"
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** Enumeration of the behaviours of a full bounded queue (parse pool requests, log messages), when a new item is submitted.
+	*/
+	typedef enum EBackpressure
+		: uint8_t
+	{
+		EBackpressure_BLOCK,		//!< The submitter waits until a slot is free.
+		EBackpressure_REJECT,		//!< The new item is rejected, or dropped.
+		EBackpressure_DROP_OLDEST,	//!< The oldest pending item is dropped, to make room for the new one.
+		EBackpressure_COUNT,		//!< Number of backpressure policies
+	}	EBackpressure;
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif // ___SHADER_PARSER_BACKPRESSURE_H___
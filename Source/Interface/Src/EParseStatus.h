@@ -0,0 +1,34 @@
+/************************************************************************//**
+* @file EParseStatus.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief EParseStatus enumeration declaration.
+*
+* @details Enumeration of the possible outcomes of a parse request.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_PARSE_STATUS_H___
+#define ___SHADER_PARSER_PARSE_STATUS_H___
+
+#include "ShaderParserPrerequisites.h"
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** Enumeration of the possible outcomes of a parse request.
+	*/
+	typedef enum EParseStatus
+	{
+		EParseStatus_SUCCESS,	//!< The whole source was parsed without error.
+		EParseStatus_ERROR,		//!< Syntax errors were found, the result holds a partial tree.
+		EParseStatus_CANCELLED,	//!< The request was cancelled, or ran out of budget, the result holds a partial tree.
+		EParseStatus_REJECTED,	//!< The request was rejected or dropped by a full parse pool queue, nothing was parsed.
+		EParseStatus_COUNT,		//!< Number of parse statuses
+	}	EParseStatus;
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif // ___SHADER_PARSER_PARSE_STATUS_H___
@@ -0,0 +1,33 @@
+/************************************************************************//**
+* @file EReadMethod.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief EReadMethod enumeration declaration.
+*
+* @details Enumeration of the ways FileUtils reads many files at once.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_READ_METHOD_H___
+#define ___SHADER_PARSER_READ_METHOD_H___
+
+#include "ShaderParserPrerequisites.h"
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** Enumeration of the ways to read many files at once.
+	*/
+	typedef enum EReadMethod
+		: uint8_t
+	{
+		EReadMethod_AUTO,		//!< Asynchronous reads through io_uring, when the system supports it, else EReadMethod_THREADS.
+		EReadMethod_THREADS,	//!< Blocking reads, on a pool of threads.
+		EReadMethod_COUNT,		//!< Number of read methods
+	}	EReadMethod;
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif // ___SHADER_PARSER_READ_METHOD_H___
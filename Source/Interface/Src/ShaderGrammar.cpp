@@ -12,80 +12,816 @@
 #include "ShaderParserPch.h"
 
 #include "ShaderGrammar.h"
+#include "ShaderParserCancellationToken.h"
+#include "ShaderParserFormat.h"
 #include "ShaderParserKeywords.h"
 
 BEGIN_NAMESPACE_SHADER_PARSER
 {
+	namespace
+	{
+		static const String ERROR_SYNTAX_DECLARATION = STR( "Syntax error in declaration" );
+		static const String ERROR_SYNTAX_FUNCTION_PROTOTYPE = STR( "Syntax error in function prototype" );
+		static const String ERROR_SYNTAX_STATEMENT = STR( "Syntax error in statement" );
+		static const String ERROR_NESTING_DEPTH = STR( "Nesting depth limit exceeded" );
+		static constexpr char ERROR_PARSE_FAILED[] = "{} at line {}, column {} ({} syntax errors)";
+		static constexpr char ERROR_PARSE_CANCELLED[] = "Parse cancelled after {} declarations";
+
+		/** Replaces the comments and the preprocessor directives by spaces.
+		@remarks
+			The line breaks are kept, so the offsets, lines and columns still match the original source.
+		*/
+		void BlankIgnoredText( String & text )
+		{
+			bool lineStart = true;
+			size_t i = 0;
+
+			while ( i < text.size() )
+			{
+				TChar c = text[i];
+
+				if ( c == STR( '/' ) && i + 1 < text.size() && text[i + 1] == STR( '/' ) )
+				{
+					while ( i < text.size() && text[i] != STR( '\n' ) )
+					{
+						text[i++] = STR( ' ' );
+					}
+				}
+				else if ( c == STR( '/' ) && i + 1 < text.size() && text[i + 1] == STR( '*' ) )
+				{
+					text[i++] = STR( ' ' );
+					text[i++] = STR( ' ' );
+
+					while ( i < text.size() && !( text[i] == STR( '*' ) && i + 1 < text.size() && text[i + 1] == STR( '/' ) ) )
+					{
+						if ( text[i] != STR( '\n' ) )
+						{
+							text[i] = STR( ' ' );
+						}
+
+						++i;
+					}
+
+					for ( size_t j = 0; j < 2 && i < text.size(); ++j )
+					{
+						text[i++] = STR( ' ' );
+					}
+				}
+				else if ( c == STR( '#' ) && lineStart )
+				{
+					while ( i < text.size() && text[i] != STR( '\n' ) )
+					{
+						if ( text[i] == STR( '\\' ) && i + 1 < text.size() && text[i + 1] == STR( '\n' ) )
+						{
+							text[i] = STR( ' ' );
+							i += 2;
+						}
+						else
+						{
+							text[i++] = STR( ' ' );
+						}
+					}
+				}
+				else
+				{
+					if ( c == STR( '\n' ) )
+					{
+						lineStart = true;
+					}
+					else if ( !isspace( uint8_t( c ) ) )
+					{
+						lineStart = false;
+					}
+
+					++i;
+				}
+			}
+		}
+
+		/** Skips the spaces in the given range.
+		*/
+		String::iterator SkipSpaces( String::iterator it, String::iterator last )
+		{
+			while ( it != last && isspace( uint8_t( *it ) ) )
+			{
+				++it;
+			}
+
+			return it;
+		}
+
+		/** Retrieves the word starting at the given position.
+		*/
+		String GetWord( String::iterator it, String::iterator last )
+		{
+			String::iterator end = it;
+
+			while ( end != last && ( isalnum( uint8_t( *end ) ) || *end == STR( '_' ) ) )
+			{
+				++end;
+			}
+
+			return String( it, end );
+		}
+
+		/** Retrieves the word ending right before the given position.
+		*/
+		String GetPreviousWord( String::iterator first, String::iterator it )
+		{
+			String::iterator end = it;
+
+			while ( end != first && isspace( uint8_t( *( end - 1 ) ) ) )
+			{
+				--end;
+			}
+
+			String::iterator begin = end;
+
+			while ( begin != first && ( isalnum( uint8_t( *( begin - 1 ) ) ) || *( begin - 1 ) == STR( '_' ) ) )
+			{
+				--begin;
+			}
+
+			return String( begin, end );
+		}
+
+		/** Tells if the character preceding the given position, spaces excluded, is a RIGHT_PAREN.
+		*/
+		bool FollowsRightParen( String::iterator first, String::iterator it )
+		{
+			while ( it != first && isspace( uint8_t( *( it - 1 ) ) ) )
+			{
+				--it;
+			}
+
+			return it != first && *( it - 1 ) == STR( ')' );
+		}
+
+		/** Finds the next synchronisation point, from the given position.
+		@remarks
+			The synchronisation points are a SEMICOLON at nesting level 0, or the RIGHT_BRACE closing a
+			function or control statement body.
+			Aggregate bodies (structures, interface blocks, initialisers) are followed until the SEMICOLON ending them.
+		@param[in] it
+			The construct beginning.
+		@param[in] last
+			The range end.
+		@param[out] blockBegin
+			Receives the position of the first LEFT_BRACE at nesting level 0, last if none.
+		@return
+			The position following the synchronisation point, last if none was found.
+		*/
+		String::iterator FindSynchronisationPoint( String::iterator it, String::iterator last, String::iterator & blockBegin )
+		{
+			String::iterator first = it;
+			int depth = 0;
+			bool isBody = false;
+			bool isDoBody = false;
+			blockBegin = last;
+
+			while ( it != last )
+			{
+				TChar c = *it;
+
+				if ( c == STR( '(' ) || c == STR( '[' ) )
+				{
+					++depth;
+				}
+				else if ( c == STR( ')' ) || c == STR( ']' ) )
+				{
+					depth = std::max( 0, depth - 1 );
+				}
+				else if ( c == STR( '{' ) )
+				{
+					if ( depth == 0 )
+					{
+						String previous = GetPreviousWord( first, it );
+						isDoBody = previous == STR( "do" );
+						isBody = isDoBody || previous == STR( "else" ) || FollowsRightParen( first, it );
+
+						if ( blockBegin == last )
+						{
+							blockBegin = it;
+						}
+					}
+
+					++depth;
+				}
+				else if ( c == STR( '}' ) )
+				{
+					--depth;
+
+					if ( depth < 0 )
+					{
+						// Unbalanced RIGHT_BRACE, used as synchronisation point.
+						return ++it;
+					}
+
+					if ( depth == 0 && isBody && !isDoBody )
+					{
+						String::iterator next = SkipSpaces( it + 1, last );
+
+						if ( GetWord( next, last ) != STR( "else" ) )
+						{
+							return ++it;
+						}
+					}
+				}
+				else if ( c == STR( ';' ) && depth == 0 )
+				{
+					return ++it;
+				}
+
+				++it;
+			}
+
+			return last;
+		}
+
+		/** Finds the first position where the nesting depth exceeds the given limit.
+		@remarks
+			Each opening parenthesis, bracket or brace, and each prefix operator in a row, counts for one level,
+			since they all make the grammar rules recurse.
+			The chains and nested statements, which are not delimited, are bounded by the grammar itself (see CShaderGrammar::DoNest).
+		@param[in] it, last
+			The range to check.
+		@param[in] maxDepth
+			The maximum nesting depth.
+		@return
+			The position where the limit is exceeded, last if it is not.
+		*/
+		String::iterator FindNestingOverflow( String::iterator it, String::iterator last, uint32_t maxDepth )
+		{
+			uint32_t depth = 0;
+			uint32_t prefix = 0;
+
+			for ( ; it != last; ++it )
+			{
+				TChar c = *it;
+
+				if ( c == STR( '(' ) || c == STR( '[' ) || c == STR( '{' ) )
+				{
+					++depth;
+					prefix = 0;
+				}
+				else if ( c == STR( ')' ) || c == STR( ']' ) || c == STR( '}' ) )
+				{
+					depth = depth ? depth - 1 : 0;
+					prefix = 0;
+				}
+				else if ( c == STR( '+' ) || c == STR( '-' ) || c == STR( '!' ) || c == STR( '~' ) )
+				{
+					++prefix;
+				}
+				else if ( !isspace( uint8_t( c ) ) )
+				{
+					prefix = 0;
+				}
+
+				if ( depth + prefix > maxDepth )
+				{
+					return it;
+				}
+			}
+
+			return last;
+		}
+
+		/** Finds the RIGHT_BRACE matching the LEFT_BRACE at given position.
+		*/
+		String::iterator FindMatchingBrace( String::iterator it, String::iterator last )
+		{
+			int depth = 0;
+
+			while ( it != last )
+			{
+				if ( *it == STR( '{' ) )
+				{
+					++depth;
+				}
+				else if ( *it == STR( '}' ) && --depth == 0 )
+				{
+					return it;
+				}
+
+				++it;
+			}
+
+			return last;
+		}
+
+		/** Retrieves the column of the given position, starting at 1.
+		*/
+		uint32_t GetColumn( String::iterator origin, String::iterator it )
+		{
+			String::iterator lineBegin = it;
+
+			while ( lineBegin != origin && *( lineBegin - 1 ) != STR( '\n' ) )
+			{
+				--lineBegin;
+			}
+
+			return uint32_t( it - lineBegin + 1 );
+		}
+
+		/** Adds a diagnostic for the construct at given position.
+		*/
+		void AddDiagnostic( String::iterator origin, String::iterator it, String const & message, SParseResult & result )
+		{
+			SParseDiagnostic diagnostic;
+			diagnostic.m_offset = size_t( it - origin );
+			diagnostic.m_line = uint32_t( std::count( origin, it, STR( '\n' ) ) + 1 );
+			diagnostic.m_column = GetColumn( origin, it );
+			diagnostic.m_message = message;
+			result.m_diagnostics.push_back( diagnostic );
+		}
+
+		/** Creates a node for the given range.
+		*/
+		SParseNode MakeNode( String::iterator origin, String::iterator first, String::iterator last, bool valid )
+		{
+			SParseNode node;
+			node.m_begin = size_t( first - origin );
+			node.m_end = size_t( last - origin );
+			node.m_valid = valid;
+			return node;
+		}
+
+		/** Tells if the parse request must stop.
+		@param[in] options
+			The parse options.
+		@param[in] start
+			The parse start time.
+		@param[in] parsed
+			The number of characters parsed so far.
+		*/
+		bool IsInterrupted( SParseOptions const & options, std::chrono::steady_clock::time_point const & start, size_t parsed )
+		{
+			return ( options.m_cancellation && options.m_cancellation->IsCancelled() )
+				|| ( options.m_maxBytes && parsed >= options.m_maxBytes )
+				|| ( options.m_timeout.count() && std::chrono::steady_clock::now() - start >= options.m_timeout );
+		}
+
+		/** The state of a parse request, used by the grammar semantic actions.
+		@remarks
+			Registered for the current thread during its lifetime, so a grammar can still be used by several threads.
+		*/
+		struct SParseState
+		{
+			SParseState( SParseOptions const & options, std::chrono::steady_clock::time_point const & start, String::iterator budgetOrigin )
+				: m_options( options )
+				, m_start( start )
+				, m_budgetOrigin( budgetOrigin )
+				, m_previous( Current() )
+			{
+				Current() = this;
+			}
+
+			~SParseState()
+			{
+				Current() = m_previous;
+			}
+
+			/** The state of the request parsed by the current thread, null outside of CShaderGrammar::Parse and Reparse.
+			*/
+			static SParseState *& Current()
+			{
+				static thread_local SParseState * current = nullptr;
+				return current;
+			}
+
+			//! The parse options
+			SParseOptions const & m_options;
+			//! The parse start time
+			std::chrono::steady_clock::time_point m_start;
+			//! The position from which the parsed characters are counted against the budget
+			String::iterator m_budgetOrigin;
+			//! The nesting depth in the current external declaration
+			uint32_t m_depth = 0;
+			//! Tells if the nesting depth limit was exceeded in the current external declaration
+			bool m_overflow = false;
+			//! The position where the nesting depth limit was exceeded
+			String::iterator m_overflowPosition;
+			//! Tells if the request was cancelled, or ran out of budget, inside an external declaration
+			bool m_interrupted = false;
+			//! The state registered before this one
+			SParseState * m_previous;
+		};
+
+		/** Semantic action entering a nesting level.
+		@remarks
+			The nesting depth limit and the interruption of the request are checked here, so they also apply inside a single declaration.
+			Once one of them is hit, every level entry fails, so the grammar unwinds without trying the other alternatives deeper.
+		*/
+		struct SEnterLevel
+		{
+			template< typename Context >
+			void operator()( boost::iterator_range< String::iterator > const & position, Context &, bool & pass )const
+			{
+				SParseState * state = SParseState::Current();
+
+				if ( state )
+				{
+					if ( !state->m_overflow && state->m_depth >= state->m_options.m_maxDepth )
+					{
+						state->m_overflow = true;
+						state->m_overflowPosition = position.begin();
+					}
+
+					if ( !state->m_interrupted )
+					{
+						state->m_interrupted = IsInterrupted( state->m_options, state->m_start, size_t( position.begin() - state->m_budgetOrigin ) );
+					}
+
+					pass = !state->m_overflow && !state->m_interrupted;
+					state->m_depth += pass ? 1 : 0;
+				}
+			}
+		};
+
+		/** Semantic action leaving a nesting level.
+		*/
+		struct SLeaveLevel
+		{
+			template< typename Context >
+			void operator()( qi::unused_type, Context &, bool & )const
+			{
+				SParseState * state = SParseState::Current();
+
+				if ( state )
+				{
+					--state->m_depth;
+				}
+			}
+		};
+
+		/** Computes the status of a parse result.
+		*/
+		EParseStatus GetStatus( SParseResult const & result, bool cancelled )
+		{
+			EParseStatus status = EParseStatus_SUCCESS;
+
+			if ( cancelled )
+			{
+				status = EParseStatus_CANCELLED;
+			}
+			else if ( !result.m_diagnostics.empty() )
+			{
+				status = EParseStatus_ERROR;
+			}
+
+			return status;
+		}
+
+		/** Moves the given node, and its children, by the given offset.
+		*/
+		void ShiftNode( SParseNode & node, ptrdiff_t delta )
+		{
+			node.m_begin = size_t( ptrdiff_t( node.m_begin ) + delta );
+			node.m_end = size_t( ptrdiff_t( node.m_end ) + delta );
+
+			for ( auto & child : node.m_children )
+			{
+				ShiftNode( child, delta );
+			}
+		}
+	}
+
 	CShaderGrammar::CShaderGrammar()
 		: Grammar( translation_unit )
 	{
-		Rule non_digit = qi::ascii::alpha
+		non_digit = qi::ascii::alpha
 			| qi::char_( '_' );
 
-		Rule digit = qi::standard::digit;
+		digit = qi::ascii::digit;
 
-		Rule nonzero_digit = digit - qi::char_( '0' );
+		nonzero_digit = qi::char_( '1', '9' );
 
-		Rule octal_digit = qi::int_parser< int, 8 >();
+		octal_digit = qi::char_( '0', '7' );
 
-		Rule hexadecimal_digit = qi::standard::xdigit;
+		hexadecimal_digit = qi::ascii::xdigit;
 
-		Rule sign = qi::char_( '-' )
+		sign = qi::char_( '-' )
 			| qi::char_( '+' );
 
-		Rule integer_suffix = qi::char_( 'u' )
+		integer_suffix = qi::char_( 'u' )
 			| qi::char_( 'U' );
 
-		Rule decimal_constant = nonzero_digit
-			| ( decimal_constant >> digit );
+		decimal_constant = nonzero_digit >> *digit;
 
-		Rule octal_constant = -sign >> qi::char_( '0' )
-			| ( octal_constant >> octal_digit );
+		octal_constant = qi::char_( '0' ) >> *octal_digit;
 
-		Rule hexadecimal_constant = qi::string( "0x" ) >> hexadecimal_digit
-			| qi::string( "0X" ) >> hexadecimal_digit
-			| hexadecimal_constant >> hexadecimal_digit;
+		hexadecimal_constant = ( qi::string( "0x" ) | qi::string( "0X" ) ) >> +hexadecimal_digit;
 
-		identifier = non_digit
-			| ( identifier >> non_digit )
-			| ( identifier >> digit );
+		identifier = ( non_digit >> *( non_digit | digit ) ) - reserved_word;
 
-		integer_constant = -sign >> decimal_constant >> -integer_suffix
-			| octal_constant >> -integer_suffix
-			| hexadecimal_constant >> -integer_suffix;
+		integer_constant = ( hexadecimal_constant | decimal_constant | octal_constant ) >> !( non_digit | digit | qi::char_( '.' ) );
 
-		uinteger_constant = decimal_constant >> -integer_suffix
-			| octal_constant >> -integer_suffix
-			| hexadecimal_constant >> -integer_suffix;
+		uinteger_constant = ( hexadecimal_constant | decimal_constant | octal_constant ) >> integer_suffix >> !( non_digit | digit );
 
-		digit_sequence = digit >> *digit;
+		digit_sequence = +digit;
 
 		floating_suffix = qi::char_( 'f' )
-			| qi::char_( 'F' )
-			| qi::string( "lf" )
-			| qi::string( "LF" )
-			| qi::string( "d" )
-			| qi::string( "D" );
+			| qi::char_( 'F' );
 
-		exponent_part = qi::char_( 'e' ) >> -sign >> digit_sequence
-			| qi::char_( 'E' ) >> -sign >> digit_sequence;
+		exponent_part = ( qi::char_( 'e' ) | qi::char_( 'E' ) ) >> -sign >> digit_sequence;
 
-		fractional_constant = digit_sequence >> qi::char_( '.' ) >> digit_sequence
-			| digit_sequence >> qi::char_( '.' )
+		fractional_constant = digit_sequence >> qi::char_( '.' ) >> -digit_sequence
 			| qi::char_( '.' ) >> digit_sequence;
 
-		floating_constant = fractional_constant >> -exponent_part >> -floating_suffix
-			| digit_sequence >> exponent_part >> -floating_suffix;
+		floating_constant = ( fractional_constant >> -exponent_part | digit_sequence >> exponent_part ) >> -floating_suffix >> !( non_digit | digit );
+
+		double_constant = ( fractional_constant >> -exponent_part | digit_sequence >> exponent_part ) >> ( qi::string( "lf" ) | qi::string( "LF" ) ) >> !( non_digit | digit );
 
-		double_constant = fractional_constant >> -exponent_part >> -floating_suffix
-			| digit_sequence >> exponent_part >> -floating_suffix;
+		bool_constant = ( qi::string( "true" ) | qi::string( "false" ) ) >> !( non_digit | digit );
 
-		bool_constant = qi::string( "true" )
-			| qi::string( "false" );
+		//!@remarks The raw directive gives the current position to the action.
+		enter_level = qi::raw[qi::eps][SEnterLevel()];
+
+		leave_level = qi::eps[SLeaveLevel()];
+	}
+
+	CShaderGrammar::~CShaderGrammar()
+	{
+	}
+
+	SParseResult CShaderGrammar::Parse( String const & source, SParseOptions const & options )const
+	{
+		SParseResult result;
+		result.m_source = source;
+		String text( source );
+		BlankIgnoredText( text );
+		String::iterator origin = text.begin();
+		String::iterator last = text.end();
+		String::iterator it = SkipSpaces( origin, last );
+		auto start = std::chrono::steady_clock::now();
+		SParseState state( options, start, origin );
+		bool cancelled = false;
+
+		while ( it != last && !cancelled )
+		{
+			cancelled = IsInterrupted( options, start, size_t( it - origin ) );
+
+			if ( !cancelled )
+			{
+				it = SkipSpaces( DoParseDeclaration( it, last, origin, options, result ), last );
+				cancelled = state.m_interrupted;
+			}
+		}
+
+		result.m_status = GetStatus( result, cancelled );
+		return result;
+	}
+
+	CResult< SParseResult > CShaderGrammar::TryParse( String const & source, SParseOptions const & options )const
+	{
+		typedef CResult< SParseResult > Result;
+		SParseResult result = Parse( source, options );
+
+		switch ( result.m_status )
+		{
+		case EParseStatus_ERROR:
+			return Result::Failure( EShaderParserExceptionCodes_ParseError, std::move( result ), String(), []( SParseResult const & partial, String const & )
+			{
+				SParseDiagnostic const & diagnostic = partial.m_diagnostics.front();
+				return PARSER_FORMAT( ERROR_PARSE_FAILED, diagnostic.m_message, diagnostic.m_line, diagnostic.m_column, partial.m_diagnostics.size() );
+			} );
+
+		case EParseStatus_CANCELLED:
+			return Result::Failure( EShaderParserExceptionCodes_Cancelled, std::move( result ), String(), []( SParseResult const & partial, String const & )
+			{
+				return PARSER_FORMAT( ERROR_PARSE_CANCELLED, partial.m_declarations.size() );
+			} );
+
+		default:
+			return Result::Success( std::move( result ) );
+		}
 	}
 
-CShaderGrammar::~CShaderGrammar()
+	SParseResult CShaderGrammar::Reparse( SParseResult const & previous, SParseEdit const & edit, SParseOptions const & options )const
 	{
+		size_t offset = std::min( edit.m_offset, previous.m_source.size() );
+		size_t removed = std::min( edit.m_removed, previous.m_source.size() - offset );
+		size_t oldEditEnd = offset + removed;
+		ptrdiff_t delta = ptrdiff_t( edit.m_inserted.size() ) - ptrdiff_t( removed );
+		ptrdiff_t lineDelta = std::count( edit.m_inserted.begin(), edit.m_inserted.end(), STR( '\n' ) )
+			- std::count( previous.m_source.begin() + offset, previous.m_source.begin() + oldEditEnd, STR( '\n' ) );
+
+		SParseResult result;
+		result.m_source = previous.m_source;
+		result.m_source.replace( offset, removed, edit.m_inserted );
+		String oldText( previous.m_source );
+		BlankIgnoredText( oldText );
+		String text( result.m_source );
+		BlankIgnoredText( text );
+
+		//!@remarks The declarations ending before the edit are kept as is, with their diagnostics.
+		auto declaration = previous.m_declarations.begin();
+
+		while ( declaration != previous.m_declarations.end() && declaration->m_end < offset )
+		{
+			result.m_declarations.push_back( *declaration++ );
+		}
+
+		result.m_reused = result.m_declarations.size();
+		size_t start = result.m_declarations.empty() ? 0 : result.m_declarations.back().m_end;
+		auto diagnostic = previous.m_diagnostics.begin();
+
+		while ( diagnostic != previous.m_diagnostics.end() && diagnostic->m_offset < start )
+		{
+			result.m_diagnostics.push_back( *diagnostic++ );
+		}
+
+		//!@remarks The declarations after the edit can be reused if the text from their beginning up to the end is unchanged.
+		size_t common = 0;
+		size_t maxCommon = std::min( oldText.size() - oldEditEnd, text.size() - offset - edit.m_inserted.size() );
+
+		while ( common < maxCommon && oldText[oldText.size() - common - 1] == text[text.size() - common - 1] )
+		{
+			++common;
+		}
+
+		String::iterator origin = text.begin();
+		String::iterator last = text.end();
+		String::iterator it = SkipSpaces( origin + start, last );
+		auto reusable = declaration;
+		auto startTime = std::chrono::steady_clock::now();
+		SParseState state( options, startTime, origin + start );
+		bool cancelled = false;
+
+		while ( it != last && !cancelled )
+		{
+			ptrdiff_t position = it - origin;
+
+			while ( reusable != previous.m_declarations.end()
+					&& ( reusable->m_begin < oldEditEnd
+						 || oldText.size() - reusable->m_begin > common
+						 || ptrdiff_t( reusable->m_begin ) + delta < position ) )
+			{
+				++reusable;
+			}
+
+			if ( reusable != previous.m_declarations.end() && ptrdiff_t( reusable->m_begin ) + delta == position )
+			{
+				break;
+			}
+
+			cancelled = IsInterrupted( options, startTime, size_t( position ) - start );
+
+			if ( !cancelled )
+			{
+				it = SkipSpaces( DoParseDeclaration( it, last, origin, options, result ), last );
+				cancelled = state.m_interrupted;
+			}
+		}
+
+		if ( it != last && !cancelled )
+		{
+			//!@remarks Synchronised with an unaffected declaration, the remaining ones are shifted.
+			for ( auto node = reusable; node != previous.m_declarations.end(); ++node )
+			{
+				result.m_declarations.push_back( *node );
+				ShiftNode( result.m_declarations.back(), delta );
+				++result.m_reused;
+			}
+
+			diagnostic = std::lower_bound( previous.m_diagnostics.begin(), previous.m_diagnostics.end(), reusable->m_begin, []( SParseDiagnostic const & lhs, size_t rhs )
+			{
+				return lhs.m_offset < rhs;
+			} );
+
+			for ( ; diagnostic != previous.m_diagnostics.end(); ++diagnostic )
+			{
+				SParseDiagnostic shifted = *diagnostic;
+				shifted.m_offset = size_t( ptrdiff_t( shifted.m_offset ) + delta );
+				shifted.m_line = uint32_t( ptrdiff_t( shifted.m_line ) + lineDelta );
+				shifted.m_column = GetColumn( origin, origin + shifted.m_offset );
+				result.m_diagnostics.push_back( shifted );
+			}
+		}
+
+		result.m_status = GetStatus( result, cancelled );
+		return result;
+	}
+
+	void CShaderGrammar::DoNest( Rule & rule, Rule const & content )
+	{
+		rule = enter_level >> ( content >> leave_level | leave_level >> !qi::eps );
+	}
+
+	String::iterator CShaderGrammar::DoParseDeclaration( String::iterator first, String::iterator last, String::iterator origin, SParseOptions const & options, SParseResult & result )const
+	{
+		String::iterator blockBegin;
+		String::iterator end = FindSynchronisationPoint( first, last, blockBegin );
+		String::iterator overflow = FindNestingOverflow( first, end, options.m_maxDepth );
+
+		if ( overflow != end )
+		{
+			AddDiagnostic( origin, overflow, ERROR_NESTING_DEPTH, result );
+			result.m_declarations.push_back( MakeNode( origin, first, end, false ) );
+			return end;
+		}
+
+		SParseState & state = *SParseState::Current();
+		state.m_depth = 0;
+		state.m_overflow = false;
+		size_t errors = result.m_diagnostics.size();
+		String::iterator next = first;
+		bool parsed = qi::phrase_parse( next, last, external_declaration, qi::ascii::space, qi::skip_flag::dont_postskip ) && next != first;
+
+		if ( state.m_overflow && !state.m_interrupted )
+		{
+			//!@remarks The nesting of a chain or of statements exceeded the limit, the grammar stopped before overflowing the stack.
+			AddDiagnostic( origin, state.m_overflowPosition, ERROR_NESTING_DEPTH, result );
+			result.m_declarations.push_back( MakeNode( origin, first, end, false ) );
+			return end;
+		}
+
+		SParseNode node;
+
+		if ( parsed )
+		{
+			node = MakeNode( origin, first, next, true );
+		}
+		else if ( !state.m_interrupted )
+		{
+			next = DoRecoverDeclaration( first, last, origin, node, result );
+		}
+
+		if ( state.m_interrupted )
+		{
+			//!@remarks The request stopped inside the declaration, which is left out of the partial result.
+			result.m_diagnostics.resize( errors );
+			return first;
+		}
+
+		result.m_declarations.push_back( std::move( node ) );
+		return next;
+	}
+
+	String::iterator CShaderGrammar::DoRecoverDeclaration( String::iterator first, String::iterator last, String::iterator origin, SParseNode & node, SParseResult & result )const
+	{
+		String::iterator blockBegin;
+		String::iterator end = FindSynchronisationPoint( first, last, blockBegin );
+		node = MakeNode( origin, first, end, false );
+		size_t errors = result.m_diagnostics.size();
+
+		if ( blockBegin != last && FollowsRightParen( first, blockBegin ) )
+		{
+			//!@remarks Function definition, check the prototype, then recover the body statements.
+			String::iterator it = first;
+
+			if ( !qi::phrase_parse( it, blockBegin, function_prototype, qi::ascii::space ) || it != blockBegin )
+			{
+				AddDiagnostic( origin, first, ERROR_SYNTAX_FUNCTION_PROTOTYPE, result );
+			}
+
+			DoRecoverBlock( blockBegin + 1, FindMatchingBrace( blockBegin, end ), origin, node.m_children, result );
+		}
+
+		if ( errors == result.m_diagnostics.size() )
+		{
+			AddDiagnostic( origin, first, ERROR_SYNTAX_DECLARATION, result );
+		}
+
+		return end;
+	}
+
+	void CShaderGrammar::DoRecoverBlock( String::iterator first, String::iterator last, String::iterator origin, std::vector< SParseNode > & nodes, SParseResult & result )const
+	{
+		String::iterator it = SkipSpaces( first, last );
+
+		while ( it != last )
+		{
+			String::iterator next = it;
+
+			if ( qi::phrase_parse( next, last, statement, qi::ascii::space, qi::skip_flag::dont_postskip ) && next != it )
+			{
+				nodes.push_back( MakeNode( origin, it, next, true ) );
+			}
+			else
+			{
+				String::iterator blockBegin;
+				next = FindSynchronisationPoint( it, last, blockBegin );
+				SParseNode node = MakeNode( origin, it, next, false );
+				size_t errors = result.m_diagnostics.size();
+
+				if ( blockBegin != last )
+				{
+					//!@remarks Compound or control statement, try to locate the errors inside its block.
+					DoRecoverBlock( blockBegin + 1, FindMatchingBrace( blockBegin, next ), origin, node.m_children, result );
+				}
+
+				if ( errors == result.m_diagnostics.size() )
+				{
+					AddDiagnostic( origin, it, ERROR_SYNTAX_STATEMENT, result );
+				}
+
+				nodes.push_back( std::move( node ) );
+			}
+
+			it = SkipSpaces( next, last );
+		}
 	}
 }
 END_NAMESPACE_SHADER_PARSER
@@ -13,6 +13,8 @@
 #define ___SHADER_PARSER_H___
 
 #include "EToken.h"
+#include "ShaderParserParseResult.h"
+#include "ShaderParserResult.h"
 
 BEGIN_NAMESPACE_SHADER_PARSER
 {
@@ -30,18 +32,147 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		*/
 		ShaderParserExport virtual ~CShaderGrammar();
 
+		/** Parses the given source, recovering from syntax errors.
+		@remarks
+			When an external declaration or a statement fails to parse, a diagnostic is
+			recorded and the parser skips to the next SEMICOLON or RIGHT_BRACE synchronisation
+			point, so all the syntax errors of the source are reported in a single pass.
+			The cancellation token and the budgets given in the options are checked before
+			each external declaration, and at each statement or expression nesting level inside it.
+			A stopped request gives a partial result, without the interrupted declaration, with
+			the EParseStatus_CANCELLED status.
+		@param[in] source
+			The shader source.
+		@param[in] options
+			The parse options.
+		@return
+			The parse result, holding the (partial) tree and the diagnostics.
+		*/
+		ShaderParserExport SParseResult Parse( String const & source, SParseOptions const & options = SParseOptions() )const;
+
+		/** Parses the given source, reporting the invalid sources as errors.
+		@remarks
+			Behaves like Parse, but only a source parsed without error gives a value.
+			The partial parse result of a failure, with all its diagnostics, is given by GetPartialValue.
+			The error message, describing the first syntax error, is only built if requested.
+		@param[in] source
+			The shader source.
+		@param[in] options
+			The parse options.
+		@return
+			The parse result, or EShaderParserExceptionCodes_ParseError if syntax errors were found,
+			EShaderParserExceptionCodes_Cancelled if the request was cancelled or ran out of budget.
+		*/
+		ShaderParserExport CResult< SParseResult > TryParse( String const & source, SParseOptions const & options = SParseOptions() )const;
+
+		/** Parses the source resulting from an edit of a previously parsed source.
+		@remarks
+			Only the external declarations touched by the edit are parsed again, the
+			other ones are reused from the previous result, shifted by the edit size.
+			Parsing stops as soon as it reaches the beginning of an unaffected declaration.
+		@param[in] previous
+			The previous parse result.
+		@param[in] edit
+			The edit applied to the previous source.
+		@param[in] options
+			The parse options.
+		@return
+			The parse result for the edited source, equivalent to the one given by Parse.
+		*/
+		ShaderParserExport SParseResult Reparse( SParseResult const & previous, SParseEdit const & edit, SParseOptions const & options = SParseOptions() )const;
+
+	private:
+		/** Parses an external declaration, recovering from syntax errors.
+		@remarks
+			The declaration nesting depth is checked before running the grammar.
+		@param[in] first, last
+			The range to parse.
+		@param[in] origin
+			The beginning of the parsed text.
+		@param[in] options
+			The parse options.
+		@param[out] result
+			Receives the declaration node and the diagnostics.
+		@return
+			The position following the declaration.
+		*/
+		String::iterator DoParseDeclaration( String::iterator first, String::iterator last, String::iterator origin, SParseOptions const & options, SParseResult & result )const;
+
+		/** Recovers from an invalid external declaration.
+		@param[in] first, last
+			The range to parse.
+		@param[in] origin
+			The beginning of the parsed text.
+		@param[out] node
+			Receives the recovered statements.
+		@param[out] result
+			Receives the diagnostics.
+		@return
+			The position of the next synchronisation point.
+		*/
+		String::iterator DoRecoverDeclaration( String::iterator first, String::iterator last, String::iterator origin, SParseNode & node, SParseResult & result )const;
+
+		/** Parses the statements of a block, recovering from invalid statements.
+		@param[in] first, last
+			The block content, without the braces.
+		@param[in] origin
+			The beginning of the parsed text.
+		@param[out] nodes
+			Receives the statements nodes.
+		@param[out] result
+			Receives the diagnostics.
+		*/
+		void DoRecoverBlock( String::iterator first, String::iterator last, String::iterator origin, std::vector< SParseNode > & nodes, SParseResult & result )const;
+
+	protected:
+		/** Makes the given rule parse its content one nesting level deeper.
+		@remarks
+			To be used by the derived grammars on the recursive rules which are not delimited by brackets
+			(right recursive chains, nested statements), so their nesting depth is bounded by SParseOptions::m_maxDepth.
+		@param[out] rule
+			The nested rule.
+		@param[in] content
+			The rule content.
+		*/
+		ShaderParserExport void DoNest( Rule & rule, Rule const & content );
+
+	private:
+		//! Enters a nesting level, fails if the nesting depth limit is exceeded
+		Rule enter_level;
+		//! Leaves the nesting level entered by enter_level
+		Rule leave_level;
+
 	protected:
-		Rule identifier;
-		Rule digit_sequence;
-		Rule integer_constant;
-		Rule uinteger_constant;
-		Rule floating_suffix;
-		Rule exponent_part;
-		Rule fractional_constant;
-		Rule floating_constant;
-		Rule double_constant;
-		Rule bool_constant;
+		LexemeRule non_digit;
+		LexemeRule digit;
+		LexemeRule nonzero_digit;
+		LexemeRule octal_digit;
+		LexemeRule hexadecimal_digit;
+		LexemeRule sign;
+		LexemeRule integer_suffix;
+		LexemeRule decimal_constant;
+		LexemeRule octal_constant;
+		LexemeRule hexadecimal_constant;
+		LexemeRule identifier;
+		LexemeRule digit_sequence;
+		LexemeRule integer_constant;
+		LexemeRule uinteger_constant;
+		LexemeRule floating_suffix;
+		LexemeRule exponent_part;
+		LexemeRule fractional_constant;
+		LexemeRule floating_constant;
+		LexemeRule double_constant;
+		LexemeRule bool_constant;
+		//! The language keywords, which can't be used as identifiers, defined by the derived grammars
+		LexemeRule reserved_word;
+		//! The top level rule, defined by the derived grammars
 		Rule translation_unit;
+		//! The translation unit element, defined by the derived grammars, used as recovery unit
+		Rule external_declaration;
+		//! The function prototype, defined by the derived grammars, used to recover function definitions
+		Rule function_prototype;
+		//! The statement, defined by the derived grammars, used as recovery unit inside functions
+		Rule statement;
 	};
 
 } END_NAMESPACE_SHADER_PARSER
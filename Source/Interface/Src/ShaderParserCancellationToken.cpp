@@ -0,0 +1,37 @@
+/************************************************************************//**
+* @file ShaderParserCancellationToken.cpp
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief CCancellationToken class definition.
+*
+***************************************************************************/
+
+#include "ShaderParserPch.h"
+
+#include "ShaderParserCancellationToken.h"
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	CCancellationToken::CCancellationToken()
+		: m_cancelled( false )
+	{
+	}
+
+	CCancellationToken::~CCancellationToken()
+	{
+	}
+
+	void CCancellationToken::Cancel()
+	{
+		m_cancelled.store( true, std::memory_order_release );
+	}
+
+	bool CCancellationToken::IsCancelled()const
+	{
+		return m_cancelled.load( std::memory_order_acquire );
+	}
+}
+END_NAMESPACE_SHADER_PARSER
@@ -0,0 +1,55 @@
+/************************************************************************//**
+* @file ShaderParserCancellationToken.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief CCancellationToken class declaration.
+*
+* @details Allows a thread to request the cancellation of a parse request
+*	running on another thread.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_CANCELLATION_TOKEN_H___
+#define ___SHADER_PARSER_CANCELLATION_TOKEN_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include <atomic>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** Cancellation flag, shared between a parse request and its requester.
+	@remarks
+		The parser checks it between two external declarations, so a cancelled
+		request stops after the declaration being parsed.
+	*/
+	class CCancellationToken
+	{
+	public:
+		/** Default constructor.
+		*/
+		ShaderParserExport CCancellationToken();
+
+		/** Destructor.
+		*/
+		ShaderParserExport ~CCancellationToken();
+
+		/** Requests the cancellation.
+		*/
+		ShaderParserExport void Cancel();
+
+		/** Tells if the cancellation has been requested.
+		*/
+		ShaderParserExport bool IsCancelled()const;
+
+	private:
+		//! The cancellation flag
+		std::atomic_bool m_cancelled;
+	};
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif // ___SHADER_PARSER_CANCELLATION_TOKEN_H___
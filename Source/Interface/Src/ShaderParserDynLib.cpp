@@ -18,6 +18,7 @@
 #include "ShaderParserStringUtils.h"
 #include "ShaderParserException.h"
 #include "ShaderParserFileUtils.h"
+#include "ShaderParserFormat.h"
 
 #include <sys/stat.h>
 
@@ -42,10 +43,9 @@ BEGIN_NAMESPACE_SHADER_PARSER
 	const String   CDynLib::LIB_EXTENSION( STR( ".so" ) );
 #	endif
 
-	const String ERROR_DB_TEXT_DYNAMIC_LIB_SYSTEM = STR( "System Error: " );
-	const String ERROR_DB_LIB_FILE_NOT_FOUND = STR( "File %s not found!" );
-	const String ERROR_DB_LOAD_DYNAMIC_LIB = STR( "Could not load dynamic library %s." );
-	const String ERROR_DB_UNLOAD_DYNAMIC_LIB = STR( "Could not unload dynamic library %s." );
+	constexpr char ERROR_DB_LIB_FILE_NOT_FOUND[] = "File {} not found!";
+	constexpr char ERROR_DB_LOAD_DYNAMIC_LIB[] = "Could not load dynamic library {}. System Error: {}";
+	constexpr char ERROR_DB_UNLOAD_DYNAMIC_LIB[] = "Could not unload dynamic library {}. System Error: {}";
 
 	namespace
 	{
@@ -85,7 +85,7 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		//!@remarks Check if file exists.
 		if ( FindFile( m_name, LIB_EXTENSION, l_name ) == false )
 		{
-			PARSER_EXCEPT( EShaderParserExceptionCodes_ItemNotFound, ( Format( ERROR_DB_LIB_FILE_NOT_FOUND ) % l_name ).str() );
+			PARSER_EXCEPT( EShaderParserExceptionCodes_ItemNotFound, PARSER_FORMAT( ERROR_DB_LIB_FILE_NOT_FOUND, l_name ) );
 		}
 
 		//!@remarks Update name with the complete library path.
@@ -96,9 +96,7 @@ BEGIN_NAMESPACE_SHADER_PARSER
 
 		if ( !m_handle )
 		{
-			StringStream l_stream;
-			l_stream << ( Format( ERROR_DB_LOAD_DYNAMIC_LIB ) % m_name ).str() << ERROR_DB_TEXT_DYNAMIC_LIB_SYSTEM << DynlibError();
-			PARSER_EXCEPT( EShaderParserExceptionCodes_InternalError, l_stream.str() );
+			PARSER_EXCEPT( EShaderParserExceptionCodes_InternalError, PARSER_FORMAT( ERROR_DB_LOAD_DYNAMIC_LIB, m_name, DynlibError() ) );
 		}
 	}
 
@@ -108,9 +106,7 @@ BEGIN_NAMESPACE_SHADER_PARSER
 
 		if ( DYNLIB_UNLOAD( m_handle ) )
 		{
-			StringStream l_stream;
-			l_stream << ( Format( ERROR_DB_UNLOAD_DYNAMIC_LIB ) % m_name ).str() << ERROR_DB_TEXT_DYNAMIC_LIB_SYSTEM << DynlibError();
-			PARSER_EXCEPT( EShaderParserExceptionCodes_InternalError, l_stream.str() );
+			PARSER_EXCEPT( EShaderParserExceptionCodes_InternalError, PARSER_FORMAT( ERROR_DB_UNLOAD_DYNAMIC_LIB, m_name, DynlibError() ) );
 		}
 	}
 
@@ -32,6 +32,8 @@
 #	include <signal.h>
 #endif
 
+#include <unordered_map>
+
 #if defined( __GNUG__ )
 #include <cxxabi.h>
 #else
@@ -41,14 +43,8 @@ BEGIN_NAMESPACE_SHADER_PARSER
 {
 	namespace
 	{
-#if defined( NDEBUG )
-
-		static void ShowBacktrace( std::stringstream & p_stream )
-		{
-		}
-
-#else
-	const int CALLS_TO_CAPTURE( 20 );
+#if !defined( NDEBUG )
+	//! The frames of DoCaptureFrames and of the constructor
 	const int CALLS_TO_SKIP( 2 );
 
 #	if defined( __GNUG__ )
@@ -71,6 +67,7 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		if ( !l_status )
 		{
 			l_return = p_mangled.substr( 0, l_lindex + 1 ) + l_demangled + p_mangled.substr( l_rindex );
+			free( l_demangled );
 		}
 		else
 		{
@@ -107,66 +104,145 @@ BEGIN_NAMESPACE_SHADER_PARSER
 	}
 
 #	endif
-#	if !defined( _WIN32 )
 
-		void ShowBacktrace( std::stringstream & p_stream )
+		/** The symbol names of the captured frames, shared by all the exceptions of the process.
+		*/
+		class CSymbolCache
 		{
-			p_stream << "CALL STACK:" << std::endl;
-			void * backTrace[CALLS_TO_CAPTURE];
-			unsigned int num( ::backtrace( backTrace, CALLS_TO_CAPTURE ) );
-			char ** fnStrings( ::backtrace_symbols( backTrace, num ) );
-
-			for ( unsigned i = CALLS_TO_SKIP; i < num; ++i )
+		public:
+			CSymbolCache()
+#	if defined( _WIN32 )
+				: m_initialised( false )
+#	endif
 			{
-				p_stream << "== " << Demangle( fnStrings[i] ) << std::endl;
 			}
 
-			free( fnStrings );
-		}
+			/** Writes the call stack of captured frames
+			@param[in] frames, count
+				The frames addresses
+			@param[out] output
+				Receives the call stack
+			*/
+			void Symbolize( void * const * frames, int count, std::string & output )
+			{
+				std::unique_lock< std::mutex > l_lock( m_mutex );
+				std::vector< void * > l_missing;
 
-#	else
+				for ( int i = 0; i < count; ++i )
+				{
+					if ( m_names.find( frames[i] ) == m_names.end() && std::find( l_missing.begin(), l_missing.end(), frames[i] ) == l_missing.end() )
+					{
+						l_missing.push_back( frames[i] );
+					}
+				}
 
-		void ShowBacktrace( std::stringstream & p_stream )
-		{
-			static bool SymbolsInitialised = false;
-			const int MaxFnNameLen( 255 );
+				if ( !l_missing.empty() && !DoResolve( l_missing ) )
+				{
+					output = "CALL STACK:\n== Unable to retrieve the call stack\n";
+					return;
+				}
+
+				output = "CALL STACK:\n";
+
+				for ( int i = 0; i < count; ++i )
+				{
+					std::string const & l_name = m_names[frames[i]];
 
-			void * backTrace[CALLS_TO_CAPTURE - CALLS_TO_SKIP];
-			unsigned int num( ::CaptureStackBackTrace( CALLS_TO_SKIP, CALLS_TO_CAPTURE - CALLS_TO_SKIP, backTrace, NULL ) );
+					if ( !l_name.empty() )
+					{
+						output += "== ";
+						output += l_name;
+						output += "\n";
+					}
+				}
+			}
 
-			::HANDLE process( ::GetCurrentProcess() );
-			p_stream << "CALL STACK:" << std::endl;
+			/** Retrieves the number of resolved frames addresses
+			*/
+			size_t GetSize()
+			{
+				std::unique_lock< std::mutex > l_lock( m_mutex );
+				return m_names.size();
+			}
 
-			// symbol->Name type is char [1] so there is space for \0 already
-			SYMBOL_INFO * symbol( ( SYMBOL_INFO * ) malloc( sizeof( SYMBOL_INFO ) + ( MaxFnNameLen * sizeof( char ) ) ) );
-			symbol->MaxNameLen = MaxFnNameLen;
-			symbol->SizeOfStruct = sizeof( SYMBOL_INFO );
+		private:
+#	if !defined( _WIN32 )
 
-			if ( !SymbolsInitialised )
+			/** Retrieves the names of frames, and adds them to the cache
+			*/
+			bool DoResolve( std::vector< void * > const & frames )
 			{
-				SymbolsInitialised = SymInitialize( process, NULL, TRUE ) == TRUE;
+				char ** l_strings( ::backtrace_symbols( frames.data(), int( frames.size() ) ) );
+
+				if ( !l_strings )
+				{
+					return false;
+				}
+
+				for ( size_t i = 0; i < frames.size(); ++i )
+				{
+					m_names[frames[i]] = Demangle( l_strings[i] );
+				}
+
+				free( l_strings );
+				return true;
 			}
 
-			if ( SymbolsInitialised )
+#	else
+
+			/** Retrieves the names of frames, and adds them to the cache
+			*/
+			bool DoResolve( std::vector< void * > const & frames )
 			{
-				// For now we just print out a message on sterr.
-				for ( unsigned int i = 0; i < num; ++i )
+				const int MaxFnNameLen( 255 );
+				::HANDLE process( ::GetCurrentProcess() );
+
+				if ( !m_initialised )
+				{
+					m_initialised = SymInitialize( process, NULL, TRUE ) == TRUE;
+				}
+
+				if ( !m_initialised )
+				{
+					return false;
+				}
+
+				// symbol->Name type is char [1] so there is space for \0 already
+				SYMBOL_INFO * symbol( ( SYMBOL_INFO * ) malloc( sizeof( SYMBOL_INFO ) + ( MaxFnNameLen * sizeof( char ) ) ) );
+				symbol->MaxNameLen = MaxFnNameLen;
+				symbol->SizeOfStruct = sizeof( SYMBOL_INFO );
+
+				for ( auto l_frame : frames )
 				{
-					if ( SymFromAddr( process, reinterpret_cast< DWORD64 >( backTrace[i] ), 0, symbol ) )
+					std::string & l_name = m_names[l_frame];
+
+					if ( SymFromAddr( process, reinterpret_cast< DWORD64 >( l_frame ), 0, symbol ) )
 					{
-						p_stream << "== " << std::string( symbol->Name, symbol->Name + symbol->NameLen ) << std::endl;
+						l_name.assign( symbol->Name, symbol->Name + symbol->NameLen );
 					}
 				}
 
 				free( symbol );
+				return true;
 			}
-			else
-			{
-				p_stream << "== Unable to retrieve the call stack" << std::endl;
-			}
-		}
+
+			//! Tells if the symbols handler is initialised
+			bool m_initialised;
 
 #	endif
+
+			//! Protects the names, the symbols API are not thread safe
+			std::mutex m_mutex;
+			//! The symbol names, by frame address, empty if the address could not be resolved
+			std::unordered_map< void *, std::string > m_names;
+		};
+
+		CSymbolCache & GetSymbolCache()
+		{
+			static CSymbolCache l_cache;
+			return l_cache;
+		}
+
 #endif
 
 	}
@@ -431,10 +507,10 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		, m_typeName( STR( "CShaderParserException" ) )
 		, m_file( file )
 		, m_line( line )
+		, m_frames()
+		, m_frameCount( 0 )
 	{
-		std::stringstream l_stream;
-		ShowBacktrace( l_stream );
-		m_callstack = l_stream.str();
+		DoCaptureFrames();
 	}
 
 	CShaderParserException::CShaderParserException( const String & type, int number, const String & description, const std::string & source, const std::string & file, long line )
@@ -444,10 +520,10 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		, m_typeName( type )
 		, m_file( file )
 		, m_line( line )
+		, m_frames()
+		, m_frameCount( 0 )
 	{
-		std::stringstream l_stream;
-		ShowBacktrace( l_stream );
-		m_callstack = l_stream.str();
+		DoCaptureFrames();
 	}
 
 	const String & CShaderParserException::GetNumberName() const throw()
@@ -461,7 +537,10 @@ BEGIN_NAMESPACE_SHADER_PARSER
 			STR( "NullPointer" ),
 			STR( "ItemNotFound" ),
 			STR( "Internal" ),
+			STR( "Format" ),
 			STR( "System" ),
+			STR( "Parse" ),
+			STR( "Cancelled" ),
 		};
 
 		return NumberNames[m_number];
@@ -485,7 +564,7 @@ BEGIN_NAMESPACE_SHADER_PARSER
 			}
 
 			desc << STR( "DESCRIPTION: " ) << m_description << std::endl;
-			desc << m_callstack;
+			desc << GetCallStack();
 			m_fullDesc = desc.str();
 			m_what = m_fullDesc;
 		}
@@ -493,10 +572,58 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		return m_fullDesc;
 	}
 
+	const std::string & CShaderParserException::GetCallStack() const
+	{
+#if !defined( NDEBUG )
+
+		if ( m_callstack.empty() && m_frameCount > 0 )
+		{
+			GetSymbolCache().Symbolize( m_frames, m_frameCount, m_callstack );
+		}
+
+#endif
+		return m_callstack;
+	}
+
+	size_t CShaderParserException::GetSymbolCacheSize()
+	{
+#if !defined( NDEBUG )
+
+		return GetSymbolCache().GetSize();
+
+#else
+
+		return 0;
+
+#endif
+	}
+
 	const char * CShaderParserException::what()const throw()
 	{
 		GetFullDescription();
 		return m_what.c_str();
 	}
+
+	void CShaderParserException::DoCaptureFrames()
+	{
+#if !defined( NDEBUG )
+#	if !defined( _WIN32 )
+
+		void * l_frames[MAX_FRAMES + CALLS_TO_SKIP];
+		int l_count = ::backtrace( l_frames, MAX_FRAMES + CALLS_TO_SKIP ) - CALLS_TO_SKIP;
+
+		if ( l_count > 0 )
+		{
+			std::memcpy( m_frames, l_frames + CALLS_TO_SKIP, l_count * sizeof( void * ) );
+			m_frameCount = l_count;
+		}
+
+#	else
+
+		m_frameCount = ::CaptureStackBackTrace( CALLS_TO_SKIP, MAX_FRAMES, m_frames, NULL );
+
+#	endif
+#endif
+	}
 }
 END_NAMESPACE_SHADER_PARSER
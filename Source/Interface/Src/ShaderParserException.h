@@ -31,6 +31,8 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		EShaderParserExceptionCodes_InternalError,
 		EShaderParserExceptionCodes_FormatError,
 		EShaderParserExceptionCodes_SystemError,
+		EShaderParserExceptionCodes_ParseError,
+		EShaderParserExceptionCodes_Cancelled,
 
 		EShaderParserExceptionCodes_LastCode //!< Represent the maximum number of exception code. Must be always the last.
 	};
@@ -131,10 +133,32 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		*/
 		ShaderParserExport virtual const String & GetFullDescription() const;
 
+		/** Return the call stack of the exception creation.
+			@remarks
+				Only the frames addresses are captured when the exception is created, in debug builds.
+				They are translated to symbol names on the first call, the names being cached for the whole process.
+			@return
+				The call stack, empty in release builds.
+		*/
+		ShaderParserExport const std::string & GetCallStack() const;
+
+		/** Retrieves the number of frames addresses translated to symbol names, for the whole process.
+			@return
+				The count, 0 in release builds.
+		*/
+		ShaderParserExport static size_t GetSymbolCacheSize();
+
 		/** Override std::exception::what */
 		ShaderParserExport const char * what() const throw();
 
 	private:
+		/** Captures the current call stack frames addresses.
+		*/
+		void DoCaptureFrames();
+
+	private:
+		//! The maximum number of captured frames
+		static const int MAX_FRAMES = 20;
 		//! The exception number
 		int m_number;
 		//! The exception description
@@ -151,8 +175,12 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		mutable String m_fullDesc;
 		//!< Full std::string error description.
 		mutable std::string m_what;
-		//! The stack trace
-		std::string m_callstack;
+		//! The captured frames addresses
+		void * m_frames[MAX_FRAMES];
+		//! The captured frames count
+		int m_frameCount;
+		//! The stack trace, built from the frames on first access
+		mutable std::string m_callstack;
 	};
 
 #	define PARSER_EXCEPT( number, description ) throw CShaderParserException( number, description, __FUNCTION__, __FILE__, __LINE__ )
@@ -16,11 +16,31 @@
 
 #include "ShaderParserFactory.h"
 #include "ShaderParserFactoryManager.h"
+#include "ShaderParserFormat.h"
 
 BEGIN_NAMESPACE_SHADER_PARSER
 {
-	static const String ERROR_DB_FACTORY_TYPE_NOT_FOUND = STR( "Factory type %1% not found in registered factories" );
-	static const String ERROR_DB_OBJECT_TYPE_NOT_FOUND = STR( "Object type %1% not found in registered objects" );
+	static constexpr char ERROR_DB_FACTORY_TYPE_NOT_FOUND[] = "Factory type {} not found in registered factories";
+	static constexpr char ERROR_DB_OBJECT_TYPE_NOT_FOUND[] = "Object type {} not found in registered objects";
+	static constexpr char ERROR_DB_OBJECT_TYPE_NOT_CREATED[] = "Object type {} could not be created by its factory";
+
+	namespace
+	{
+		String GetFactoryNotFoundMessage( CShaderGrammar * const &, String const & p_factoryType )
+		{
+			return PARSER_FORMAT( ERROR_DB_FACTORY_TYPE_NOT_FOUND, p_factoryType );
+		}
+
+		String GetObjectNotFoundMessage( CShaderGrammar * const &, String const & p_objectType )
+		{
+			return PARSER_FORMAT( ERROR_DB_OBJECT_TYPE_NOT_FOUND, p_objectType );
+		}
+
+		String GetObjectNotCreatedMessage( CShaderGrammar * const &, String const & p_objectType )
+		{
+			return PARSER_FORMAT( ERROR_DB_OBJECT_TYPE_NOT_CREATED, p_objectType );
+		}
+	}
 
 	CFactoryManager::CFactoryManager()
 	{
@@ -84,16 +104,12 @@ BEGIN_NAMESPACE_SHADER_PARSER
 			}
 			else
 			{
-				Format l_fmt( ERROR_DB_FACTORY_TYPE_NOT_FOUND );
-				l_fmt % p_factoryType;
-				PARSER_EXCEPT( EShaderParserExceptionCodes_NullPointer, l_fmt.str() );
+				PARSER_EXCEPT( EShaderParserExceptionCodes_NullPointer, PARSER_FORMAT( ERROR_DB_FACTORY_TYPE_NOT_FOUND, p_factoryType ) );
 			}
 		}
 		else
 		{
-			Format l_fmt( ERROR_DB_FACTORY_TYPE_NOT_FOUND );
-			l_fmt % p_factoryType;
-			PARSER_EXCEPT( EShaderParserExceptionCodes_ItemNotFound, l_fmt.str() );
+			PARSER_EXCEPT( EShaderParserExceptionCodes_ItemNotFound, PARSER_FORMAT( ERROR_DB_FACTORY_TYPE_NOT_FOUND, p_factoryType ) );
 		}
 
 		return l_object;
@@ -111,12 +127,51 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		}
 		else
 		{
-			Format l_fmt( ERROR_DB_OBJECT_TYPE_NOT_FOUND );
-			l_fmt % p_objectType;
-			PARSER_EXCEPT( EShaderParserExceptionCodes_ItemNotFound, l_fmt.str() );
+			PARSER_EXCEPT( EShaderParserExceptionCodes_ItemNotFound, PARSER_FORMAT( ERROR_DB_OBJECT_TYPE_NOT_FOUND, p_objectType ) );
 		}
 
 		return NULL;
 	}
+
+	CResult< CShaderGrammar * > CFactoryManager::TryCreateInstance( const String & p_factoryType, const String & p_objectType )
+	{
+		typedef CResult< CShaderGrammar * > Result;
+
+		//!@remarks Find factory object.
+		auto && l_itFactory = m_factories.find( p_factoryType );
+
+		if ( l_itFactory == m_factories.end() )
+		{
+			return Result::Failure( EShaderParserExceptionCodes_ItemNotFound, NULL, p_factoryType, GetFactoryNotFoundMessage );
+		}
+
+		if ( !l_itFactory->second )
+		{
+			return Result::Failure( EShaderParserExceptionCodes_NullPointer, NULL, p_factoryType, GetFactoryNotFoundMessage );
+		}
+
+		//!@remarks Create a new object instance.
+		CShaderGrammar * l_object = l_itFactory->second->CreateInstance( p_objectType );
+
+		if ( !l_object )
+		{
+			return Result::Failure( EShaderParserExceptionCodes_ItemNotFound, NULL, p_objectType, GetObjectNotCreatedMessage );
+		}
+
+		return Result::Success( l_object );
+	}
+
+	CResult< CShaderGrammar * > CFactoryManager::TryCreateInstance( const String & p_objectType )
+	{
+		//!@remarks Find factory type.
+		auto && l_itObject = m_objectFactories.find( p_objectType );
+
+		if ( l_itObject == m_objectFactories.end() )
+		{
+			return CResult< CShaderGrammar * >::Failure( EShaderParserExceptionCodes_ItemNotFound, NULL, p_objectType, GetObjectNotFoundMessage );
+		}
+
+		return TryCreateInstance( l_itObject->second, p_objectType );
+	}
 }
 END_NAMESPACE_SHADER_PARSER
@@ -17,6 +17,8 @@
 
 #include "ShaderParserPrerequisites.h"
 
+#include "ShaderParserResult.h"
+
 BEGIN_NAMESPACE_SHADER_PARSER
 {
 	/** This manager manages factory objects.
@@ -60,6 +62,29 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		*/
 		ShaderParserExport CShaderGrammar * CreateInstance( const String & objectType );
 
+		/** Create a object instance with its given type, without throwing.
+		@param factoryType
+			Type that identify wich factory is used to create the object.
+		@param objectType
+			Type that identify wich object has to create.
+		@return
+			Pointer on a new object of type \c type, or the error.
+		@remarks
+			Fails with EShaderParserExceptionCodes_ItemNotFound if the factory type doesn't exist or doesn't create the object type,
+			EShaderParserExceptionCodes_NullPointer if the factory is null.
+		*/
+		ShaderParserExport CResult< CShaderGrammar * > TryCreateInstance( const String & factoryType, const String & objectType );
+
+		/** Create a object instance with its given type, without throwing.
+		@param objectType
+			Type that identify wich object has to create.
+		@return
+			Pointer on a new object of type \c type, or the error.
+		@remarks
+			Fails with EShaderParserExceptionCodes_ItemNotFound if the object type isn't registered.
+		*/
+		ShaderParserExport CResult< CShaderGrammar * > TryCreateInstance( const String & objectType );
+
 		/** Retrieves the unique instance
 		*/
 		ShaderParserExport static CFactoryManager & Instance()
@@ -13,18 +13,700 @@
 
 #include "ShaderParserFileUtils.h"
 
+#include "ShaderParserException.h"
+#include "ShaderParserFormat.h"
 #include "ShaderParserStringUtils.h"
 
 #if defined( _WIN32 )
 #   include <direct.h>
+#else
+#   include <fcntl.h>
+#   include <sys/resource.h>
+#   include <unistd.h>
+#endif
+
+#if defined( __linux__ ) && defined( __has_include )
+#	if __has_include( <linux/io_uring.h> )
+#		include <linux/io_uring.h>
+#		include <sys/mman.h>
+#		include <sys/syscall.h>
+#		if defined( __NR_io_uring_setup ) && defined( IORING_FEAT_SINGLE_MMAP )
+#			define SHADER_PARSER_HAS_IO_URING 1
+#		endif
+#	endif
 #endif
 
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <atomic>
+
 BEGIN_NAMESPACE_SHADER_PARSER
 {
 	namespace FileUtils
 	{
+		namespace
+		{
+			static constexpr char ERROR_IO_URING_ENTER[] = "io_uring_enter failed, errno {}";
+			//! The maximum count of reads in flight in the io_uring
+			static const size_t MAX_RING_READS = 4096;
+			//! The maximum count of threads doing blocking reads
+			static const size_t MAX_READ_THREADS = 256;
+
+			/** Tells if a file name matches a pattern, '*' matches any characters and '?' one character
+			*/
+			bool MatchPattern( char const * name, char const * nameEnd, char const * pattern, char const * patternEnd )
+			{
+				char const * l_star = NULL;
+				char const * l_starName = name;
+
+				while ( name != nameEnd )
+				{
+					if ( pattern != patternEnd && ( *pattern == '?' || *pattern == *name ) )
+					{
+						++name;
+						++pattern;
+					}
+					else if ( pattern != patternEnd && *pattern == '*' )
+					{
+						l_star = pattern++;
+						l_starName = name;
+					}
+					else if ( l_star )
+					{
+						//!@remarks Let the last star match one more character.
+						pattern = l_star + 1;
+						name = ++l_starName;
+					}
+					else
+					{
+						return false;
+					}
+				}
+
+				while ( pattern != patternEnd && *pattern == '*' )
+				{
+					++pattern;
+				}
+
+				return pattern == patternEnd;
+			}
+
+			/** Reads a whole file, with blocking reads
+			*/
+			void ReadFile( SLoadedFile & file )
+			{
+				file.m_error = 0;
+#if defined( _WIN32 )
+
+				FILE * l_file = NULL;
+
+				if ( !FOpen( l_file, file.m_path.c_str(), "rb" ) )
+				{
+					file.m_error = errno;
+					return;
+				}
+
+				char l_buffer[16384];
+				size_t l_read;
+
+				while ( ( l_read = fread( l_buffer, 1, sizeof( l_buffer ), l_file ) ) != 0 )
+				{
+					file.m_content.append( l_buffer, l_read );
+				}
+
+				if ( ferror( l_file ) )
+				{
+					file.m_error = EIO;
+					file.m_content.clear();
+				}
+
+				fclose( l_file );
+
+#else
+
+				int l_fd = open( file.m_path.c_str(), O_RDONLY | O_CLOEXEC );
+				struct stat l_stat;
+
+				if ( l_fd < 0 )
+				{
+					file.m_error = errno;
+					return;
+				}
+
+				if ( fstat( l_fd, &l_stat ) != 0 )
+				{
+					file.m_error = errno;
+					close( l_fd );
+					return;
+				}
+
+				file.m_content.resize( size_t( l_stat.st_size ) );
+				size_t l_offset = 0;
+
+				while ( l_offset < file.m_content.size() )
+				{
+					ssize_t l_read = pread( l_fd, &file.m_content[l_offset], file.m_content.size() - l_offset, off_t( l_offset ) );
+
+					if ( l_read > 0 )
+					{
+						l_offset += size_t( l_read );
+					}
+					else if ( l_read == 0 )
+					{
+						//!@remarks The file was truncated since fstat.
+						file.m_content.resize( l_offset );
+					}
+					else if ( errno != EINTR )
+					{
+						file.m_error = errno;
+						file.m_content.clear();
+						break;
+					}
+				}
+
+				close( l_fd );
+
+#endif
+			}
+
+			/** Loads files with blocking reads, on a pool of threads, and gives them to the calling thread
+			*/
+			void LoadFilesThreads( std::vector< String > const & paths, size_t threads, std::function< void( size_t, SLoadedFile & ) > const & onLoaded )
+			{
+				std::atomic< size_t > l_next( 0 );
+				std::mutex l_mutex;
+				std::condition_variable l_loaded;
+				std::deque< std::pair< size_t, SLoadedFile > > l_files;
+				std::vector< std::thread > l_threads;
+
+				for ( size_t i = 0; i < threads; ++i )
+				{
+					l_threads.emplace_back( [&]()
+					{
+						size_t l_index;
+
+						while ( ( l_index = l_next++ ) < paths.size() )
+						{
+							SLoadedFile l_file = { paths[l_index], String(), 0 };
+							ReadFile( l_file );
+							std::unique_lock< std::mutex > l_lock( l_mutex );
+							l_files.emplace_back( l_index, std::move( l_file ) );
+							l_loaded.notify_one();
+						}
+					} );
+				}
+
+				try
+				{
+					std::deque< std::pair< size_t, SLoadedFile > > l_ready;
+
+					for ( size_t l_done = 0; l_done < paths.size(); )
+					{
+						{
+							std::unique_lock< std::mutex > l_lock( l_mutex );
+							l_loaded.wait( l_lock, [&l_files]()
+							{
+								return !l_files.empty();
+							} );
+							l_ready.swap( l_files );
+						}
+
+						for ( auto & l_file : l_ready )
+						{
+							++l_done;
+							onLoaded( l_file.first, l_file.second );
+						}
+
+						l_ready.clear();
+					}
+				}
+				catch ( ... )
+				{
+					l_next = paths.size();
+
+					for ( auto & l_thread : l_threads )
+					{
+						l_thread.join();
+					}
+
+					throw;
+				}
+
+				for ( auto & l_thread : l_threads )
+				{
+					l_thread.join();
+				}
+			}
+
+#if defined( SHADER_PARSER_HAS_IO_URING )
+
+			/** An io_uring instance, used through the raw system calls
+			*/
+			class CRing
+			{
+			public:
+				CRing()
+					: m_fd( -1 )
+					, m_ring( MAP_FAILED )
+					, m_ringSize( 0 )
+					, m_sqes( MAP_FAILED )
+					, m_sqesSize( 0 )
+					, m_unsubmitted( 0 )
+					, m_inFlight( 0 )
+				{
+				}
+
+				~CRing()
+				{
+					if ( m_sqes != MAP_FAILED )
+					{
+						munmap( m_sqes, m_sqesSize );
+					}
+
+					if ( m_ring != MAP_FAILED )
+					{
+						munmap( m_ring, m_ringSize );
+					}
+
+					if ( m_fd >= 0 )
+					{
+						close( m_fd );
+					}
+				}
+
+				/** Creates the ring
+				@return
+					\p false if io_uring, or the opcodes used to read files, are not supported.
+				*/
+				bool Initialise( unsigned entries )
+				{
+					io_uring_params l_params;
+					std::memset( &l_params, 0, sizeof( l_params ) );
+					m_fd = int( syscall( __NR_io_uring_setup, entries, &l_params ) );
+
+					//!@remarks The kernels without a shared rings mapping don't have the OPENAT and READ opcodes either.
+					if ( m_fd < 0 || !( l_params.features & IORING_FEAT_SINGLE_MMAP ) || !DoCheckOpcodes() )
+					{
+						return false;
+					}
+
+					m_ringSize = std::max( l_params.sq_off.array + l_params.sq_entries * sizeof( unsigned ), l_params.cq_off.cqes + l_params.cq_entries * sizeof( io_uring_cqe ) );
+					m_ring = mmap( NULL, m_ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING );
+					m_sqesSize = l_params.sq_entries * sizeof( io_uring_sqe );
+					m_sqes = mmap( NULL, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES );
+
+					if ( m_ring == MAP_FAILED || m_sqes == MAP_FAILED )
+					{
+						return false;
+					}
+
+					char * l_ring = static_cast< char * >( m_ring );
+					m_sqTail = reinterpret_cast< unsigned * >( l_ring + l_params.sq_off.tail );
+					m_sqMask = *reinterpret_cast< unsigned * >( l_ring + l_params.sq_off.ring_mask );
+					m_sqArray = reinterpret_cast< unsigned * >( l_ring + l_params.sq_off.array );
+					m_cqHead = reinterpret_cast< unsigned * >( l_ring + l_params.cq_off.head );
+					m_cqTail = reinterpret_cast< unsigned * >( l_ring + l_params.cq_off.tail );
+					m_cqMask = *reinterpret_cast< unsigned * >( l_ring + l_params.cq_off.ring_mask );
+					m_cqes = reinterpret_cast< io_uring_cqe * >( l_ring + l_params.cq_off.cqes );
+					return true;
+				}
+
+				/** Queues a file opening
+				*/
+				void PrepareOpen( uint64_t data, char const * path )
+				{
+					io_uring_sqe & l_sqe = DoGetSqe( data, IORING_OP_OPENAT );
+					l_sqe.fd = AT_FDCWD;
+					l_sqe.addr = uint64_t( uintptr_t( path ) );
+					l_sqe.open_flags = O_RDONLY | O_CLOEXEC;
+					DoPush();
+				}
+
+				/** Queues a file read
+				*/
+				void PrepareRead( uint64_t data, int fd, char * buffer, size_t size, size_t offset )
+				{
+					io_uring_sqe & l_sqe = DoGetSqe( data, IORING_OP_READ );
+					l_sqe.fd = fd;
+					l_sqe.addr = uint64_t( uintptr_t( buffer ) );
+					l_sqe.len = unsigned( std::min( size, size_t( 1 ) << 30 ) );
+					l_sqe.off = offset;
+					DoPush();
+				}
+
+				/** Submits the queued operations, and waits for at least one completion
+				*/
+				void SubmitAndWait()
+				{
+					while ( true )
+					{
+						int l_result = int( syscall( __NR_io_uring_enter, m_fd, m_unsubmitted, 1, IORING_ENTER_GETEVENTS, NULL, 0 ) );
+
+						if ( l_result >= 0 )
+						{
+							m_unsubmitted -= unsigned( l_result );
+							m_inFlight += unsigned( l_result );
+
+							if ( !m_unsubmitted )
+							{
+								return;
+							}
+						}
+						else if ( errno == EAGAIN || errno == EBUSY )
+						{
+							//!@remarks The completions must be consumed before submitting more.
+							return;
+						}
+						else if ( errno != EINTR )
+						{
+							PARSER_EXCEPT( EShaderParserExceptionCodes_SystemError, PARSER_FORMAT( ERROR_IO_URING_ENTER, errno ) );
+						}
+					}
+				}
+
+				/** Consumes the available completions
+				*/
+				template< typename Function >
+				void Reap( Function function )
+				{
+					unsigned l_head = *m_cqHead;
+
+					while ( l_head != __atomic_load_n( m_cqTail, __ATOMIC_ACQUIRE ) )
+					{
+						io_uring_cqe l_cqe = m_cqes[l_head & m_cqMask];
+						__atomic_store_n( m_cqHead, ++l_head, __ATOMIC_RELEASE );
+						--m_inFlight;
+						function( l_cqe.user_data, l_cqe.res );
+					}
+				}
+
+				/** Waits for the completion of all the submitted operations, without submitting the queued ones
+				@param[in] function
+					Called for each completion
+				@return
+					\p false if the completions could not be waited for.
+				*/
+				template< typename Function >
+				bool Drain( Function function )
+				{
+					Reap( function );
+
+					while ( m_inFlight )
+					{
+						if ( syscall( __NR_io_uring_enter, m_fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0 ) < 0 && errno != EINTR )
+						{
+							return false;
+						}
+
+						Reap( function );
+					}
+
+					return true;
+				}
+
+			private:
+				bool DoCheckOpcodes()
+				{
+					std::vector< char > l_buffer( sizeof( io_uring_probe ) + 256 * sizeof( io_uring_probe_op ), 0 );
+					io_uring_probe * l_probe = reinterpret_cast< io_uring_probe * >( l_buffer.data() );
+
+					return syscall( __NR_io_uring_register, m_fd, IORING_REGISTER_PROBE, l_probe, 256 ) == 0
+						&& l_probe->last_op >= IORING_OP_READ
+						&& ( l_probe->ops[IORING_OP_OPENAT].flags & IO_URING_OP_SUPPORTED )
+						&& ( l_probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED );
+				}
+
+				io_uring_sqe & DoGetSqe( uint64_t data, uint8_t opcode )
+				{
+					unsigned l_index = *m_sqTail & m_sqMask;
+					io_uring_sqe & l_sqe = static_cast< io_uring_sqe * >( m_sqes )[l_index];
+					std::memset( &l_sqe, 0, sizeof( l_sqe ) );
+					l_sqe.opcode = opcode;
+					l_sqe.user_data = data;
+					m_sqArray[l_index] = l_index;
+					return l_sqe;
+				}
+
+				void DoPush()
+				{
+					__atomic_store_n( m_sqTail, *m_sqTail + 1, __ATOMIC_RELEASE );
+					++m_unsubmitted;
+				}
+
+			private:
+				//! The ring file descriptor
+				int m_fd;
+				//! The submission and completion rings mapping
+				void * m_ring;
+				size_t m_ringSize;
+				//! The submission entries mapping
+				void * m_sqes;
+				size_t m_sqesSize;
+				//! The submission ring
+				unsigned * m_sqTail;
+				unsigned m_sqMask;
+				unsigned * m_sqArray;
+				//! The completion ring
+				unsigned * m_cqHead;
+				unsigned * m_cqTail;
+				unsigned m_cqMask;
+				io_uring_cqe * m_cqes;
+				//! The count of queued, not yet submitted, operations
+				unsigned m_unsubmitted;
+				//! The count of submitted, not yet completed, operations
+				unsigned m_inFlight;
+			};
+
+			/** A file read through io_uring
+			*/
+			struct SRingRead
+			{
+				//! The file index
+				size_t m_index;
+				//! The file descriptor, negative while the file is being opened
+				int m_fd;
+				//! The count of bytes read
+				size_t m_offset;
+				//! The file
+				SLoadedFile m_file;
+			};
+
+			/** Loads files with io_uring, keeping many opens and reads in flight
+			@return
+				\p false if io_uring is not available.
+			*/
+			bool LoadFilesRing( std::vector< String > const & paths, size_t inFlight, std::function< void( size_t, SLoadedFile & ) > const & onLoaded )
+			{
+				CRing l_ring;
+
+				if ( !l_ring.Initialise( unsigned( inFlight ) ) )
+				{
+					return false;
+				}
+
+				std::vector< SRingRead > l_reads( inFlight );
+				std::vector< uint64_t > l_free;
+				//!@remarks The slots whose opening failed for lack of file descriptors, opened again when another slot completes.
+				std::deque< uint64_t > l_reopen;
+				size_t l_next = 0;
+				size_t l_pending = 0;
+				std::exception_ptr l_exception;
+
+				for ( size_t i = inFlight; i > 0; --i )
+				{
+					l_free.push_back( i - 1 );
+				}
+
+				auto l_complete = [&]( uint64_t slot )
+				{
+					SRingRead & l_read = l_reads[slot];
+
+					if ( l_read.m_fd >= 0 )
+					{
+						close( l_read.m_fd );
+						l_read.m_fd = -1;
+					}
+
+					if ( l_read.m_file.m_error )
+					{
+						l_read.m_file.m_content.clear();
+					}
+
+					if ( !l_exception )
+					{
+						try
+						{
+							onLoaded( l_read.m_index, l_read.m_file );
+						}
+						catch ( ... )
+						{
+							//!@remarks The reads in flight still use the buffers, they are completed before rethrowing.
+							l_exception = std::current_exception();
+						}
+					}
+
+					l_read.m_file = SLoadedFile();
+					l_free.push_back( slot );
+					--l_pending;
+
+					if ( !l_reopen.empty() && !l_exception )
+					{
+						uint64_t l_slot = l_reopen.front();
+						l_reopen.pop_front();
+						l_ring.PrepareOpen( l_slot, l_reads[l_slot].m_file.m_path.c_str() );
+					}
+				};
+
+				try
+				{
+					while ( ( l_next < paths.size() && !l_exception ) || l_pending )
+					{
+						while ( !l_free.empty() && l_next < paths.size() && !l_exception && l_reopen.empty() )
+						{
+							uint64_t l_slot = l_free.back();
+							l_free.pop_back();
+							SRingRead & l_read = l_reads[l_slot];
+							l_read.m_index = l_next;
+							l_read.m_fd = -1;
+							l_read.m_offset = 0;
+							l_read.m_file = SLoadedFile{ paths[l_next++], String(), 0 };
+							l_ring.PrepareOpen( l_slot, l_read.m_file.m_path.c_str() );
+							++l_pending;
+						}
+
+						while ( l_exception && !l_reopen.empty() )
+						{
+							uint64_t l_slot = l_reopen.front();
+							l_reopen.pop_front();
+							l_complete( l_slot );
+						}
+
+						if ( !l_pending )
+						{
+							break;
+						}
+
+						l_ring.SubmitAndWait();
+						l_ring.Reap( [&]( uint64_t slot, int result )
+						{
+							SRingRead & l_read = l_reads[slot];
+							SLoadedFile & l_file = l_read.m_file;
+
+							if ( result == -EINTR || result == -EAGAIN )
+							{
+								//!@remarks Retry the interrupted operation.
+								if ( l_read.m_fd < 0 )
+								{
+									l_ring.PrepareOpen( slot, l_file.m_path.c_str() );
+								}
+								else
+								{
+									l_ring.PrepareRead( slot, l_read.m_fd, &l_file.m_content[l_read.m_offset], l_file.m_content.size() - l_read.m_offset, l_read.m_offset );
+								}
+							}
+							else if ( ( result == -EMFILE || result == -ENFILE ) && l_read.m_fd < 0 && l_pending > l_reopen.size() + 1 )
+							{
+								//!@remarks Out of file descriptors, the file is opened again when one of the other operations in flight completes.
+								l_reopen.push_back( slot );
+							}
+							else if ( result < 0 )
+							{
+								l_file.m_error = -result;
+								l_complete( slot );
+							}
+							else
+							{
+								if ( l_read.m_fd < 0 )
+								{
+									//!@remarks The inode was loaded by the opening, fstat doesn't wait for the disk.
+									struct stat l_stat;
+									l_read.m_fd = result;
+
+									if ( fstat( l_read.m_fd, &l_stat ) != 0 )
+									{
+										l_file.m_error = errno;
+									}
+									else
+									{
+										l_file.m_content.resize( size_t( l_stat.st_size ) );
+									}
+								}
+								else if ( result == 0 )
+								{
+									//!@remarks The file was truncated since fstat.
+									l_file.m_content.resize( l_read.m_offset );
+								}
+								else
+								{
+									l_read.m_offset += size_t( result );
+								}
+
+								if ( l_file.m_error || l_read.m_offset == l_file.m_content.size() )
+								{
+									l_complete( slot );
+								}
+								else
+								{
+									l_ring.PrepareRead( slot, l_read.m_fd, &l_file.m_content[l_read.m_offset], l_file.m_content.size() - l_read.m_offset, l_read.m_offset );
+								}
+							}
+						} );
+					}
+				}
+				catch ( ... )
+				{
+					//!@remarks The kernel still writes in the buffers of the submitted operations, they must complete before the buffers are released.
+					bool l_drained = l_ring.Drain( [&l_reads]( uint64_t slot, int result )
+					{
+						if ( l_reads[slot].m_fd < 0 && result >= 0 )
+						{
+							close( result );
+						}
+					} );
+
+					for ( auto & l_read : l_reads )
+					{
+						if ( l_read.m_fd >= 0 )
+						{
+							close( l_read.m_fd );
+						}
+					}
+
+					if ( !l_drained )
+					{
+						//!@remarks The operations can't be waited for, the buffers are leaked rather than released while being written.
+						new std::vector< SRingRead >( std::move( l_reads ) );
+					}
+
+					throw;
+				}
+
+				if ( l_exception )
+				{
+					std::rethrow_exception( l_exception );
+				}
+
+				return true;
+			}
+
+#endif
+
+			/** Loads files, calling a function with the index of each one
+			*/
+			void DoLoadFiles( std::vector< String > const & paths, size_t inFlight, EReadMethod method, std::function< void( size_t, SLoadedFile & ) > const & onLoaded )
+			{
+				inFlight = std::max( size_t( 1 ), std::min( inFlight, paths.size() ) );
+
+				if ( paths.empty() )
+				{
+					return;
+				}
+
+#if !defined( _WIN32 )
+
+				//!@remarks Each file being read holds a file descriptor, half of the process limit is left to the other users.
+				rlimit l_limit;
+
+				if ( getrlimit( RLIMIT_NOFILE, &l_limit ) == 0 && l_limit.rlim_cur != RLIM_INFINITY )
+				{
+					inFlight = std::min( inFlight, std::max( size_t( 1 ), size_t( l_limit.rlim_cur / 2 ) ) );
+				}
+
+#endif
+#if defined( SHADER_PARSER_HAS_IO_URING )
+
+				if ( method == EReadMethod_AUTO && LoadFilesRing( paths, std::min( inFlight, MAX_RING_READS ), onLoaded ) )
+				{
+					return;
+				}
+
+#endif
+
+				LoadFilesThreads( paths, std::min( inFlight, MAX_READ_THREADS ), onLoaded );
+			}
+		}
+
 #if defined( _MSC_VER)
 
 		bool FOpen( FILE *& p_pFile, char const * p_pszPath, char const * p_pszMode )
@@ -98,6 +780,90 @@ BEGIN_NAMESPACE_SHADER_PARSER
 				return false;
 			}
 		}
+
+		bool MatchPattern( String const & name, String const & pattern )
+		{
+			if ( pattern.empty() )
+			{
+				return true;
+			}
+
+			size_t l_begin = 0;
+
+			while ( l_begin <= pattern.size() )
+			{
+				size_t l_end = std::min( pattern.find( ';', l_begin ), pattern.size() );
+
+				if ( MatchPattern( name.data(), name.data() + name.size(), pattern.data() + l_begin, pattern.data() + l_end ) )
+				{
+					return true;
+				}
+
+				l_begin = l_end + 1;
+			}
+
+			return false;
+		}
+
+		std::vector< String > ListFiles( String const & root, String const & pattern )
+		{
+			std::vector< String > l_result;
+			std::vector< boost::filesystem::path > l_folders( 1, boost::filesystem::path( root ) );
+
+			while ( !l_folders.empty() )
+			{
+				boost::filesystem::path l_folder = std::move( l_folders.back() );
+				l_folders.pop_back();
+				boost::system::error_code l_error;
+				boost::filesystem::directory_iterator l_end;
+
+				//!@remarks The unreadable folders are skipped, the symbolic links to folders are not followed.
+				for ( boost::filesystem::directory_iterator l_it( l_folder, l_error ); !l_error && l_it != l_end; l_it.increment( l_error ) )
+				{
+					boost::filesystem::file_status l_status = l_it->symlink_status( l_error );
+
+					if ( boost::filesystem::is_directory( l_status ) )
+					{
+						l_folders.push_back( l_it->path() );
+					}
+					else if ( boost::filesystem::is_regular_file( l_it->status( l_error ) ) && MatchPattern( l_it->path().filename().string(), pattern ) )
+					{
+						l_result.push_back( l_it->path().string() );
+					}
+
+					l_error.clear();
+				}
+			}
+
+			std::sort( l_result.begin(), l_result.end() );
+			return l_result;
+		}
+
+		void LoadFiles( std::vector< String > const & paths, LoadedFileFunction const & onLoaded, size_t inFlight, EReadMethod method )
+		{
+			DoLoadFiles( paths, inFlight, method, [&onLoaded]( size_t, SLoadedFile & file )
+			{
+				onLoaded( file );
+			} );
+		}
+
+		size_t LoadTree( String const & root, String const & pattern, LoadedFileFunction const & onLoaded, size_t inFlight, EReadMethod method )
+		{
+			std::vector< String > l_paths = ListFiles( root, pattern );
+			LoadFiles( l_paths, onLoaded, inFlight, method );
+			return l_paths.size();
+		}
+
+		std::vector< SLoadedFile > LoadTree( String const & root, String const & pattern, size_t inFlight, EReadMethod method )
+		{
+			std::vector< String > l_paths = ListFiles( root, pattern );
+			std::vector< SLoadedFile > l_result( l_paths.size() );
+			DoLoadFiles( l_paths, inFlight, method, [&l_result]( size_t index, SLoadedFile & file )
+			{
+				l_result[index] = std::move( file );
+			} );
+			return l_result;
+		}
 	}
 }
 END_NAMESPACE_SHADER_PARSER
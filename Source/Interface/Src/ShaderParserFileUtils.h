@@ -14,6 +14,8 @@
 
 #include "ShaderParserPrerequisites.h"
 
+#include "EReadMethod.h"
+
 BEGIN_NAMESPACE_SHADER_PARSER
 {
 	namespace FileUtils
@@ -50,6 +52,96 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		@return true if the folder was correctly created
 		*/
 		ShaderParserExport bool CreateFolder( String const & pathFolder );
+
+		/** A file loaded by LoadTree
+		*/
+		struct SLoadedFile
+		{
+			//! The file path
+			String m_path;
+			//! The file content, empty if it could not be read
+			String m_content;
+			//! The errno value of the failed read, 0 on success
+			int m_error;
+		};
+
+		/** Function receiving the files loaded by LoadTree, it may move their content away
+		*/
+		typedef std::function< void( SLoadedFile & file ) > LoadedFileFunction;
+
+		//! The default maximum count of reads in flight
+		static const size_t DEFAULT_READS_IN_FLIGHT = 64;
+
+		/** Tells if a file name matches a pattern
+		@param[in] name
+			The file name, without its folder
+		@param[in] pattern
+			The pattern, '*' matches any characters and '?' one character, several patterns are separated by ';'.
+			An empty pattern matches all the names.
+		@return
+			\p true if the name matches one of the patterns.
+		*/
+		ShaderParserExport bool MatchPattern( String const & name, String const & pattern );
+
+		/** Lists the files of a folder and its subfolders, whose name matches a pattern
+		@param[in] root
+			The folder
+		@param[in] pattern
+			The file name pattern, as for MatchPattern
+		@return
+			The files paths, sorted, empty if the folder doesn't exist.
+		*/
+		ShaderParserExport std::vector< String > ListFiles( String const & root, String const & pattern );
+
+		/** Loads files
+		@remarks
+			Many reads are kept in flight, so the files are given in their completion order.
+			The function is called on the calling thread, while the next files are read.
+			The reads in flight are limited to half the process file descriptors limit. With io_uring, running out
+			of file descriptors delays the next reads instead of failing them.
+		@param[in] paths
+			The files paths
+		@param[in] onLoaded
+			Called for each file, loaded or not
+		@param[in] inFlight
+			The maximum count of reads in flight
+		@param[in] method
+			The read method
+		*/
+		ShaderParserExport void LoadFiles( std::vector< String > const & paths, LoadedFileFunction const & onLoaded, size_t inFlight = DEFAULT_READS_IN_FLIGHT, EReadMethod method = EReadMethod_AUTO );
+
+		/** Loads the files of a folder and its subfolders, whose name matches a pattern
+		@remarks
+			Many reads are kept in flight, so the files are given in their completion order, not in their path order.
+			The function is called on the calling thread, while the next files are read.
+		@param[in] root
+			The folder
+		@param[in] pattern
+			The file name pattern, as for ListFiles
+		@param[in] onLoaded
+			Called for each file, loaded or not
+		@param[in] inFlight
+			The maximum count of reads in flight
+		@param[in] method
+			The read method
+		@return
+			The files count.
+		*/
+		ShaderParserExport size_t LoadTree( String const & root, String const & pattern, LoadedFileFunction const & onLoaded, size_t inFlight = DEFAULT_READS_IN_FLIGHT, EReadMethod method = EReadMethod_AUTO );
+
+		/** Loads the files of a folder and its subfolders, whose name matches a pattern
+		@param[in] root
+			The folder
+		@param[in] pattern
+			The file name pattern, as for ListFiles
+		@param[in] inFlight
+			The maximum count of reads in flight
+		@param[in] method
+			The read method
+		@return
+			The files, sorted by path.
+		*/
+		ShaderParserExport std::vector< SLoadedFile > LoadTree( String const & root, String const & pattern, size_t inFlight = DEFAULT_READS_IN_FLIGHT, EReadMethod method = EReadMethod_AUTO );
 	}
 }
 END_NAMESPACE_SHADER_PARSER
@@ -0,0 +1,558 @@
+/************************************************************************//**
+* @file ShaderParserFileWatcher.cpp
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief CFileWatcher class definition.
+*
+***************************************************************************/
+
+#include "ShaderParserPch.h"
+
+#include "ShaderParserFileWatcher.h"
+#include "ShaderParserException.h"
+#include "ShaderParserFileUtils.h"
+#include "ShaderParserLogger.h"
+
+#if defined( __linux__ )
+#	include <poll.h>
+#	include <sys/eventfd.h>
+#	include <sys/inotify.h>
+#	include <unistd.h>
+#endif
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iterator>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	static const String ERROR_WATCHER_CALLBACK = STR( "File watcher changes callback failed" );
+	static const String ERROR_WATCHER_UNSUPPORTED = STR( "File watcher could not be created, the changes won't be reported for " );
+
+	namespace
+	{
+#if defined( __linux__ )
+
+		//! The watched folders events
+		static const uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_DONT_FOLLOW | IN_EXCL_UNLINK;
+
+#endif
+
+		/** Removes the "." and ".." parts of a path, without accessing the file system
+		*/
+		String Normalise( boost::filesystem::path const & path )
+		{
+			boost::filesystem::path l_result;
+
+			for ( auto && l_part : path )
+			{
+				if ( l_part == ".." && !l_result.empty() && l_result.filename() != ".." && l_result != l_result.root_path() )
+				{
+					l_result.remove_filename();
+				}
+				else if ( l_part != "." )
+				{
+					l_result /= l_part;
+				}
+			}
+
+			return l_result.string();
+		}
+
+		/** Retrieves the absolute path of a folder, without symbolic links, if it exists
+		*/
+		String CanonicalPath( String const & path )
+		{
+			boost::system::error_code l_error;
+			boost::filesystem::path l_result = boost::filesystem::canonical( path, l_error );
+			return l_error ? Normalise( boost::filesystem::absolute( path ) ) : l_result.string();
+		}
+
+		/** Tells if a path is an existing regular file
+		*/
+		bool IsFile( String const & path )
+		{
+			boost::system::error_code l_error;
+			return boost::filesystem::is_regular_file( path, l_error );
+		}
+
+		/** Retrieves the files named by the #include directives of a source
+		@remarks
+			The conditional compilation and the comments are ignored, so a disabled directive still gives a dependency.
+		*/
+		std::vector< String > ListIncludes( String const & content )
+		{
+			std::vector< String > l_result;
+			size_t l_line = 0;
+
+			while ( l_line < content.size() )
+			{
+				size_t l_end = std::min( content.find( '\n', l_line ), content.size() );
+				size_t l_index = content.find_first_not_of( STR( " \t" ), l_line );
+
+				if ( l_index < l_end && content[l_index] == '#' )
+				{
+					l_index = content.find_first_not_of( STR( " \t" ), l_index + 1 );
+
+					if ( l_index < l_end && content.compare( l_index, 7, STR( "include" ) ) == 0 )
+					{
+						l_index = content.find_first_not_of( STR( " \t" ), l_index + 7 );
+
+						if ( l_index < l_end && ( content[l_index] == '"' || content[l_index] == '<' ) )
+						{
+							size_t l_close = content.find( content[l_index] == '"' ? '"' : '>', l_index + 1 );
+
+							if ( l_close < l_end && l_close > l_index + 1 )
+							{
+								l_result.push_back( content.substr( l_index + 1, l_close - l_index - 1 ) );
+							}
+						}
+					}
+				}
+
+				l_line = l_end + 1;
+			}
+
+			return l_result;
+		}
+	}
+
+	CFileWatcher::CFileWatcher( String const & p_root, String const & p_pattern, Callback const & p_callback, std::chrono::milliseconds p_debounce )
+		: m_root( CanonicalPath( p_root ) )
+		, m_pattern( p_pattern )
+		, m_callback( p_callback )
+		, m_debounce( std::max( p_debounce, std::chrono::milliseconds( 1 ) ) )
+		, m_inotify( -1 )
+		, m_wakeup( -1 )
+		, m_overflow( false )
+	{
+#if defined( __linux__ )
+
+		m_inotify = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+		m_wakeup = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+
+#endif
+
+		if ( m_inotify < 0 || m_wakeup < 0 )
+		{
+			CLogger::LogWarning( ERROR_WATCHER_UNSUPPORTED + m_root );
+			return;
+		}
+
+		//!@remarks The folders are watched before being scanned, so no change is missed.
+		std::vector< String > l_files;
+		DoWatchTree( m_root, l_files );
+		FileUtils::LoadFiles( l_files, [this]( FileUtils::SLoadedFile & file )
+		{
+			DoUpdateIncludes( file.m_path, file.m_content );
+		} );
+
+		m_thread = std::thread( [this]()
+		{
+			DoWatch();
+		} );
+	}
+
+	CFileWatcher::~CFileWatcher()
+	{
+#if defined( __linux__ )
+
+		if ( m_thread.joinable() )
+		{
+			uint64_t l_value = 1;
+
+			if ( write( m_wakeup, &l_value, sizeof( l_value ) ) == sizeof( l_value ) )
+			{
+				m_thread.join();
+			}
+			else
+			{
+				m_thread.detach();
+			}
+		}
+
+		if ( m_inotify >= 0 )
+		{
+			close( m_inotify );
+		}
+
+		if ( m_wakeup >= 0 )
+		{
+			close( m_wakeup );
+		}
+
+#endif
+	}
+
+	bool CFileWatcher::IsWatching()const
+	{
+		return m_thread.joinable();
+	}
+
+	void CFileWatcher::DoWatchTree( String const & p_folder, std::vector< String > & p_files )
+	{
+		std::vector< String > l_folders( 1, p_folder );
+
+		while ( !l_folders.empty() )
+		{
+			String l_folder = std::move( l_folders.back() );
+			l_folders.pop_back();
+
+#if defined( __linux__ )
+
+			int l_watch = inotify_add_watch( m_inotify, l_folder.c_str(), WATCH_MASK );
+
+			if ( l_watch < 0 )
+			{
+				continue;
+			}
+
+			m_folders[l_watch] = l_folder;
+
+#endif
+
+			boost::system::error_code l_error;
+			boost::filesystem::directory_iterator l_end;
+
+			for ( boost::filesystem::directory_iterator l_it( l_folder, l_error ); !l_error && l_it != l_end; l_it.increment( l_error ) )
+			{
+				if ( boost::filesystem::is_directory( l_it->symlink_status( l_error ) ) )
+				{
+					l_folders.push_back( l_it->path().string() );
+				}
+				else if ( boost::filesystem::is_regular_file( l_it->status( l_error ) ) && FileUtils::MatchPattern( l_it->path().filename().string(), m_pattern ) )
+				{
+					p_files.push_back( l_it->path().string() );
+				}
+
+				l_error.clear();
+			}
+		}
+	}
+
+	void CFileWatcher::DoWatchInclude( String const & p_path )
+	{
+		String l_folder = boost::filesystem::path( p_path ).parent_path().string();
+
+		if ( IsInTree( l_folder ) || m_includeFolders.count( l_folder ) )
+		{
+			return;
+		}
+
+#if defined( __linux__ )
+
+		//!@remarks The folder stays watched as long as the watcher, even when no file includes its files anymore.
+		int l_watch = inotify_add_watch( m_inotify, l_folder.c_str(), WATCH_MASK );
+
+		if ( l_watch < 0 )
+		{
+			return;
+		}
+
+		m_folders[l_watch] = l_folder;
+
+#endif
+
+		m_includeFolders.insert( l_folder );
+	}
+
+	bool CFileWatcher::IsInTree( String const & p_path )const
+	{
+		return p_path.compare( 0, m_root.size(), m_root ) == 0
+			&& ( p_path.size() == m_root.size() || p_path.compare( m_root.size(), String( PATH_SEP ).size(), PATH_SEP ) == 0 );
+	}
+
+	void CFileWatcher::DoScanFile( String const & p_path )
+	{
+		std::ifstream l_file( p_path, std::ios::binary );
+
+		if ( !l_file )
+		{
+			DoRemoveIncludes( p_path );
+			return;
+		}
+
+		DoUpdateIncludes( p_path, String( std::istreambuf_iterator< char >( l_file ), std::istreambuf_iterator< char >() ) );
+	}
+
+	void CFileWatcher::DoUpdateIncludes( String const & p_path, String const & p_content )
+	{
+		DoRemoveIncludes( p_path );
+		std::set< String > & l_includes = m_includes[p_path];
+		boost::filesystem::path l_folder = boost::filesystem::path( p_path ).parent_path();
+		std::vector< String > l_unknown;
+
+		for ( auto && l_name : ListIncludes( p_content ) )
+		{
+			//!@remarks The name is searched relative to the including file, then to the root, as a missing file it stays relative to the including file.
+			String l_include = Normalise( l_folder / l_name );
+
+			if ( !IsFile( l_include ) )
+			{
+				String l_fromRoot = Normalise( boost::filesystem::path( m_root ) / l_name );
+
+				if ( IsFile( l_fromRoot ) )
+				{
+					l_include = l_fromRoot;
+				}
+			}
+
+			if ( l_includes.insert( l_include ).second )
+			{
+				m_dependents[l_include].insert( p_path );
+				DoWatchInclude( l_include );
+
+				if ( m_includes.find( l_include ) == m_includes.end() && IsFile( l_include ) )
+				{
+					l_unknown.push_back( l_include );
+				}
+			}
+		}
+
+		for ( auto && l_include : l_unknown )
+		{
+			if ( m_includes.find( l_include ) == m_includes.end() )
+			{
+				DoScanFile( l_include );
+			}
+		}
+	}
+
+	void CFileWatcher::DoRemoveIncludes( String const & p_path )
+	{
+		auto l_it = m_includes.find( p_path );
+
+		if ( l_it != m_includes.end() )
+		{
+			for ( auto && l_include : l_it->second )
+			{
+				auto l_dependents = m_dependents.find( l_include );
+				l_dependents->second.erase( p_path );
+
+				if ( l_dependents->second.empty() )
+				{
+					m_dependents.erase( l_dependents );
+				}
+			}
+
+			m_includes.erase( l_it );
+		}
+	}
+
+	void CFileWatcher::DoWatch()
+	{
+#if defined( __linux__ )
+
+		typedef std::chrono::steady_clock clock;
+		clock::time_point l_first;
+		clock::time_point l_last;
+
+		while ( true )
+		{
+			bool l_pending = m_overflow || !m_changed.empty();
+			int l_timeout = -1;
+
+			if ( l_pending )
+			{
+				auto l_remaining = std::min( l_last + m_debounce, l_first + 10 * m_debounce ) - clock::now();
+				l_timeout = int( std::max( std::chrono::duration_cast< std::chrono::milliseconds >( l_remaining ).count() + 1, int64_t( 0 ) ) );
+			}
+
+			pollfd l_fds[2] = { { m_inotify, POLLIN, 0 }, { m_wakeup, POLLIN, 0 } };
+
+			if ( poll( l_fds, 2, l_timeout ) < 0 && errno != EINTR )
+			{
+				break;
+			}
+
+			if ( l_fds[1].revents )
+			{
+				break;
+			}
+
+			if ( l_fds[0].revents & POLLIN )
+			{
+				DoReadEvents();
+
+				if ( m_overflow || !m_changed.empty() )
+				{
+					l_last = clock::now();
+					l_first = l_pending ? l_first : l_last;
+				}
+			}
+
+			if ( ( m_overflow || !m_changed.empty() ) && clock::now() >= std::min( l_last + m_debounce, l_first + 10 * m_debounce ) )
+			{
+				DoReport();
+			}
+		}
+
+#endif
+	}
+
+	void CFileWatcher::DoReadEvents()
+	{
+#if defined( __linux__ )
+
+		alignas( inotify_event ) char l_buffer[16384];
+		ssize_t l_size;
+
+		while ( ( l_size = read( m_inotify, l_buffer, sizeof( l_buffer ) ) ) > 0 )
+		{
+			for ( char * l_data = l_buffer; l_data < l_buffer + l_size; )
+			{
+				inotify_event const & l_event = *reinterpret_cast< inotify_event const * >( l_data );
+				l_data += sizeof( inotify_event ) + l_event.len;
+
+				if ( l_event.mask & IN_Q_OVERFLOW )
+				{
+					m_overflow = true;
+					continue;
+				}
+
+				auto l_folder = m_folders.find( l_event.wd );
+
+				if ( l_folder == m_folders.end() )
+				{
+					continue;
+				}
+
+				if ( l_event.mask & IN_IGNORED )
+				{
+					m_includeFolders.erase( l_folder->second );
+					m_folders.erase( l_folder );
+					continue;
+				}
+
+				if ( !l_event.len )
+				{
+					continue;
+				}
+
+				String l_name = l_event.name;
+				String l_path = ( boost::filesystem::path( l_folder->second ) / l_name ).string();
+
+				if ( !IsInTree( l_folder->second ) )
+				{
+					//!@remarks Only the included files matter, in the folders outside the tree.
+					if ( !( l_event.mask & IN_ISDIR ) && ( m_includes.count( l_path ) || m_dependents.count( l_path ) ) )
+					{
+						m_changed.insert( l_path );
+					}
+				}
+				else if ( l_event.mask & IN_ISDIR )
+				{
+					if ( l_event.mask & ( IN_CREATE | IN_MOVED_TO ) )
+					{
+						std::vector< String > l_files;
+						DoWatchTree( l_path, l_files );
+						m_changed.insert( l_files.begin(), l_files.end() );
+					}
+					else if ( l_event.mask & IN_MOVED_FROM )
+					{
+						//!@remarks The moved folder watches would report their events with the old paths.
+						String l_prefix = l_path + PATH_SEP;
+
+						for ( auto l_it = m_folders.begin(); l_it != m_folders.end(); )
+						{
+							if ( l_it->second == l_path || l_it->second.compare( 0, l_prefix.size(), l_prefix ) == 0 )
+							{
+								inotify_rm_watch( m_inotify, l_it->first );
+								l_it = m_folders.erase( l_it );
+							}
+							else
+							{
+								++l_it;
+							}
+						}
+
+						for ( auto && l_file : m_includes )
+						{
+							if ( l_file.first.compare( 0, l_prefix.size(), l_prefix ) == 0 )
+							{
+								m_changed.insert( l_file.first );
+							}
+						}
+					}
+				}
+				else if ( FileUtils::MatchPattern( l_name, m_pattern ) || m_includes.count( l_path ) || m_dependents.count( l_path ) )
+				{
+					m_changed.insert( l_path );
+				}
+			}
+		}
+
+#endif
+	}
+
+	void CFileWatcher::DoReport()
+	{
+		if ( m_overflow )
+		{
+			//!@remarks Some events were lost, the whole tree is scanned again.
+			std::vector< String > l_files;
+			DoWatchTree( m_root, l_files );
+			m_changed.insert( l_files.begin(), l_files.end() );
+
+			for ( auto && l_file : m_includes )
+			{
+				m_changed.insert( l_file.first );
+			}
+
+			m_overflow = false;
+		}
+
+		std::vector< String > l_queue( m_changed.begin(), m_changed.end() );
+		std::set< String > l_reached;
+		m_changed.clear();
+
+		for ( auto && l_path : l_queue )
+		{
+			if ( IsFile( l_path ) )
+			{
+				DoScanFile( l_path );
+			}
+			else
+			{
+				DoRemoveIncludes( l_path );
+			}
+		}
+
+		for ( size_t i = 0; i < l_queue.size(); ++i )
+		{
+			if ( l_reached.insert( l_queue[i] ).second )
+			{
+				auto l_dependents = m_dependents.find( l_queue[i] );
+
+				if ( l_dependents != m_dependents.end() )
+				{
+					l_queue.insert( l_queue.end(), l_dependents->second.begin(), l_dependents->second.end() );
+				}
+			}
+		}
+
+		std::vector< String > l_result;
+
+		for ( auto && l_path : l_reached )
+		{
+			if ( IsInTree( l_path ) && FileUtils::MatchPattern( boost::filesystem::path( l_path ).filename().string(), m_pattern ) && IsFile( l_path ) )
+			{
+				l_result.push_back( l_path );
+			}
+		}
+
+		if ( !l_result.empty() )
+		{
+			try
+			{
+				m_callback( l_result );
+			}
+			COMMON_CATCH( ERROR_WATCHER_CALLBACK )
+		}
+	}
+}
+END_NAMESPACE_SHADER_PARSER
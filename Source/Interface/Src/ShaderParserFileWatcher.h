@@ -0,0 +1,153 @@
+/************************************************************************//**
+* @file ShaderParserFileWatcher.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief CFileWatcher class declaration.
+*
+* @details Watches a shader tree, and reports the files to parse again
+*	after a burst of changes, including the files depending on the changed
+*	ones through #include directives.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_FILE_WATCHER_H___
+#define ___SHADER_PARSER_FILE_WATCHER_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include <chrono>
+#include <set>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** Watches the files of a folder and its subfolders, whose name matches a pattern.
+	@remarks
+		The #include directives of the files are followed, to know which files depend on which ones.
+		The changes are gathered until no change happened for the debounce delay, then the changed files,
+		and the files including them, directly or not, are given to the callback, so they can be loaded
+		again through FileUtils::LoadFiles, and parsed through CParsePool.
+		The included files are tracked even if their name doesn't match the pattern, but only the matching files are reported.
+		The folders of the files included from outside the tree are watched too, without their subfolders,
+		so their changes report the files of the tree including them.
+		The watcher relies on inotify, on the other systems it doesn't report anything.
+	*/
+	class CFileWatcher
+	{
+	public:
+		//! The changes callback, called from the watcher thread, with the sorted paths of the files to parse again, under the canonical root path.
+		typedef std::function< void( std::vector< String > const & ) > Callback;
+
+	public:
+		/** Constructor, scans the tree and starts watching it.
+		@param[in] root
+			The tree root folder.
+		@param[in] pattern
+			The file name pattern, as for FileUtils::MatchPattern.
+		@param[in] callback
+			The function receiving the files to parse again.
+		@param[in] debounce
+			The delay without change after which the changes are reported.
+			During a continuous burst of changes, they are reported at least every ten delays.
+		*/
+		ShaderParserExport CFileWatcher( String const & root, String const & pattern, Callback const & callback, std::chrono::milliseconds debounce = std::chrono::milliseconds( 100 ) );
+
+		/** Destructor, stops watching, the pending changes are not reported.
+		*/
+		ShaderParserExport ~CFileWatcher();
+
+		/** Tells if the tree is watched
+		@return
+			\p false if the system doesn't support the files watching.
+		*/
+		ShaderParserExport bool IsWatching()const;
+
+	private:
+		/** Watches a folder and its subfolders.
+		@param[in] folder
+			The folder.
+		@param[out] files
+			Receives the matching files found in the folders.
+		*/
+		void DoWatchTree( String const & folder, std::vector< String > & files );
+
+		/** Watches the folder of an included file, if it is outside the tree.
+		@param[in] path
+			The included file path.
+		*/
+		void DoWatchInclude( String const & path );
+
+		/** Tells if a path is in the tree.
+		@param[in] path
+			The path.
+		@return
+			\p true if the path is the root folder, or is under it.
+		*/
+		bool IsInTree( String const & path )const;
+
+		/** Reads a file, and updates its included files.
+		@param[in] path
+			The file path.
+		*/
+		void DoScanFile( String const & path );
+
+		/** Updates the included files of a file.
+		@param[in] path
+			The file path.
+		@param[in] content
+			The file content.
+		*/
+		void DoUpdateIncludes( String const & path, String const & content );
+
+		/** Forgets the included files of a file.
+		@param[in] path
+			The file path.
+		*/
+		void DoRemoveIncludes( String const & path );
+
+		/** Watcher thread loop.
+		*/
+		void DoWatch();
+
+		/** Reads the pending inotify events, and gathers the changed files.
+		*/
+		void DoReadEvents();
+
+		/** Reports the gathered changes.
+		*/
+		void DoReport();
+
+	private:
+		//! The tree root folder
+		String m_root;
+		//! The file name pattern
+		String m_pattern;
+		//! The changes callback
+		Callback m_callback;
+		//! The delay without change after which the changes are reported
+		std::chrono::milliseconds m_debounce;
+		//! The inotify file descriptor
+		int m_inotify;
+		//! The descriptor used to wake the watcher thread up, when it must stop
+		int m_wakeup;
+		//! The watched folders, by watch descriptor
+		std::map< int, String > m_folders;
+		//! The watched folders outside the tree, holding included files
+		std::set< String > m_includeFolders;
+		//! The files included by each file
+		std::map< String, std::set< String > > m_includes;
+		//! The files including each file
+		std::map< String, std::set< String > > m_dependents;
+		//! The changed files, not reported yet
+		std::set< String > m_changed;
+		//! Tells if inotify dropped events, so that the whole tree must be reported
+		bool m_overflow;
+		//! The watcher thread
+		std::thread m_thread;
+	};
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif // ___SHADER_PARSER_FILE_WATCHER_H___
@@ -0,0 +1,337 @@
+/************************************************************************//**
+* @file ShaderParserFileWriter.cpp
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief CFileWriter and CFileWriteBatch classes definition.
+*
+***************************************************************************/
+
+#include "ShaderParserPch.h"
+
+#include "ShaderParserFileWriter.h"
+#include "ShaderParserException.h"
+#include "ShaderParserFormat.h"
+#include "ShaderParserLogger.h"
+
+#include <fcntl.h>
+
+#if defined( _WIN32 )
+#	include <io.h>
+#	include <process.h>
+#else
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	static constexpr char ERROR_WRITER_OPEN[] = "Could not create the temporary file {}: {}";
+	static constexpr char ERROR_WRITER_WRITE[] = "Could not write the temporary file {}: {}";
+	static constexpr char ERROR_WRITER_MODE[] = "Could not set the mode of the temporary file {}: {}";
+	static constexpr char ERROR_WRITER_CLOSE[] = "Could not close the temporary file {}: {}";
+	static constexpr char ERROR_WRITER_SYNC[] = "Could not synchronise {}: {}";
+	static constexpr char ERROR_WRITER_RENAME[] = "Could not replace the file {}: {}";
+	static constexpr char ERROR_WRITER_COMMITTED[] = "The file {} was already committed";
+	static const String ERROR_BATCH_SYNC = STR( "File write batch folders synchronisation failed" );
+
+	namespace
+	{
+		/** Retrieves the folder of a file, "." for a file name without folder
+		*/
+		String GetFolder( String const & path )
+		{
+			String l_result = boost::filesystem::path( path ).parent_path().string();
+			return l_result.empty() ? String( STR( "." ) ) : l_result;
+		}
+
+		/** Synchronises a folder entries
+		*/
+		void SyncFolder( String const & folder )
+		{
+#if !defined( _WIN32 )
+
+			//!@remarks Windows has no folder synchronisation, the renames are written through.
+			int l_fd = open( folder.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+
+			if ( l_fd < 0 || fsync( l_fd ) != 0 )
+			{
+				int l_error = errno;
+
+				if ( l_fd >= 0 )
+				{
+					close( l_fd );
+				}
+
+				PARSER_EXCEPT( EShaderParserExceptionCodes_SystemError, PARSER_FORMAT( ERROR_WRITER_SYNC, folder, std::strerror( l_error ) ) );
+			}
+
+			close( l_fd );
+
+#endif
+		}
+	}
+
+	//*************************************************************************************************
+
+	CFileWriteBatch::CFileWriteBatch()
+	{
+	}
+
+	CFileWriteBatch::~CFileWriteBatch()
+	{
+		try
+		{
+			Sync();
+		}
+		COMMON_CATCH( ERROR_BATCH_SYNC )
+	}
+
+	void CFileWriteBatch::Sync()
+	{
+		std::set< String > l_folders;
+		{
+			std::unique_lock< std::mutex > l_lock( m_mutex );
+			std::swap( l_folders, m_folders );
+		}
+
+		for ( auto l_it = l_folders.begin(); l_it != l_folders.end(); ++l_it )
+		{
+			try
+			{
+				SyncFolder( *l_it );
+			}
+			catch ( ... )
+			{
+				//!@remarks The folders not synchronised yet are kept for the next call.
+				std::unique_lock< std::mutex > l_lock( m_mutex );
+				m_folders.insert( l_it, l_folders.end() );
+				throw;
+			}
+		}
+	}
+
+	void CFileWriteBatch::DoAddFolder( String const & p_folder )
+	{
+		std::unique_lock< std::mutex > l_lock( m_mutex );
+		m_folders.insert( p_folder );
+	}
+
+	//*************************************************************************************************
+
+	CFileWriter::CFileWriter( String const & p_path, bool p_sync, size_t p_bufferSize )
+		: m_path( p_path )
+		, m_fd( -1 )
+		, m_sync( p_sync )
+		, m_batch( NULL )
+		, m_buffer( p_bufferSize )
+		, m_used( 0 )
+	{
+		DoOpen();
+	}
+
+	CFileWriter::CFileWriter( String const & p_path, CFileWriteBatch & p_batch, size_t p_bufferSize )
+		: m_path( p_path )
+		, m_fd( -1 )
+		, m_sync( true )
+		, m_batch( &p_batch )
+		, m_buffer( p_bufferSize )
+		, m_used( 0 )
+	{
+		DoOpen();
+	}
+
+	CFileWriter::~CFileWriter()
+	{
+		DoDiscard();
+	}
+
+	void CFileWriter::Write( char const * p_data, size_t p_size )
+	{
+		if ( m_fd < 0 )
+		{
+			PARSER_EXCEPT( EShaderParserExceptionCodes_InternalError, PARSER_FORMAT( ERROR_WRITER_COMMITTED, m_path ) );
+		}
+
+		if ( m_used + p_size <= m_buffer.size() )
+		{
+			std::memcpy( m_buffer.data() + m_used, p_data, p_size );
+			m_used += p_size;
+			return;
+		}
+
+		DoWrite( m_buffer.data(), m_used );
+		m_used = 0;
+
+		if ( p_size >= m_buffer.size() )
+		{
+			//!@remarks The large blocks are not copied in the buffer.
+			DoWrite( p_data, p_size );
+		}
+		else
+		{
+			std::memcpy( m_buffer.data(), p_data, p_size );
+			m_used = p_size;
+		}
+	}
+
+	void CFileWriter::Commit()
+	{
+		if ( m_fd < 0 )
+		{
+			PARSER_EXCEPT( EShaderParserExceptionCodes_InternalError, PARSER_FORMAT( ERROR_WRITER_COMMITTED, m_path ) );
+		}
+
+		DoWrite( m_buffer.data(), m_used );
+		m_used = 0;
+
+#if defined( _WIN32 )
+
+		//!@remarks The data must reach the disk before the rename, else a crash could leave an empty destination file.
+		if ( m_sync && _commit( m_fd ) != 0 )
+		{
+			PARSER_EXCEPT( EShaderParserExceptionCodes_SystemError, PARSER_FORMAT( ERROR_WRITER_SYNC, m_tempPath, std::strerror( errno ) ) );
+		}
+
+		//!@remarks The deferred write errors are only reported on close, the truncated file must not replace the destination one.
+		int l_closed = _close( m_fd );
+		m_fd = -1;
+
+		if ( l_closed != 0 )
+		{
+			PARSER_EXCEPT( EShaderParserExceptionCodes_SystemError, PARSER_FORMAT( ERROR_WRITER_CLOSE, m_tempPath, std::strerror( errno ) ) );
+		}
+
+		if ( !MoveFileExA( m_tempPath.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING | ( m_sync ? MOVEFILE_WRITE_THROUGH : 0 ) ) )
+		{
+			PARSER_EXCEPT( EShaderParserExceptionCodes_SystemError, PARSER_FORMAT( ERROR_WRITER_RENAME, m_path, GetLastError() ) );
+		}
+
+#else
+
+		//!@remarks The data must reach the disk before the rename, else a crash could leave an empty destination file.
+		if ( m_sync && fsync( m_fd ) != 0 )
+		{
+			PARSER_EXCEPT( EShaderParserExceptionCodes_SystemError, PARSER_FORMAT( ERROR_WRITER_SYNC, m_tempPath, std::strerror( errno ) ) );
+		}
+
+		//!@remarks The deferred write errors (EIO, ENOSPC, on NFS) are only reported on close, the truncated file must not replace the destination one.
+		int l_closed = close( m_fd );
+		m_fd = -1;
+
+		if ( l_closed != 0 )
+		{
+			PARSER_EXCEPT( EShaderParserExceptionCodes_SystemError, PARSER_FORMAT( ERROR_WRITER_CLOSE, m_tempPath, std::strerror( errno ) ) );
+		}
+
+		if ( rename( m_tempPath.c_str(), m_path.c_str() ) != 0 )
+		{
+			PARSER_EXCEPT( EShaderParserExceptionCodes_SystemError, PARSER_FORMAT( ERROR_WRITER_RENAME, m_path, std::strerror( errno ) ) );
+		}
+
+#endif
+
+		m_tempPath.clear();
+
+		if ( m_batch )
+		{
+			m_batch->DoAddFolder( GetFolder( m_path ) );
+		}
+		else if ( m_sync )
+		{
+			SyncFolder( GetFolder( m_path ) );
+		}
+	}
+
+	void CFileWriter::DoOpen()
+	{
+		static std::atomic< uint32_t > l_counter( 0 );
+		boost::filesystem::path l_path( m_path );
+#if defined( _WIN32 )
+		int l_pid = _getpid();
+#else
+		int l_pid = int( getpid() );
+#endif
+
+		while ( m_fd < 0 )
+		{
+			//!@remarks The temporary file is hidden, and its extension doesn't match the destination one.
+			String l_name = PARSER_FORMAT( ".{}.{}.{}.tmp", l_path.filename().string(), l_pid, l_counter++ );
+			m_tempPath = ( l_path.parent_path() / l_name ).string();
+#if defined( _WIN32 )
+			m_fd = _open( m_tempPath.c_str(), _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY, _S_IREAD | _S_IWRITE );
+#else
+			m_fd = open( m_tempPath.c_str(), O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0666 );
+#endif
+
+			if ( m_fd < 0 && errno != EEXIST )
+			{
+				int l_error = errno;
+				m_tempPath.clear();
+				PARSER_EXCEPT( EShaderParserExceptionCodes_SystemError, PARSER_FORMAT( ERROR_WRITER_OPEN, m_path, std::strerror( l_error ) ) );
+			}
+		}
+
+#if !defined( _WIN32 )
+
+		//!@remarks The temporary file is created with the umask mode, the replaced file keeps its own one.
+		struct stat l_stat;
+
+		if ( stat( m_path.c_str(), &l_stat ) == 0 && fchmod( m_fd, l_stat.st_mode & 07777 ) != 0 )
+		{
+			int l_error = errno;
+			DoDiscard();
+			PARSER_EXCEPT( EShaderParserExceptionCodes_SystemError, PARSER_FORMAT( ERROR_WRITER_MODE, m_path, std::strerror( l_error ) ) );
+		}
+
+#endif
+	}
+
+	void CFileWriter::DoWrite( char const * p_data, size_t p_size )
+	{
+		while ( p_size )
+		{
+#if defined( _WIN32 )
+			int l_written = _write( m_fd, p_data, unsigned( std::min( p_size, size_t( 1 ) << 30 ) ) );
+#else
+			ssize_t l_written = write( m_fd, p_data, p_size );
+#endif
+
+			if ( l_written > 0 )
+			{
+				p_data += l_written;
+				p_size -= size_t( l_written );
+			}
+			else if ( l_written == 0 || errno != EINTR )
+			{
+				PARSER_EXCEPT( EShaderParserExceptionCodes_SystemError, PARSER_FORMAT( ERROR_WRITER_WRITE, m_tempPath, std::strerror( l_written ? errno : ENOSPC ) ) );
+			}
+		}
+	}
+
+	void CFileWriter::DoDiscard()
+	{
+		if ( m_fd >= 0 )
+		{
+#if defined( _WIN32 )
+			_close( m_fd );
+#else
+			close( m_fd );
+#endif
+			m_fd = -1;
+		}
+
+		if ( !m_tempPath.empty() )
+		{
+			std::remove( m_tempPath.c_str() );
+			m_tempPath.clear();
+		}
+	}
+}
+END_NAMESPACE_SHADER_PARSER
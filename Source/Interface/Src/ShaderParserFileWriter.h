@@ -0,0 +1,173 @@
+/************************************************************************//**
+* @file ShaderParserFileWriter.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief CFileWriter and CFileWriteBatch classes declaration.
+*
+* @details Writes files atomically: the content is written in a temporary
+*	file, which replaces the destination file once complete, so the readers
+*	never see a partially written file.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_FILE_WRITER_H___
+#define ___SHADER_PARSER_FILE_WRITER_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include <set>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** Gathers the folders of the files written by many CFileWriter, to synchronise each of them once.
+	@remarks
+		Making a file replacement durable requires synchronising its folder, after the file data.
+		The writers using a batch synchronise their data, and leave the folders synchronisation to the batch.
+		A batch can be shared by writers running on different threads.
+	*/
+	class CFileWriteBatch
+	{
+	public:
+		/** Constructor
+		*/
+		ShaderParserExport CFileWriteBatch();
+
+		/** Destructor, synchronises the remaining folders, the errors are logged.
+		*/
+		ShaderParserExport ~CFileWriteBatch();
+
+		/** Synchronises the folders of the files committed since the last call.
+		@throw EShaderParserExceptionCodes_SystemError
+		*/
+		ShaderParserExport void Sync();
+
+	private:
+		friend class CFileWriter;
+
+		/** Adds the folder of a committed file.
+		@param[in] folder
+			The folder.
+		*/
+		void DoAddFolder( String const & folder );
+
+	private:
+		//! Protects the folders
+		std::mutex m_mutex;
+		//! The folders to synchronise
+		std::set< String > m_folders;
+	};
+
+	/** Writes a file atomically.
+	@remarks
+		The content is buffered, and written to a temporary file, in the destination folder.
+		On commit, the temporary file replaces the destination file, in a single rename,
+		so the other processes see either the previous file, or the complete new one.
+		The replaced file keeps its mode, on the systems having one.
+		A writer destroyed without being committed removes its temporary file, and leaves the destination file untouched.
+	*/
+	class CFileWriter
+	{
+	public:
+		//! The default buffer size
+		static const size_t DEFAULT_BUFFER_SIZE = 1024 * 1024;
+
+	public:
+		/** Constructor, creates the temporary file.
+		@param[in] path
+			The destination file path.
+		@param[in] sync
+			Tells if the file data, then its folder, are synchronised on commit, so the file survives a system crash.
+		@param[in] bufferSize
+			The buffer size, the content is written to the file by chunks of this size.
+		@throw EShaderParserExceptionCodes_SystemError
+		*/
+		ShaderParserExport CFileWriter( String const & path, bool sync = false, size_t bufferSize = DEFAULT_BUFFER_SIZE );
+
+		/** Constructor, creates the temporary file.
+		@remarks
+			The file data is synchronised on commit, its folder when the batch is synchronised.
+		@param[in] path
+			The destination file path.
+		@param[in] batch
+			The batch, it must outlive the writer.
+		@param[in] bufferSize
+			The buffer size, the content is written to the file by chunks of this size.
+		@throw EShaderParserExceptionCodes_SystemError
+		*/
+		ShaderParserExport CFileWriter( String const & path, CFileWriteBatch & batch, size_t bufferSize = DEFAULT_BUFFER_SIZE );
+
+		/** Destructor, removes the temporary file if the writer was not committed.
+		*/
+		ShaderParserExport ~CFileWriter();
+
+		/** Appends data to the file.
+		@param[in] data
+			The data.
+		@param[in] size
+			The data size.
+		@throw EShaderParserExceptionCodes_SystemError
+		*/
+		ShaderParserExport void Write( char const * data, size_t size );
+
+		/** Appends text to the file.
+		@param[in] text
+			The text.
+		@throw EShaderParserExceptionCodes_SystemError
+		*/
+		void Write( String const & text )
+		{
+			Write( text.data(), text.size() );
+		}
+
+		/** Writes the buffered data, and replaces the destination file by the temporary one.
+		@remarks
+			Nothing can be written after the commit.
+		@throw EShaderParserExceptionCodes_SystemError
+		*/
+		ShaderParserExport void Commit();
+
+		/** Retrieves the destination file path
+		@return
+			The path.
+		*/
+		String const & GetPath()const
+		{
+			return m_path;
+		}
+
+	private:
+		/** Creates the temporary file.
+		*/
+		void DoOpen();
+
+		/** Writes data to the temporary file.
+		*/
+		void DoWrite( char const * data, size_t size );
+
+		/** Closes the temporary file, and removes it.
+		*/
+		void DoDiscard();
+
+	private:
+		//! The destination file path
+		String m_path;
+		//! The temporary file path
+		String m_tempPath;
+		//! The temporary file descriptor, negative once closed
+		int m_fd;
+		//! Tells if the file data is synchronised on commit
+		bool m_sync;
+		//! The batch synchronising the folder, if any
+		CFileWriteBatch * m_batch;
+		//! The buffer
+		std::vector< char > m_buffer;
+		//! The buffer used size
+		size_t m_used;
+	};
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif // ___SHADER_PARSER_FILE_WRITER_H___
@@ -0,0 +1,184 @@
+/************************************************************************//**
+* @file ShaderParserFormat.cpp
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief Type safe strings formatting
+*
+***************************************************************************/
+
+#include "ShaderParserPch.h"
+
+#include "ShaderParserFormat.h"
+
+#include "ShaderParserException.h"
+#include "ShaderParserStringUtils.h"
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	namespace StringUtils
+	{
+		namespace
+		{
+			static const String ERROR_DB_FORMAT_INVALID = STR( "Invalid format string, braces must be \"{}\" placeholders or doubled: " );
+			static const String ERROR_DB_FORMAT_ARGUMENTS = STR( "Format string placeholders count doesn't match the arguments count: " );
+
+			/** Formats an unsigned integer
+			@param[in] value
+				The value
+			@param[in] negative
+				Tells if a minus sign is prepended
+			*/
+			void format_unsigned( CFormatBuffer & output, uint64_t value, bool negative )
+			{
+				char l_digits[24];
+				char * l_end = l_digits + sizeof( l_digits );
+				char * l_begin = l_end;
+
+				do
+				{
+					*--l_begin = char( '0' + value % 10 );
+					value /= 10;
+				}
+				while ( value );
+
+				if ( negative )
+				{
+					*--l_begin = '-';
+				}
+
+				output.Append( l_begin, size_t( l_end - l_begin ) );
+			}
+
+			/** Formats an argument
+			*/
+			void format_argument( CFormatBuffer & output, detail::SFormatArgument const & argument )
+			{
+				switch ( argument.m_type )
+				{
+				case detail::SFormatArgument::eSIGNED:
+					//!@remarks The absolute value is computed unsigned, to support the minimal value.
+					format_unsigned( output, argument.m_signed < 0 ? 0 - uint64_t( argument.m_signed ) : uint64_t( argument.m_signed ), argument.m_signed < 0 );
+					break;
+
+				case detail::SFormatArgument::eUNSIGNED:
+					format_unsigned( output, argument.m_unsigned, false );
+					break;
+
+				case detail::SFormatArgument::eDOUBLE:
+				{
+					char l_text[32];
+					int l_size = snprintf( l_text, sizeof( l_text ), "%g", argument.m_double );
+					output.Append( l_text, size_t( std::max( 0, std::min( l_size, int( sizeof( l_text ) - 1 ) ) ) ) );
+				}
+				break;
+
+				case detail::SFormatArgument::eBOOL:
+					output.Append( argument.m_bool ? "true" : "false", argument.m_bool ? 4 : 5 );
+					break;
+
+				case detail::SFormatArgument::eCHAR:
+					output.Append( &argument.m_char, 1 );
+					break;
+
+				case detail::SFormatArgument::eSTRING:
+					output.Append( argument.m_string.m_data, argument.m_string.m_size );
+					break;
+
+				case detail::SFormatArgument::ePOINTER:
+				{
+					static char const * const l_hex = "0123456789abcdef";
+					uintptr_t l_value = reinterpret_cast< uintptr_t >( argument.m_pointer );
+					char l_text[2 + 2 * sizeof( uintptr_t )];
+					char * l_end = l_text + sizeof( l_text );
+					char * l_begin = l_end;
+
+					do
+					{
+						*--l_begin = l_hex[l_value & 0x0F];
+						l_value >>= 4;
+					}
+					while ( l_value );
+
+					*--l_begin = 'x';
+					*--l_begin = '0';
+					output.Append( l_begin, size_t( l_end - l_begin ) );
+				}
+				break;
+
+				case detail::SFormatArgument::eCUSTOM:
+					argument.m_custom( output, argument.m_pointer );
+					break;
+				}
+			}
+		}
+
+		//*************************************************************************************************
+
+		void CFormatBuffer::DoAppend( char const * data, size_t size )
+		{
+			if ( !m_output )
+			{
+				m_heap.reserve( 2 * ( m_size + size ) );
+				m_heap.assign( m_stack, m_size );
+				m_output = &m_heap;
+			}
+
+			m_output->append( data, size );
+		}
+
+		//*************************************************************************************************
+
+		namespace detail
+		{
+			void format_arguments( CFormatBuffer & output, StringView const & format, SFormatArgument const * arguments, size_t count )
+			{
+				if ( format_placeholders( format.data(), format.size() ) != int( count ) )
+				{
+					PARSER_EXCEPT( EShaderParserExceptionCodes_FormatError, ( format_placeholders( format.data(), format.size() ) < 0 ? ERROR_DB_FORMAT_INVALID : ERROR_DB_FORMAT_ARGUMENTS ) + format.str() );
+				}
+
+				char const * l_text = format.data();
+				char const * l_end = l_text + format.size();
+
+				while ( l_text != l_end )
+				{
+					char const * l_brace = l_text;
+
+					while ( l_brace != l_end && *l_brace != '{' && *l_brace != '}' )
+					{
+						++l_brace;
+					}
+
+					output.Append( l_text, size_t( l_brace - l_text ) );
+
+					if ( l_brace == l_end )
+					{
+						break;
+					}
+
+					//!@remarks The format string is valid, so the brace is followed by a brace.
+					if ( l_brace[0] == l_brace[1] )
+					{
+						output.Append( l_brace, 1 );
+					}
+					else
+					{
+						format_argument( output, *arguments++ );
+					}
+
+					l_text = l_brace + 2;
+				}
+			}
+
+			void format_wide( CFormatBuffer & output, void const * value )
+			{
+				std::string l_text = ToStr( static_cast< wchar_t const * >( value ) );
+				output.Append( l_text.data(), l_text.size() );
+			}
+		}
+	}
+}
+END_NAMESPACE_SHADER_PARSER
@@ -0,0 +1,446 @@
+/************************************************************************//**
+* @file ShaderParserFormat.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief Type safe strings formatting
+*
+* @details Formats "{}" placeholders, the PARSER_FORMAT macros check the
+*	format string against the arguments at compile time. The text is built in
+*	a stack buffer, the heap is only used for long texts.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_FORMAT_H___
+#define ___SHADER_PARSER_FORMAT_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include "ShaderParserStringView.h"
+
+#include <type_traits>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	namespace StringUtils
+	{
+		/** Output of the formatting functions.
+		@remarks
+			The text is written in a stack buffer, moved to the heap only when it gets too long,
+			or directly appended to an existing string.
+		*/
+		class CFormatBuffer
+		{
+		public:
+			//! The stack buffer size
+			static const size_t STACK_SIZE = 256;
+
+		public:
+			/** Constructor, the text is written in the stack buffer
+			*/
+			CFormatBuffer()
+				: m_size( 0 )
+				, m_output( NULL )
+			{
+			}
+
+			/** Constructor, the text is appended to a string
+			@param[in,out] output
+				The string
+			*/
+			explicit CFormatBuffer( String & output )
+				: m_size( 0 )
+				, m_output( &output )
+			{
+			}
+
+			/** Appends characters
+			@param[in] data
+				The characters
+			@param[in] size
+				The characters count
+			*/
+			void Append( char const * data, size_t size )
+			{
+				if ( !m_output && m_size + size <= STACK_SIZE )
+				{
+					std::memcpy( m_stack + m_size, data, size );
+					m_size += size;
+				}
+				else
+				{
+					DoAppend( data, size );
+				}
+			}
+
+			/** Retrieves the formatted text
+			@return
+				The text.
+			*/
+			StringView View()const
+			{
+				return m_output ? StringView( *m_output ) : StringView( m_stack, m_size );
+			}
+
+			/** Copies the formatted text in a string
+			@return
+				The string.
+			*/
+			String Str()const
+			{
+				return View().str();
+			}
+
+		private:
+			/** Appends characters to the heap string, moving the stack buffer content there first
+			*/
+			ShaderParserExport void DoAppend( char const * data, size_t size );
+
+		private:
+			//! The stack buffer
+			char m_stack[STACK_SIZE];
+			//! The stack buffer used size
+			size_t m_size;
+			//! The heap string, used when the text doesn't fit in the stack buffer
+			String m_heap;
+			//! The string receiving the text, NULL while the stack buffer is used
+			String * m_output;
+		};
+
+		namespace detail
+		{
+			/** A type erased formatting argument
+			*/
+			struct SFormatArgument
+			{
+				/** The argument types
+				*/
+				typedef enum
+				{
+					eSIGNED,
+					eUNSIGNED,
+					eDOUBLE,
+					eBOOL,
+					eCHAR,
+					eSTRING,
+					ePOINTER,
+					eCUSTOM,
+				}	eTYPE;
+
+				/** Constructor, the value is zero initialised.
+				@param[in] type
+					The argument type
+				*/
+				explicit SFormatArgument( eTYPE type = eCUSTOM )
+					: m_type( type )
+					, m_string{ NULL, 0 }
+					, m_custom( NULL )
+				{
+				}
+
+				//! The argument type
+				eTYPE m_type;
+
+				union
+				{
+					//! eSIGNED value
+					int64_t m_signed;
+					//! eUNSIGNED value
+					uint64_t m_unsigned;
+					//! eDOUBLE value
+					double m_double;
+					//! eBOOL value
+					bool m_bool;
+					//! eCHAR value
+					char m_char;
+					//! eSTRING characters, not null terminated
+					struct
+					{
+						char const * m_data;
+						size_t m_size;
+					} m_string;
+					//! ePOINTER value, and eCUSTOM value
+					void const * m_pointer;
+				};
+
+				//! eCUSTOM formatting function
+				void ( *m_custom )( CFormatBuffer &, void const * );
+			};
+
+			/** Counts the placeholders of a format string, at compile time when possible.
+			@param[in] format
+				The format string
+			@param[in] size
+				The format string length
+			@return
+				The count, -1 if a brace is neither part of a "{}" placeholder nor doubled.
+			*/
+			constexpr int format_placeholders( char const * format, size_t size )
+			{
+				int l_count = 0;
+
+				for ( size_t i = 0; i < size; ++i )
+				{
+					if ( format[i] == '{' || format[i] == '}' )
+					{
+						if ( i + 1 < size && format[i + 1] == format[i] )
+						{
+							++i;
+						}
+						else if ( format[i] == '{' && i + 1 < size && format[i + 1] == '}' )
+						{
+							++i;
+							++l_count;
+						}
+						else
+						{
+							return -1;
+						}
+					}
+				}
+
+				return l_count;
+			}
+
+			template< size_t N >
+			constexpr int format_placeholders( char const( &format )[N] )
+			{
+				return format_placeholders( format, N - 1 );
+			}
+
+			/** Formats the arguments
+			@param[out] output
+				Receives the text
+			@param[in] format
+				The format string
+			@param[in] arguments, count
+				The arguments
+			*/
+			ShaderParserExport void format_arguments( CFormatBuffer & output, StringView const & format, SFormatArgument const * arguments, size_t count );
+
+			/** Formats a value through its output stream operator
+			*/
+			template< typename T >
+			void format_stream( CFormatBuffer & output, void const * value )
+			{
+				std::ostringstream l_stream;
+				l_stream << *static_cast< T const * >( value );
+				std::string l_text = l_stream.str();
+				output.Append( l_text.data(), l_text.size() );
+			}
+
+			template< typename T >
+			typename std::enable_if< std::is_integral< T >::value && std::is_signed< T >::value, SFormatArgument >::type make_argument( T const & value )
+			{
+				SFormatArgument l_result{ SFormatArgument::eSIGNED };
+				l_result.m_signed = value;
+				return l_result;
+			}
+
+			template< typename T >
+			typename std::enable_if< std::is_integral< T >::value && std::is_unsigned< T >::value, SFormatArgument >::type make_argument( T const & value )
+			{
+				SFormatArgument l_result{ SFormatArgument::eUNSIGNED };
+				l_result.m_unsigned = value;
+				return l_result;
+			}
+
+			template< typename T >
+			typename std::enable_if< std::is_floating_point< T >::value, SFormatArgument >::type make_argument( T const & value )
+			{
+				SFormatArgument l_result{ SFormatArgument::eDOUBLE };
+				l_result.m_double = double( value );
+				return l_result;
+			}
+
+			template< typename T >
+			typename std::enable_if< std::is_enum< T >::value, SFormatArgument >::type make_argument( T const & value )
+			{
+				return make_argument( typename std::underlying_type< T >::type( value ) );
+			}
+
+			template< typename T >
+			typename std::enable_if< !std::is_arithmetic< T >::value && !std::is_enum< T >::value, SFormatArgument >::type make_argument( T const & value )
+			{
+				SFormatArgument l_result{ SFormatArgument::eCUSTOM };
+				l_result.m_pointer = &value;
+				l_result.m_custom = &format_stream< T >;
+				return l_result;
+			}
+
+			inline SFormatArgument make_argument( bool value )
+			{
+				SFormatArgument l_result{ SFormatArgument::eBOOL };
+				l_result.m_bool = value;
+				return l_result;
+			}
+
+			inline SFormatArgument make_argument( char value )
+			{
+				SFormatArgument l_result{ SFormatArgument::eCHAR };
+				l_result.m_char = value;
+				return l_result;
+			}
+
+			inline SFormatArgument make_argument( StringView const & value )
+			{
+				SFormatArgument l_result{ SFormatArgument::eSTRING };
+				l_result.m_string.m_data = value.data();
+				l_result.m_string.m_size = value.size();
+				return l_result;
+			}
+
+			inline SFormatArgument make_argument( std::string const & value )
+			{
+				return make_argument( StringView( value ) );
+			}
+
+			inline SFormatArgument make_argument( char const * value )
+			{
+				return make_argument( value ? StringView( value ) : StringView( "(null)", 6 ) );
+			}
+
+			inline SFormatArgument make_argument( char * value )
+			{
+				return make_argument( static_cast< char const * >( value ) );
+			}
+
+			/** Formats a wide string, converted to UTF-8
+			*/
+			ShaderParserExport void format_wide( CFormatBuffer & output, void const * value );
+
+			inline SFormatArgument make_argument( std::wstring const & value )
+			{
+				SFormatArgument l_result{ SFormatArgument::eCUSTOM };
+				l_result.m_pointer = value.c_str();
+				l_result.m_custom = &format_wide;
+				return l_result;
+			}
+
+			inline SFormatArgument make_argument( wchar_t const * value )
+			{
+				SFormatArgument l_result{ SFormatArgument::eCUSTOM };
+				l_result.m_pointer = value ? value : L"(null)";
+				l_result.m_custom = &format_wide;
+				return l_result;
+			}
+
+			inline SFormatArgument make_argument( wchar_t * value )
+			{
+				return make_argument( static_cast< wchar_t const * >( value ) );
+			}
+
+			template< typename T >
+			SFormatArgument make_argument( T * value )
+			{
+				SFormatArgument l_result{ SFormatArgument::ePOINTER };
+				l_result.m_pointer = value;
+				return l_result;
+			}
+
+			/** Formats the arguments, their count is checked at runtime
+			*/
+			template< typename ... Args >
+			void format_to( CFormatBuffer & output, StringView const & format, Args const & ... args )
+			{
+				SFormatArgument const l_arguments[] = { make_argument( args )..., SFormatArgument() };
+				format_arguments( output, format, l_arguments, sizeof...( Args ) );
+			}
+
+			/** Checks the placeholders count of a format string, at compile time
+			*/
+			template< int Count, typename ... Args >
+			void check_format()
+			{
+				static_assert( Count >= 0, "Invalid format string: braces must be \"{}\" placeholders, or doubled" );
+				static_assert( Count < 0 || size_t( Count ) == sizeof...( Args ), "The format string placeholders count doesn't match the arguments count" );
+			}
+
+			template< int Count, size_t N, typename ... Args >
+			String checked_format( char const( &format )[N], Args const & ... args )
+			{
+				check_format< Count, Args... >();
+				CFormatBuffer l_buffer;
+				format_to( l_buffer, StringView( format, N - 1 ), args... );
+				return l_buffer.Str();
+			}
+
+			template< int Count, size_t N, typename ... Args >
+			String & checked_format_to( String & output, char const( &format )[N], Args const & ... args )
+			{
+				check_format< Count, Args... >();
+				CFormatBuffer l_buffer( output );
+				format_to( l_buffer, StringView( format, N - 1 ), args... );
+				return output;
+			}
+		}
+
+		/** Formats a string, replacing each "{}" placeholder by the next argument.
+		@remarks
+			"{{" and "}}" give literal braces.
+			Prefer the PARSER_FORMAT macro, which checks the format string at compile time.
+			The arithmetic types, the strings, the characters and the pointers are formatted without allocation,
+			the wide strings are converted to UTF-8, the other types are formatted through their output stream operator.
+		@param[in] format
+			The format string
+		@param[in] args
+			The arguments
+		@return
+			The formatted string.
+		@throws CShaderParserException
+			EShaderParserExceptionCodes_FormatError if the format string is invalid, or if its placeholders count doesn't match the arguments count.
+		*/
+		template< typename ... Args >
+		String FormatString( StringView const & format, Args const & ... args )
+		{
+			CFormatBuffer l_buffer;
+			detail::format_to( l_buffer, format, args... );
+			return l_buffer.Str();
+		}
+
+		/** Formats a string, replacing each "{}" placeholder by the next argument, and appends it to another one.
+		@remarks
+			Prefer the PARSER_FORMAT_TO macro, which checks the format string at compile time.
+		@param[in,out] output
+			Receives the formatted string, appended to the existing content
+		@param[in] format
+			The format string
+		@param[in] args
+			The arguments
+		@return
+			A reference on the output string.
+		@throws CShaderParserException
+			EShaderParserExceptionCodes_FormatError if the format string is invalid, or if its placeholders count doesn't match the arguments count.
+		*/
+		template< typename ... Args >
+		String & FormatTo( String & output, StringView const & format, Args const & ... args )
+		{
+			CFormatBuffer l_buffer( output );
+			detail::format_to( l_buffer, format, args... );
+			return output;
+		}
+	}
+}
+END_NAMESPACE_SHADER_PARSER
+
+//!@remarks Expands its argument, so MSVC splits a forwarded __VA_ARGS__ into several macro arguments.
+#define PARSER_FORMAT_EXPAND( x ) x
+#define PARSER_FORMAT_FIRST_I( first, ... ) first
+//! The first argument of a non empty arguments list
+#define PARSER_FORMAT_FIRST( ... ) PARSER_FORMAT_EXPAND( PARSER_FORMAT_FIRST_I( __VA_ARGS__, ~ ) )
+
+/** Formats a string, replacing each "{}" placeholder by the next argument.
+	The first argument is the format, it must be a string literal or a constexpr characters array, it is checked against the other arguments at compile time.
+*/
+#define PARSER_FORMAT( ... )\
+	NAMESPACE_SHADER_PARSER::StringUtils::detail::checked_format< NAMESPACE_SHADER_PARSER::StringUtils::detail::format_placeholders( PARSER_FORMAT_FIRST( __VA_ARGS__ ) ) >( __VA_ARGS__ )
+
+/** Formats a string, replacing each "{}" placeholder by the next argument, and appends it to an existing string.
+	The second argument is the format, it must be a string literal or a constexpr characters array, it is checked against the other arguments at compile time.
+*/
+#define PARSER_FORMAT_TO( output, ... )\
+	NAMESPACE_SHADER_PARSER::StringUtils::detail::checked_format_to< NAMESPACE_SHADER_PARSER::StringUtils::detail::format_placeholders( PARSER_FORMAT_FIRST( __VA_ARGS__ ) ) >( output, __VA_ARGS__ )
+
+#endif //___SHADER_PARSER_FORMAT_H___
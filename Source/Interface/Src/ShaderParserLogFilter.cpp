@@ -0,0 +1,289 @@
+/************************************************************************//**
+* @file ShaderParserLogFilter.cpp
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+* @brief CLogFilter class
+*
+* @details Repeated messages suppression and per level rate limiting,
+*	applied by the logging thread before the messages are written.
+*
+***************************************************************************/
+
+#include "ShaderParserPch.h"
+
+#include "ShaderParserLogFilter.h"
+
+#include "ShaderParserFormat.h"
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	namespace
+	{
+		//! The maximum number of tracked repeats series, the messages are not suppressed beyond
+		static const size_t MAX_REPEATS = 4096;
+
+		//! The rate limit report period
+		static const std::chrono::seconds REPORT_PERIOD( 1 );
+	}
+
+	CLogFilter::CLogFilter()
+		: m_window( 0 )
+		, m_reported{ 0 }
+		, m_used( 0 )
+	{
+		for ( int i = 0; i < ELogType_COUNT; i++ )
+		{
+			m_limits[i] = 0;
+			m_repeated[i] = 0;
+			m_rateLimited[i] = 0;
+			m_buckets[i].m_tokens = 0;
+		}
+	}
+
+	CLogFilter::~CLogFilter()
+	{
+	}
+
+	void CLogFilter::SetRepeatWindow( std::chrono::milliseconds const & window )
+	{
+		m_window = window.count();
+	}
+
+	void CLogFilter::SetRateLimit( ELogType logLevel, uint32_t limit )
+	{
+		m_limits[logLevel] = limit;
+	}
+
+	uint64_t CLogFilter::GetRepeatedCount( ELogType logLevel )const
+	{
+		return m_repeated[logLevel];
+	}
+
+	uint64_t CLogFilter::GetRateLimitedCount( ELogType logLevel )const
+	{
+		return m_rateLimited[logLevel];
+	}
+
+	bool CLogFilter::IsEnabled()const
+	{
+		bool l_result = m_window > 0;
+
+		for ( int i = 0; i < ELogType_COUNT && !l_result; i++ )
+		{
+			l_result = m_limits[i] > 0;
+		}
+
+		return l_result;
+	}
+
+	bool CLogFilter::HasPendingSummaries()const
+	{
+		bool l_result = !m_repeats.empty();
+
+		for ( int i = 0; i < ELogType_COUNT && !l_result; i++ )
+		{
+			l_result = m_rateLimited[i] != m_reported[i];
+		}
+
+		return l_result;
+	}
+
+	std::chrono::milliseconds CLogFilter::GetSummaryDelay()const
+	{
+		std::chrono::milliseconds l_result = REPORT_PERIOD;
+
+		if ( !m_repeats.empty() && m_window > 0 )
+		{
+			l_result = std::min( l_result, std::chrono::milliseconds( m_window ) );
+		}
+
+		return l_result;
+	}
+
+	void CLogFilter::Filter( MessageQueue const & messages, MessageQueue & output )
+	{
+		std::chrono::milliseconds l_window( m_window );
+
+		for ( auto && l_message : messages )
+		{
+			if ( l_window.count() > 0 )
+			{
+				DoMakeKey( *l_message );
+				auto && l_it = m_repeats.find( m_key );
+
+				if ( l_it != m_repeats.end() )
+				{
+					SRepeat & l_repeat = l_it->second;
+
+					if ( l_message->m_time - l_repeat.m_start < l_window )
+					{
+						if ( !l_repeat.m_count )
+						{
+							l_repeat.m_text = l_message->GetMessage();
+						}
+
+						++l_repeat.m_count;
+						++m_repeated[l_message->m_type];
+						continue;
+					}
+
+					//!@remarks The series is ended by this message, which starts a new one.
+					if ( l_repeat.m_count )
+					{
+						output.push_back( DoGetRepeatSummary( l_repeat, l_message->m_time ) );
+					}
+
+					l_repeat.m_start = l_message->m_time;
+					l_repeat.m_count = 0;
+				}
+				else if ( m_repeats.size() < MAX_REPEATS )
+				{
+					m_repeats.insert( std::make_pair( m_key, SRepeat{ l_message->m_time, 0, l_message->m_type, String() } ) );
+				}
+			}
+
+			if ( DoConsumeToken( *l_message ) )
+			{
+				output.push_back( l_message );
+			}
+		}
+	}
+
+	void CLogFilter::Summarise( std::chrono::steady_clock::time_point const & now, bool force, MessageQueue & output )
+	{
+		std::chrono::milliseconds l_window( m_window );
+
+		if ( !m_repeats.empty() && ( force || now - m_lastSweep >= std::min( l_window, std::chrono::milliseconds( REPORT_PERIOD ) ) ) )
+		{
+			m_lastSweep = now;
+			auto && l_it = m_repeats.begin();
+
+			while ( l_it != m_repeats.end() )
+			{
+				SRepeat & l_repeat = l_it->second;
+				bool l_ended = now - l_repeat.m_start >= l_window;
+
+				if ( l_repeat.m_count && ( l_ended || force ) )
+				{
+					output.push_back( DoGetRepeatSummary( l_repeat, now ) );
+					l_repeat.m_count = 0;
+				}
+
+				if ( l_ended )
+				{
+					l_it = m_repeats.erase( l_it );
+				}
+				else
+				{
+					++l_it;
+				}
+			}
+		}
+
+		if ( force || now - m_lastReport >= REPORT_PERIOD )
+		{
+			String l_text( "Logger rate limit reached, dropped messages since last report:" );
+			bool l_dropped = false;
+			static char const * const l_names[ELogType_COUNT] = { "debug", "info", "warning", "error" };
+
+			for ( int i = 0; i < ELogType_COUNT; i++ )
+			{
+				uint64_t l_count = m_rateLimited[i];
+
+				if ( l_count != m_reported[i] )
+				{
+					PARSER_FORMAT_TO( l_text, " {} {}", l_count - m_reported[i], l_names[i] );
+					m_reported[i] = l_count;
+					l_dropped = true;
+				}
+			}
+
+			if ( l_dropped )
+			{
+				m_lastReport = now;
+				output.push_back( DoGetSummary( ELogType_WARNING, now, l_text ) );
+			}
+		}
+	}
+
+	void CLogFilter::Recycle()
+	{
+		m_used = 0;
+	}
+
+	void CLogFilter::DoMakeKey( SMessage const & message )
+	{
+		m_key.clear();
+		m_key.push_back( char( message.m_type ) );
+
+		if ( message.m_format )
+		{
+			//!@remarks The deferred formats are string literals, so their address identifies them.
+			m_key.push_back( 'F' );
+			m_key.append( reinterpret_cast< char const * >( &message.m_format ), sizeof( message.m_format ) );
+			m_key.append( message.m_arguments );
+		}
+		else if ( message.m_wide )
+		{
+			m_key.push_back( 'W' );
+			m_key.append( reinterpret_cast< char const * >( message.m_wmessage.data() ), message.m_wmessage.size() * sizeof( wchar_t ) );
+		}
+		else
+		{
+			m_key.push_back( 'N' );
+			m_key.append( message.m_message );
+		}
+	}
+
+	bool CLogFilter::DoConsumeToken( SMessage const & message )
+	{
+		uint32_t l_limit = m_limits[message.m_type];
+
+		if ( !l_limit )
+		{
+			return true;
+		}
+
+		SBucket & l_bucket = m_buckets[message.m_type];
+		double l_elapsed = std::chrono::duration< double >( message.m_time - l_bucket.m_last ).count();
+
+		if ( l_elapsed > 0 )
+		{
+			l_bucket.m_tokens = std::min( double( l_limit ), l_bucket.m_tokens + l_elapsed * l_limit );
+			l_bucket.m_last = message.m_time;
+		}
+
+		if ( l_bucket.m_tokens < 1 )
+		{
+			++m_rateLimited[message.m_type];
+			return false;
+		}
+
+		l_bucket.m_tokens -= 1;
+		return true;
+	}
+
+	SMessage * CLogFilter::DoGetSummary( ELogType type, std::chrono::steady_clock::time_point const & time, String const & text )
+	{
+		if ( m_used == m_summaries.size() )
+		{
+			m_summaries.emplace_back();
+		}
+
+		SMessage & l_summary = m_summaries[m_used++];
+		l_summary.m_type = type;
+		l_summary.m_time = time;
+		l_summary.m_wide = false;
+		l_summary.m_format = NULL;
+		l_summary.m_message = text;
+		return &l_summary;
+	}
+
+	SMessage * CLogFilter::DoGetRepeatSummary( SRepeat const & repeat, std::chrono::steady_clock::time_point const & time )
+	{
+		return DoGetSummary( repeat.m_type, time, PARSER_FORMAT( "Message repeated {} times: {}", repeat.m_count, repeat.m_text ) );
+	}
+}
+END_NAMESPACE_SHADER_PARSER
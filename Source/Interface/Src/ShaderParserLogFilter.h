@@ -0,0 +1,206 @@
+/************************************************************************//**
+* @file ShaderParserLogFilter.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+* @brief CLogFilter class
+*
+* @details Repeated messages suppression and per level rate limiting,
+*	applied by the logging thread before the messages are written.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_LOG_FILTER_H___
+#define ___SHADER_PARSER_LOG_FILTER_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include "ELogType.h"
+#include "ShaderParserMessageQueue.h"
+
+#include <unordered_map>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** Filters the messages processed by the logging thread.
+	@remarks
+		A message identical to one logged less than a window ago (same level, same text, or same format and arguments)
+		is suppressed, and the repeats are collapsed into a "repeated N times" message, when the window ends.
+		The messages exceeding the rate limit of their level are dropped, and reported at most once per second.
+		The configuration can be changed from any thread, the other functions must be called from the logging thread.
+	*/
+	class CLogFilter
+	{
+	public:
+		/** Constructor, nothing is filtered
+		*/
+		CLogFilter();
+
+		/** Destructor
+		*/
+		~CLogFilter();
+
+		/** Sets the repeated messages suppression window.
+		@param[in] window
+			The window, 0 to disable the suppression
+		*/
+		void SetRepeatWindow( std::chrono::milliseconds const & window );
+
+		/** Sets the rate limit of a log level.
+		@param[in] logLevel
+			The log level
+		@param[in] limit
+			The maximum number of messages per second, bursts of this size are allowed, 0 for no limit
+		*/
+		void SetRateLimit( ELogType logLevel, uint32_t limit );
+
+		/** Retrieves the number of suppressed repeated messages.
+		@param[in] logLevel
+			The log level
+		@return
+			The count, since the filter creation.
+		*/
+		uint64_t GetRepeatedCount( ELogType logLevel )const;
+
+		/** Retrieves the number of messages dropped by the rate limit.
+		@param[in] logLevel
+			The log level
+		@return
+			The count, since the filter creation.
+		*/
+		uint64_t GetRateLimitedCount( ELogType logLevel )const;
+
+		/** Tells if the filter may remove messages.
+		@return
+			\p true if the repeats suppression or a rate limit is enabled.
+		*/
+		bool IsEnabled()const;
+
+		/** Tells if summary messages are waiting to be emitted by Summarise.
+		@return
+			\p true if repeats or dropped messages are not yet reported.
+		*/
+		bool HasPendingSummaries()const;
+
+		/** Retrieves the maximal delay before the pending summaries must be emitted.
+		@return
+			The delay, at most one second.
+		*/
+		std::chrono::milliseconds GetSummaryDelay()const;
+
+		/** Filters processed messages.
+		@remarks
+			The messages are compared using their unformatted content, the deferred ones are only formatted once per repeats series.
+		@param[in] messages
+			The messages, in their logging order
+		@param[out] output
+			Receives the kept messages, and the summaries of the repeats series ended by a new occurrence
+		*/
+		void Filter( MessageQueue const & messages, MessageQueue & output );
+
+		/** Emits the summaries of the ended repeats series, and the rate limit report.
+		@param[in] now
+			The current time
+		@param[in] force
+			Tells if the summaries of the current repeats series and the rate limit report are emitted too
+		@param[out] output
+			Receives the summaries
+		*/
+		void Summarise( std::chrono::steady_clock::time_point const & now, bool force, MessageQueue & output );
+
+		/** Allows the summary messages given by Filter and Summarise to be reused, once they are logged.
+		*/
+		void Recycle();
+
+	private:
+		/** A repeated messages series.
+		*/
+		struct SRepeat
+		{
+			//! The time of the first message of the series
+			std::chrono::steady_clock::time_point m_start;
+			//! The number of suppressed messages
+			uint64_t m_count;
+			//! The message level
+			ELogType m_type;
+			//! The message text, formatted at the first repeat
+			String m_text;
+		};
+
+		/** A log level rate limit token bucket.
+		*/
+		struct SBucket
+		{
+			//! The available tokens
+			double m_tokens;
+			//! The time of the last refill
+			std::chrono::steady_clock::time_point m_last;
+		};
+
+		/** Builds the suppression key of a message, in m_key
+		@param[in] message
+			The message
+		*/
+		void DoMakeKey( SMessage const & message );
+
+		/** Consumes a token from the rate limit bucket of the message level
+		@param[in] message
+			The message
+		@return
+			\p false if the message exceeds the rate limit.
+		*/
+		bool DoConsumeToken( SMessage const & message );
+
+		/** Creates a summary message
+		@param[in] type
+			The message level
+		@param[in] time
+			The message time
+		@param[in] text
+			The message text
+		@return
+			The message, valid until Recycle is called.
+		*/
+		SMessage * DoGetSummary( ELogType type, std::chrono::steady_clock::time_point const & time, String const & text );
+
+		/** Creates the summary message of a repeats series
+		@param[in] repeat
+			The series
+		@param[in] time
+			The message time
+		@return
+			The message, valid until Recycle is called.
+		*/
+		SMessage * DoGetRepeatSummary( SRepeat const & repeat, std::chrono::steady_clock::time_point const & time );
+
+	private:
+		//! The repeats suppression window, in milliseconds
+		std::atomic< int64_t > m_window;
+		//! The rate limits, per level
+		std::atomic< uint32_t > m_limits[ELogType_COUNT];
+		//! The suppressed repeats count, per level
+		std::atomic< uint64_t > m_repeated[ELogType_COUNT];
+		//! The rate limited messages count, per level
+		std::atomic< uint64_t > m_rateLimited[ELogType_COUNT];
+		//! The rate limited messages count already reported, per level
+		uint64_t m_reported[ELogType_COUNT];
+		//! The rate limit buckets, per level
+		SBucket m_buckets[ELogType_COUNT];
+		//! The time of the last rate limit report
+		std::chrono::steady_clock::time_point m_lastReport;
+		//! The time of the last ended series lookup
+		std::chrono::steady_clock::time_point m_lastSweep;
+		//! The current repeats series, by message key
+		std::unordered_map< std::string, SRepeat > m_repeats;
+		//! The key of the message being filtered
+		std::string m_key;
+		//! The summary messages
+		std::deque< SMessage > m_summaries;
+		//! The summary messages in use
+		size_t m_used;
+	};
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif
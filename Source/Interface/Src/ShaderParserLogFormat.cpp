@@ -0,0 +1,737 @@
+/************************************************************************//**
+* @file ShaderParserLogFormat.cpp
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief Deferred formatting of log messages, and binary log files
+*
+***************************************************************************/
+
+#include "ShaderParserPch.h"
+
+#include "ShaderParserLogFormat.h"
+
+#include <limits>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	namespace LogFormat
+	{
+		namespace
+		{
+			//! Tag of a captured signed integer, stored as int64_t
+			static const char ARGUMENT_SIGNED = 'i';
+			//! Tag of a captured unsigned integer, stored as uint64_t
+			static const char ARGUMENT_UNSIGNED = 'u';
+			//! Tag of a captured double
+			static const char ARGUMENT_DOUBLE = 'd';
+			//! Tag of a captured long double
+			static const char ARGUMENT_LONG_DOUBLE = 'D';
+			//! Tag of a captured string, stored as its uint32_t length, its characters and a terminating 0
+			static const char ARGUMENT_STRING = 's';
+			//! Tag of a captured wide string, stored as its uint32_t length, its characters and a terminating 0
+			static const char ARGUMENT_WSTRING = 'S';
+			//! Tag of a captured pointer, stored as uint64_t
+			static const char ARGUMENT_POINTER = 'p';
+
+			//! The binary log file magic
+			static const char BINARY_MAGIC[] = { 'S', 'P', 'L', 'O', 'G' };
+			//! The binary log file version
+			static const uint8_t BINARY_VERSION = 2;
+			//! Written in the header, to check the file endianness
+			static const uint32_t BINARY_BYTE_ORDER = 0x01020304;
+			//! Binary record defining a format
+			static const uint8_t BINARY_RECORD_FORMAT = 0;
+			//! Binary record holding a message
+			static const uint8_t BINARY_RECORD_MESSAGE = 1;
+
+			/** A printf conversion specification
+			*/
+			struct SConversion
+			{
+				//! The beginning of the specification, the '%' character
+				char const * m_begin;
+				//! The beginning of the length modifier
+				char const * m_length;
+				//! The conversion character
+				char m_type;
+				//! The number of '*' in the specification
+				uint32_t m_stars;
+				//! Tells if the precision is given by the last '*' argument
+				bool m_starPrecision;
+				//! The precision given in the specification, -1 if none
+				int64_t m_precision;
+			};
+
+			/** Parses a conversion specification.
+			@param[in,out] format
+				The format, positioned after the '%' character, receives the position after the specification.
+			@param[out] conversion
+				Receives the specification.
+			@return
+				\p false if the format ends before the conversion character.
+			*/
+			bool ParseConversion( char const *& format, SConversion & conversion )
+			{
+				conversion.m_begin = format - 1;
+				conversion.m_stars = 0;
+				conversion.m_starPrecision = false;
+				conversion.m_precision = -1;
+
+				while ( *format && strchr( "-+ #0'", *format ) )
+				{
+					++format;
+				}
+
+				if ( *format == '*' )
+				{
+					++conversion.m_stars;
+					++format;
+				}
+
+				while ( isdigit( uint8_t( *format ) ) )
+				{
+					++format;
+				}
+
+				if ( *format == '.' )
+				{
+					++format;
+					conversion.m_precision = 0;
+
+					if ( *format == '*' )
+					{
+						++conversion.m_stars;
+						conversion.m_starPrecision = true;
+						++format;
+					}
+
+					while ( isdigit( uint8_t( *format ) ) )
+					{
+						conversion.m_precision = std::min< int64_t >( conversion.m_precision * 10 + ( *format - '0' ), std::numeric_limits< uint32_t >::max() );
+						++format;
+					}
+				}
+
+				conversion.m_length = format;
+
+				while ( *format && strchr( "hlLqjzt", *format ) )
+				{
+					++format;
+				}
+
+				conversion.m_type = *format;
+
+				if ( !conversion.m_type )
+				{
+					return false;
+				}
+
+				++format;
+				return true;
+			}
+
+			/** Retrieves the length modifier of a conversion specification, limited to two characters.
+			*/
+			std::string GetLength( SConversion const & conversion )
+			{
+				char const * end = conversion.m_length;
+
+				while ( *end && end - conversion.m_length < 2 && strchr( "hlLqjzt", *end ) )
+				{
+					++end;
+				}
+
+				return std::string( conversion.m_length, end );
+			}
+
+			template< typename T >
+			void Write( std::string & buffer, T const & value )
+			{
+				buffer.append( reinterpret_cast< char const * >( &value ), sizeof( T ) );
+			}
+
+			template< typename T >
+			void WriteArgument( std::string & buffer, char tag, T const & value )
+			{
+				buffer.push_back( tag );
+				Write( buffer, value );
+			}
+
+			/** Captures a string argument.
+			@remarks
+				Like printf, no more than \p precision characters are read, so the string needs not be null terminated when a precision is given.
+			*/
+			template< typename CharType >
+			void WriteString( std::string & buffer, char tag, CharType const * value, CharType const * null, int64_t precision )
+			{
+				if ( !value )
+				{
+					value = null;
+				}
+
+				uint32_t maxLength = precision < 0 ? std::numeric_limits< uint32_t >::max() : uint32_t( precision );
+				uint32_t length = 0;
+
+				while ( length < maxLength && value[length] )
+				{
+					++length;
+				}
+
+				WriteArgument( buffer, tag, length );
+				buffer.append( reinterpret_cast< char const * >( value ), length * sizeof( CharType ) );
+				Write( buffer, CharType( 0 ) );
+			}
+
+			template< typename T >
+			bool Read( char const *& data, char const * end, T & value )
+			{
+				if ( size_t( end - data ) < sizeof( T ) )
+				{
+					return false;
+				}
+
+				memcpy( &value, data, sizeof( T ) );
+				data += sizeof( T );
+				return true;
+			}
+
+			template< typename T >
+			bool ReadArgument( char const *& data, char const * end, char tag, T & value )
+			{
+				return data != end && *data == tag && Read( ++data, end, value );
+			}
+
+			template< typename CharType >
+			bool ReadString( char const *& data, char const * end, char tag, CharType const *& value )
+			{
+				uint32_t length = 0;
+
+				if ( !ReadArgument( data, end, tag, length ) || size_t( end - data ) < ( length + 1 ) * sizeof( CharType ) )
+				{
+					return false;
+				}
+
+				value = reinterpret_cast< CharType const * >( data );
+				data += ( length + 1 ) * sizeof( CharType );
+				return true;
+			}
+
+			template< typename T >
+			void Print( std::string & output, std::string const & spec, T value )
+			{
+				int size = snprintf( NULL, 0, spec.c_str(), value );
+
+				if ( size > 0 )
+				{
+					size_t offset = output.size();
+					output.resize( offset + size + 1 );
+					snprintf( &output[offset], size + 1, spec.c_str(), value );
+					output.resize( offset + size );
+				}
+			}
+
+			template< typename T >
+			bool ReadFile( FILE * file, T & value )
+			{
+				return fread( &value, sizeof( T ), 1, file ) == 1;
+			}
+
+			bool ReadFile( FILE * file, std::string & value, uint32_t size )
+			{
+				value.resize( size );
+				return !size || fread( &value[0], 1, size, file ) == size;
+			}
+		}
+
+		CTimestampFormatter::CTimestampFormatter()
+			: m_second( std::numeric_limits< int64_t >::min() )
+		{
+		}
+
+		void CTimestampFormatter::Format( std::string & output, int64_t time )
+		{
+			int64_t second = time / 1000000;
+			int64_t microseconds = time % 1000000;
+
+			if ( microseconds < 0 )
+			{
+				--second;
+				microseconds += 1000000;
+			}
+
+			if ( second != m_second )
+			{
+				time_t l_time = time_t( second );
+				std::tm l_tm = *localtime( &l_time );
+				char l_buffer[33] = { 0 };
+				strftime( l_buffer, 32, "%Y-%m-%d %H:%M:%S", &l_tm );
+				m_prefix = l_buffer;
+				m_second = second;
+			}
+
+			output.append( m_prefix );
+			char digits[8] = { '.' };
+
+			for ( int i = 6; i > 0; --i )
+			{
+				digits[i] = char( '0' + microseconds % 10 );
+				microseconds /= 10;
+			}
+
+			output.append( digits, 7 );
+		}
+
+		int64_t GetSteadyToSystemOffset()
+		{
+			int64_t system = std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::system_clock::now().time_since_epoch() ).count();
+			int64_t steady = std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+			return system - steady;
+		}
+
+		void Capture( std::string & arguments, char const * format, va_list args )
+		{
+			arguments.clear();
+			char const * it = format;
+
+			while ( *it )
+			{
+				if ( *it++ != '%' )
+				{
+					continue;
+				}
+
+				if ( *it == '%' )
+				{
+					++it;
+					continue;
+				}
+
+				SConversion conversion;
+
+				if ( !ParseConversion( it, conversion ) )
+				{
+					return;
+				}
+
+				for ( uint32_t i = 0; i < conversion.m_stars; ++i )
+				{
+					int64_t star = va_arg( args, int );
+					WriteArgument( arguments, ARGUMENT_SIGNED, star );
+
+					if ( conversion.m_starPrecision && i + 1 == conversion.m_stars )
+					{
+						//!@remarks A negative precision is taken as if it was omitted.
+						conversion.m_precision = star < 0 ? -1 : star;
+					}
+				}
+
+				std::string length = GetLength( conversion );
+
+				switch ( conversion.m_type )
+				{
+				case 'd':
+				case 'i':
+					if ( length == "hh" )
+					{
+						WriteArgument( arguments, ARGUMENT_SIGNED, int64_t( static_cast< signed char >( va_arg( args, int ) ) ) );
+					}
+					else if ( length == "h" )
+					{
+						WriteArgument( arguments, ARGUMENT_SIGNED, int64_t( static_cast< short >( va_arg( args, int ) ) ) );
+					}
+					else if ( length == "l" )
+					{
+						WriteArgument( arguments, ARGUMENT_SIGNED, int64_t( va_arg( args, long ) ) );
+					}
+					else if ( length == "ll" || length == "q" )
+					{
+						WriteArgument( arguments, ARGUMENT_SIGNED, int64_t( va_arg( args, long long ) ) );
+					}
+					else if ( length == "j" )
+					{
+						WriteArgument( arguments, ARGUMENT_SIGNED, int64_t( va_arg( args, intmax_t ) ) );
+					}
+					else if ( length == "z" || length == "t" )
+					{
+						WriteArgument( arguments, ARGUMENT_SIGNED, int64_t( va_arg( args, ptrdiff_t ) ) );
+					}
+					else
+					{
+						WriteArgument( arguments, ARGUMENT_SIGNED, int64_t( va_arg( args, int ) ) );
+					}
+					break;
+
+				case 'o':
+				case 'u':
+				case 'x':
+				case 'X':
+					if ( length == "hh" )
+					{
+						WriteArgument( arguments, ARGUMENT_UNSIGNED, uint64_t( static_cast< unsigned char >( va_arg( args, unsigned int ) ) ) );
+					}
+					else if ( length == "h" )
+					{
+						WriteArgument( arguments, ARGUMENT_UNSIGNED, uint64_t( static_cast< unsigned short >( va_arg( args, unsigned int ) ) ) );
+					}
+					else if ( length == "l" )
+					{
+						WriteArgument( arguments, ARGUMENT_UNSIGNED, uint64_t( va_arg( args, unsigned long ) ) );
+					}
+					else if ( length == "ll" || length == "q" )
+					{
+						WriteArgument( arguments, ARGUMENT_UNSIGNED, uint64_t( va_arg( args, unsigned long long ) ) );
+					}
+					else if ( length == "j" )
+					{
+						WriteArgument( arguments, ARGUMENT_UNSIGNED, uint64_t( va_arg( args, uintmax_t ) ) );
+					}
+					else if ( length == "z" || length == "t" )
+					{
+						WriteArgument( arguments, ARGUMENT_UNSIGNED, uint64_t( va_arg( args, size_t ) ) );
+					}
+					else
+					{
+						WriteArgument( arguments, ARGUMENT_UNSIGNED, uint64_t( va_arg( args, unsigned int ) ) );
+					}
+					break;
+
+				case 'c':
+					if ( length == "l" )
+					{
+						WriteArgument( arguments, ARGUMENT_UNSIGNED, uint64_t( va_arg( args, wint_t ) ) );
+					}
+					else
+					{
+						WriteArgument( arguments, ARGUMENT_SIGNED, int64_t( va_arg( args, int ) ) );
+					}
+					break;
+
+				case 'f':
+				case 'F':
+				case 'e':
+				case 'E':
+				case 'g':
+				case 'G':
+				case 'a':
+				case 'A':
+					if ( length == "L" )
+					{
+						WriteArgument( arguments, ARGUMENT_LONG_DOUBLE, va_arg( args, long double ) );
+					}
+					else
+					{
+						WriteArgument( arguments, ARGUMENT_DOUBLE, va_arg( args, double ) );
+					}
+					break;
+
+				case 's':
+					if ( length == "l" )
+					{
+						WriteString( arguments, ARGUMENT_WSTRING, va_arg( args, wchar_t const * ), L"(null)", conversion.m_precision );
+					}
+					else
+					{
+						WriteString( arguments, ARGUMENT_STRING, va_arg( args, char const * ), "(null)", conversion.m_precision );
+					}
+					break;
+
+				case 'p':
+				case 'n':
+					WriteArgument( arguments, ARGUMENT_POINTER, uint64_t( uintptr_t( va_arg( args, void * ) ) ) );
+					break;
+
+				default:
+					return;
+				}
+			}
+		}
+
+		void Format( std::string & output, char const * format, std::string const & arguments )
+		{
+			char const * data = arguments.data();
+			char const * end = data + arguments.size();
+			char const * it = format;
+			std::string spec;
+			bool valid = true;
+
+			while ( *it && valid )
+			{
+				char const * text = it;
+
+				while ( *it && *it != '%' )
+				{
+					++it;
+				}
+
+				output.append( text, it );
+
+				if ( !*it )
+				{
+					continue;
+				}
+
+				if ( *++it == '%' )
+				{
+					output.push_back( '%' );
+					++it;
+					continue;
+				}
+
+				SConversion conversion;
+				valid = ParseConversion( it, conversion );
+				spec.clear();
+
+				for ( char const * c = conversion.m_begin; valid && c != conversion.m_length; ++c )
+				{
+					int64_t star = 0;
+
+					if ( *c != '*' )
+					{
+						spec.push_back( *c );
+					}
+					else if ( ( valid = ReadArgument( data, end, ARGUMENT_SIGNED, star ) ) )
+					{
+						if ( star < 0 && spec.back() == '.' )
+						{
+							//!@remarks A negative precision is taken as if it was omitted.
+							spec.pop_back();
+						}
+						else
+						{
+							spec += std::to_string( star );
+						}
+					}
+				}
+
+				if ( !valid )
+				{
+					continue;
+				}
+
+				std::string length = GetLength( conversion );
+
+				switch ( conversion.m_type )
+				{
+				case 'd':
+				case 'i':
+					{
+						int64_t value = 0;
+						valid = ReadArgument( data, end, ARGUMENT_SIGNED, value );
+						spec += "ll";
+						spec.push_back( conversion.m_type );
+						Print( output, spec, static_cast< long long >( value ) );
+					}
+					break;
+
+				case 'o':
+				case 'u':
+				case 'x':
+				case 'X':
+					{
+						uint64_t value = 0;
+						valid = ReadArgument( data, end, ARGUMENT_UNSIGNED, value );
+						spec += "ll";
+						spec.push_back( conversion.m_type );
+						Print( output, spec, static_cast< unsigned long long >( value ) );
+					}
+					break;
+
+				case 'c':
+					if ( length == "l" )
+					{
+						uint64_t value = 0;
+						valid = ReadArgument( data, end, ARGUMENT_UNSIGNED, value );
+						spec += "lc";
+						Print( output, spec, wint_t( value ) );
+					}
+					else
+					{
+						int64_t value = 0;
+						valid = ReadArgument( data, end, ARGUMENT_SIGNED, value );
+						spec += "c";
+						Print( output, spec, int( value ) );
+					}
+					break;
+
+				case 'f':
+				case 'F':
+				case 'e':
+				case 'E':
+				case 'g':
+				case 'G':
+				case 'a':
+				case 'A':
+					if ( length == "L" )
+					{
+						long double value = 0;
+						valid = ReadArgument( data, end, ARGUMENT_LONG_DOUBLE, value );
+						spec += "L";
+						spec.push_back( conversion.m_type );
+						Print( output, spec, value );
+					}
+					else
+					{
+						double value = 0;
+						valid = ReadArgument( data, end, ARGUMENT_DOUBLE, value );
+						spec.push_back( conversion.m_type );
+						Print( output, spec, value );
+					}
+					break;
+
+				case 's':
+					if ( length == "l" )
+					{
+						wchar_t const * value = NULL;
+						valid = ReadString( data, end, ARGUMENT_WSTRING, value );
+						spec += "ls";
+
+						if ( valid )
+						{
+							Print( output, spec, value );
+						}
+					}
+					else
+					{
+						char const * value = NULL;
+						valid = ReadString( data, end, ARGUMENT_STRING, value );
+						spec += "s";
+
+						if ( valid )
+						{
+							Print( output, spec, value );
+						}
+					}
+					break;
+
+				case 'p':
+				case 'n':
+					{
+						uint64_t value = 0;
+						valid = ReadArgument( data, end, ARGUMENT_POINTER, value );
+
+						if ( conversion.m_type == 'p' )
+						{
+							spec += "p";
+							Print( output, spec, reinterpret_cast< void * >( uintptr_t( value ) ) );
+						}
+					}
+					break;
+
+				default:
+					valid = false;
+					break;
+				}
+			}
+		}
+
+		void WriteBinaryHeader( std::string & buffer )
+		{
+			buffer.append( BINARY_MAGIC, sizeof( BINARY_MAGIC ) );
+			Write( buffer, BINARY_VERSION );
+			Write( buffer, uint8_t( sizeof( wchar_t ) ) );
+			Write( buffer, uint8_t( sizeof( long double ) ) );
+			Write( buffer, BINARY_BYTE_ORDER );
+		}
+
+		void WriteBinaryFormat( std::string & buffer, uint32_t id, char const * format )
+		{
+			uint32_t length = uint32_t( strlen( format ) );
+			Write( buffer, BINARY_RECORD_FORMAT );
+			Write( buffer, id );
+			Write( buffer, length );
+			buffer.append( format, length );
+		}
+
+		void WriteBinaryMessage( std::string & buffer, ELogType type, int64_t time, uint32_t id, std::string const & data )
+		{
+			Write( buffer, BINARY_RECORD_MESSAGE );
+			Write( buffer, uint8_t( type ) );
+			Write( buffer, time );
+			Write( buffer, id );
+			Write( buffer, uint32_t( data.size() ) );
+			buffer.append( data );
+		}
+
+		bool DecodeBinary( FILE * file, std::function< void( ELogType, int64_t, std::string const & ) > const & onMessage )
+		{
+			char magic[sizeof( BINARY_MAGIC )];
+			uint8_t version = 0;
+			uint8_t wcharSize = 0;
+			uint8_t longDoubleSize = 0;
+			uint32_t byteOrder = 0;
+
+			if ( fread( magic, 1, sizeof( magic ), file ) != sizeof( magic )
+					|| memcmp( magic, BINARY_MAGIC, sizeof( magic ) )
+					|| !ReadFile( file, version ) || version != BINARY_VERSION
+					|| !ReadFile( file, wcharSize ) || wcharSize != sizeof( wchar_t )
+					|| !ReadFile( file, longDoubleSize ) || longDoubleSize != sizeof( long double )
+					|| !ReadFile( file, byteOrder ) || byteOrder != BINARY_BYTE_ORDER )
+			{
+				return false;
+			}
+
+			std::map< uint32_t, std::string > formats;
+			std::string data;
+			std::string message;
+			uint8_t record = 0;
+
+			while ( ReadFile( file, record ) )
+			{
+				if ( record == BINARY_RECORD_FORMAT )
+				{
+					uint32_t id = 0;
+					uint32_t length = 0;
+
+					if ( !ReadFile( file, id ) || !ReadFile( file, length ) || !ReadFile( file, formats[id], length ) )
+					{
+						return false;
+					}
+				}
+				else if ( record == BINARY_RECORD_MESSAGE )
+				{
+					uint8_t type = 0;
+					int64_t time = 0;
+					uint32_t id = 0;
+					uint32_t length = 0;
+
+					if ( !ReadFile( file, type ) || type >= ELogType_COUNT
+							|| !ReadFile( file, time )
+							|| !ReadFile( file, id )
+							|| !ReadFile( file, length )
+							|| !ReadFile( file, data, length ) )
+					{
+						return false;
+					}
+
+					if ( id )
+					{
+						auto && it = formats.find( id );
+
+						if ( it == formats.end() )
+						{
+							return false;
+						}
+
+						message.clear();
+						Format( message, it->second.c_str(), data );
+						onMessage( ELogType( type ), time, message );
+					}
+					else
+					{
+						onMessage( ELogType( type ), time, data );
+					}
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			return feof( file ) != 0;
+		}
+	}
+}
+END_NAMESPACE_SHADER_PARSER
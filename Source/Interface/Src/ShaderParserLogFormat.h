@@ -0,0 +1,140 @@
+/************************************************************************//**
+* @file ShaderParserLogFormat.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief Deferred formatting of log messages, and binary log files
+*
+* @details The arguments of a printf-like log call are captured in a compact
+*	buffer, to be formatted later on the logging thread, or offline, from a
+*	binary log file.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_LOG_FORMAT_H___
+#define ___SHADER_PARSER_LOG_FORMAT_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include "ELogType.h"
+
+#include <chrono>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	namespace LogFormat
+	{
+		/** Formats log timestamps, with a microseconds precision.
+		@remarks
+			The date and time part is only recomputed when the second changes.
+		*/
+		class CTimestampFormatter
+		{
+		public:
+			/** Constructor
+			*/
+			ShaderParserExport CTimestampFormatter();
+
+			/** Formats a timestamp, as YYYY-mm-dd HH:MM:SS.uuuuuu, in local time.
+			@param[out] output
+				Receives the timestamp, appended to the existing content.
+			@param[in] time
+				The time, in microseconds since the system clock epoch
+			*/
+			ShaderParserExport void Format( std::string & output, int64_t time );
+
+		private:
+			//! The second of the cached prefix
+			int64_t m_second;
+			//! The date and time part of the timestamps of m_second
+			std::string m_prefix;
+		};
+
+		/** Retrieves the offset to add to a steady clock time to get the system clock time.
+		@return
+			The offset, in microseconds.
+		*/
+		ShaderParserExport int64_t GetSteadyToSystemOffset();
+
+		/** Converts a steady clock time to microseconds since the system clock epoch.
+		@param[in] time
+			The steady clock time
+		@param[in] offset
+			The offset given by GetSteadyToSystemOffset
+		@return
+			The system time, in microseconds.
+		*/
+		inline int64_t ToSystemTime( std::chrono::steady_clock::time_point const & time, int64_t offset )
+		{
+			return std::chrono::duration_cast< std::chrono::microseconds >( time.time_since_epoch() ).count() + offset;
+		}
+
+		/** Captures the arguments of a printf-like call.
+		@remarks
+			Only the values are copied, strings included, the format string itself is not parsed further.
+			Capture stops at the first unsupported conversion.
+		@param[out] arguments
+			Receives the captured arguments, cleared first.
+		@param[in] format
+			The printf format
+		@param[in] args
+			The arguments
+		*/
+		ShaderParserExport void Capture( std::string & arguments, char const * format, va_list args );
+
+		/** Formats captured arguments.
+		@param[out] output
+			Receives the formatted text, appended to the existing content.
+		@param[in] format
+			The printf format
+		@param[in] arguments
+			The arguments captured by Capture for this format
+		*/
+		ShaderParserExport void Format( std::string & output, char const * format, std::string const & arguments );
+
+		/** Writes a binary log file header.
+		@param[out] buffer
+			Receives the header.
+		*/
+		ShaderParserExport void WriteBinaryHeader( std::string & buffer );
+
+		/** Writes a binary log format record, defining a format identifier for the following message records.
+		@param[out] buffer
+			Receives the record.
+		@param[in] id
+			The format identifier, not 0
+		@param[in] format
+			The printf format
+		*/
+		ShaderParserExport void WriteBinaryFormat( std::string & buffer, uint32_t id, char const * format );
+
+		/** Writes a binary log message record.
+		@param[out] buffer
+			Receives the record.
+		@param[in] type
+			The message type
+		@param[in] time
+			The message time, in microseconds since the system clock epoch
+		@param[in] id
+			The format identifier, 0 if the message is already formatted
+		@param[in] data
+			The captured arguments, or the message text if id is 0
+		*/
+		ShaderParserExport void WriteBinaryMessage( std::string & buffer, ELogType type, int64_t time, uint32_t id, std::string const & data );
+
+		/** Decodes a binary log file.
+		@param[in] file
+			The file, opened in binary read mode
+		@param[in] onMessage
+			Called for each decoded message, with its time in microseconds since the system clock epoch
+		@return
+			\p false if the file is not a binary log file written on this platform, or if it is truncated.
+		*/
+		ShaderParserExport bool DecodeBinary( FILE * file, std::function< void( ELogType, int64_t, std::string const & ) > const & onMessage );
+	}
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif //___SHADER_PARSER_LOG_FORMAT_H___
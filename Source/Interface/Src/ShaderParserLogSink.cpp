@@ -0,0 +1,243 @@
+/************************************************************************//**
+* @file ShaderParserLogSink.cpp
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief ILogSink interface, and its file, console, memory and callback implementations
+*
+* @details The log sinks receive the messages processed by the logging thread, by batches
+*
+***************************************************************************/
+
+#include "ShaderParserPch.h"
+
+#include "ShaderParserLogSink.h"
+
+#include "ShaderParserException.h"
+#include "ShaderParserFileUtils.h"
+#include "ShaderParserLogger.h"
+#include "ShaderParserLoggerConsole.h"
+#include "ShaderParserStringUtils.h"
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	namespace
+	{
+		//! The size of the file sink buffer, the buffered lines are written when it is reached
+		static const size_t LOG_SINK_BUFFER_SIZE = 64 * 1024;
+	}
+
+	//*************************************************************************************************
+
+	CFileLogSink::CFileLogSink( String const & path )
+		: m_file( NULL )
+	{
+		FileUtils::FOpen( m_file, path.c_str(), "w" );
+
+		if ( !m_file )
+		{
+			PARSER_EXCEPT( EShaderParserExceptionCodes_ItemNotFound, STR( "Couldn't open the log sink file: " ) + path );
+		}
+
+		setvbuf( m_file, NULL, _IONBF, 0 );
+		m_buffer.reserve( LOG_SINK_BUFFER_SIZE );
+	}
+
+	CFileLogSink::~CFileLogSink()
+	{
+		Flush();
+		fclose( m_file );
+	}
+
+	void CFileLogSink::Log( LogRecordArray const & records )
+	{
+		for ( auto && l_record : records )
+		{
+			size_t l_start = m_buffer.size();
+			m_timestampFormatter.Format( m_buffer, l_record.m_time );
+			m_buffer.append( STR( " - " ) );
+			m_buffer.append( CLogger::GetHeader( l_record.m_type ) );
+			std::string l_prefix = m_buffer.substr( l_start );
+			m_buffer.resize( l_start );
+
+			for ( auto && l_line : StringUtils::SplitView( l_record.m_text, STR( '\n' ) ) )
+			{
+				m_buffer.append( l_prefix );
+				m_buffer.append( l_line.data(), l_line.size() );
+				m_buffer.push_back( '\n' );
+			}
+
+			if ( m_buffer.size() >= LOG_SINK_BUFFER_SIZE )
+			{
+				Flush();
+			}
+		}
+	}
+
+	void CFileLogSink::Flush()
+	{
+		if ( !m_buffer.empty() )
+		{
+			fwrite( m_buffer.data(), 1, m_buffer.size(), m_file );
+			m_buffer.clear();
+		}
+	}
+
+	//*************************************************************************************************
+
+	CConsoleLogSink::CConsoleLogSink()
+		: m_console( std::make_unique< CDefaultConsole >() )
+	{
+	}
+
+	CConsoleLogSink::~CConsoleLogSink()
+	{
+	}
+
+	void CConsoleLogSink::Log( LogRecordArray const & records )
+	{
+		for ( auto && l_record : records )
+		{
+			for ( auto && l_line : StringUtils::SplitView( l_record.m_text, STR( '\n' ) ) )
+			{
+				m_console->BeginLog( l_record.m_type );
+				m_console->Print( l_line.str(), true );
+			}
+		}
+	}
+
+	//*************************************************************************************************
+
+	CMemoryLogSink::CMemoryLogSink( size_t capacity )
+		: m_capacity( capacity )
+	{
+	}
+
+	CMemoryLogSink::~CMemoryLogSink()
+	{
+	}
+
+	void CMemoryLogSink::Log( LogRecordArray const & records )
+	{
+		std::unique_lock< std::mutex > l_lock( m_mutex );
+		auto l_begin = records.begin();
+
+		if ( records.size() > m_capacity )
+		{
+			l_begin = records.end() - m_capacity;
+		}
+
+		m_records.insert( m_records.end(), l_begin, records.end() );
+
+		while ( m_records.size() > m_capacity )
+		{
+			m_records.pop_front();
+		}
+	}
+
+	LogRecordArray CMemoryLogSink::GetRecords()const
+	{
+		std::unique_lock< std::mutex > l_lock( m_mutex );
+		return LogRecordArray( m_records.begin(), m_records.end() );
+	}
+
+	void CMemoryLogSink::Clear()
+	{
+		std::unique_lock< std::mutex > l_lock( m_mutex );
+		m_records.clear();
+	}
+
+	//*************************************************************************************************
+
+	CCallbackLogSink::CCallbackLogSink( Callback const & callback )
+		: m_callback( callback )
+	{
+	}
+
+	CCallbackLogSink::~CCallbackLogSink()
+	{
+	}
+
+	void CCallbackLogSink::Log( LogRecordArray const & records )
+	{
+		m_callback( records );
+	}
+
+	//*************************************************************************************************
+
+	CThreadedLogSink::CThreadedLogSink( LogSinkSPtr sink )
+		: m_sink( sink )
+		, m_stopped( false )
+		, m_flushRequests( 0 )
+		, m_flushesDone( 0 )
+	{
+		m_thread = std::thread( [this]()
+		{
+			std::unique_lock< std::mutex > l_lock( m_mutex );
+
+			while ( true )
+			{
+				if ( !m_pending.empty() )
+				{
+					//!@remarks The pending messages are swapped, so the logging thread can go on while the sink logs them.
+					std::swap( m_pending, m_logging );
+					l_lock.unlock();
+					m_sink->Log( m_logging );
+					m_logging.clear();
+					l_lock.lock();
+				}
+				else if ( m_flushesDone < m_flushRequests )
+				{
+					//!@remarks The sink is flushed from this thread, so it is never used from two threads at once.
+					uint64_t l_request = m_flushRequests;
+					l_lock.unlock();
+					m_sink->Flush();
+					l_lock.lock();
+					m_flushesDone = l_request;
+					m_flushed.notify_all();
+				}
+				else if ( m_stopped )
+				{
+					break;
+				}
+				else
+				{
+					m_wakeup.wait( l_lock );
+				}
+			}
+		} );
+	}
+
+	CThreadedLogSink::~CThreadedLogSink()
+	{
+		{
+			std::unique_lock< std::mutex > l_lock( m_mutex );
+			m_stopped = true;
+			m_wakeup.notify_one();
+		}
+
+		m_thread.join();
+		m_sink->Flush();
+	}
+
+	void CThreadedLogSink::Log( LogRecordArray const & records )
+	{
+		std::unique_lock< std::mutex > l_lock( m_mutex );
+		m_pending.insert( m_pending.end(), records.begin(), records.end() );
+		m_wakeup.notify_one();
+	}
+
+	void CThreadedLogSink::Flush()
+	{
+		std::unique_lock< std::mutex > l_lock( m_mutex );
+		uint64_t l_request = ++m_flushRequests;
+		m_wakeup.notify_one();
+		m_flushed.wait( l_lock, [this, l_request]()
+		{
+			return m_flushesDone >= l_request;
+		} );
+	}
+}
+END_NAMESPACE_SHADER_PARSER
@@ -0,0 +1,250 @@
+/************************************************************************//**
+* @file ShaderParserLogSink.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+* @brief ILogSink interface, and its file, console, memory and callback implementations
+*
+* @details The log sinks receive the messages processed by the logging thread, by batches
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_LOG_SINK_H___
+#define ___SHADER_PARSER_LOG_SINK_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include "ELogType.h"
+#include "ShaderParserLogFormat.h"
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** A message, as given to the log sinks.
+	*/
+	struct SLogRecord
+	{
+		//! The message type
+		ELogType m_type;
+		//! The time the message was logged, in microseconds since the system clock epoch
+		int64_t m_time;
+		//! The message text
+		String m_text;
+	};
+
+	/** Log sink interface, receives the messages processed by the logging thread.
+	*/
+	class ILogSink
+	{
+	public:
+		/** Constructor
+		*/
+		ILogSink()
+		{
+		}
+
+		/** Destructor
+		*/
+		virtual ~ILogSink()
+		{
+		}
+
+		/** Logs a batch of messages.
+		@remarks
+			Called from the logging thread, or from the sink own thread if it was registered so.
+		@param[in] records
+			The messages
+		*/
+		virtual void Log( LogRecordArray const & records ) = 0;
+
+		/** Writes the pending messages, if the sink buffers them.
+		*/
+		virtual void Flush()
+		{
+		}
+	};
+
+	/** Log sink writing the messages in a text file, one line per message line.
+	*/
+	class CFileLogSink
+		: public ILogSink
+	{
+	public:
+		/** Constructor, truncates the file
+		@param[in] path
+			The file path
+		*/
+		ShaderParserExport CFileLogSink( String const & path );
+
+		/** Destructor
+		*/
+		ShaderParserExport ~CFileLogSink();
+
+		/** @copydoc ILogSink::Log
+		*/
+		ShaderParserExport virtual void Log( LogRecordArray const & records );
+
+		/** @copydoc ILogSink::Flush
+		*/
+		ShaderParserExport virtual void Flush();
+
+	private:
+		//! The file
+		FILE * m_file;
+		//! The lines waiting to be written
+		std::string m_buffer;
+		//! The timestamps formatter
+		LogFormat::CTimestampFormatter m_timestampFormatter;
+	};
+
+	/** Log sink printing the messages in the console.
+	*/
+	class CConsoleLogSink
+		: public ILogSink
+	{
+	public:
+		/** Constructor
+		*/
+		ShaderParserExport CConsoleLogSink();
+
+		/** Destructor
+		*/
+		ShaderParserExport ~CConsoleLogSink();
+
+		/** @copydoc ILogSink::Log
+		*/
+		ShaderParserExport virtual void Log( LogRecordArray const & records );
+
+	private:
+		//! The console
+		std::unique_ptr< CProgramConsole > m_console;
+	};
+
+	/** Log sink keeping the last messages in memory.
+	*/
+	class CMemoryLogSink
+		: public ILogSink
+	{
+	public:
+		/** Constructor
+		@param[in] capacity
+			The maximum number of kept messages, the oldest ones are removed first
+		*/
+		ShaderParserExport CMemoryLogSink( size_t capacity );
+
+		/** Destructor
+		*/
+		ShaderParserExport ~CMemoryLogSink();
+
+		/** @copydoc ILogSink::Log
+		*/
+		ShaderParserExport virtual void Log( LogRecordArray const & records );
+
+		/** Retrieves the kept messages, from the oldest one.
+		@return
+			A copy of the messages.
+		*/
+		ShaderParserExport LogRecordArray GetRecords()const;
+
+		/** Removes the kept messages.
+		*/
+		ShaderParserExport void Clear();
+
+	private:
+		//! The maximum number of kept messages
+		size_t m_capacity;
+		//! The kept messages
+		std::deque< SLogRecord > m_records;
+		//! The mutex protecting the messages
+		mutable std::mutex m_mutex;
+	};
+
+	/** Log sink giving the messages to a user function.
+	*/
+	class CCallbackLogSink
+		: public ILogSink
+	{
+	public:
+		//! The function type
+		using Callback = std::function< void( LogRecordArray const & ) >;
+
+		/** Constructor
+		@param[in] callback
+			The function receiving the messages
+		*/
+		ShaderParserExport CCallbackLogSink( Callback const & callback );
+
+		/** Destructor
+		*/
+		ShaderParserExport ~CCallbackLogSink();
+
+		/** @copydoc ILogSink::Log
+		*/
+		ShaderParserExport virtual void Log( LogRecordArray const & records );
+
+	private:
+		//! The function receiving the messages
+		Callback m_callback;
+	};
+
+	/** Log sink forwarding the messages to another sink, from its own thread.
+	@remarks
+		Used when a sink is registered with its own thread, so a slow sink doesn't stall the logging thread and the other sinks.
+	*/
+	class CThreadedLogSink
+		: public ILogSink
+	{
+	public:
+		/** Constructor, starts the thread
+		@param[in] sink
+			The sink receiving the messages
+		*/
+		ShaderParserExport CThreadedLogSink( LogSinkSPtr sink );
+
+		/** Destructor, logs the pending messages and stops the thread
+		*/
+		ShaderParserExport ~CThreadedLogSink();
+
+		/** @copydoc ILogSink::Log
+		*/
+		ShaderParserExport virtual void Log( LogRecordArray const & records );
+
+		/** Waits until the pending messages are logged by the sink, then flushes it.
+		*/
+		ShaderParserExport virtual void Flush();
+
+		/** Retrieves the sink receiving the messages.
+		@return
+			The sink.
+		*/
+		LogSinkSPtr GetSink()const
+		{
+			return m_sink;
+		}
+
+	private:
+		//! The sink receiving the messages
+		LogSinkSPtr m_sink;
+		//! The pending messages
+		LogRecordArray m_pending;
+		//! The messages being logged by the sink
+		LogRecordArray m_logging;
+		//! Tells if the thread must be stopped
+		bool m_stopped;
+		//! The number of flushes requested
+		uint64_t m_flushRequests;
+		//! The number of flushes done
+		uint64_t m_flushesDone;
+		//! The mutex protecting the pending messages and the flushes counters
+		std::mutex m_mutex;
+		//! Event raised when messages are pending, when a flush is requested, or when the thread must stop
+		std::condition_variable m_wakeup;
+		//! Event raised when a flush is done
+		std::condition_variable m_flushed;
+		//! The thread
+		std::thread m_thread;
+	};
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif
@@ -16,6 +16,10 @@
 #include "ShaderParserLogger.h"
 
 #include "ShaderParserLoggerImpl.h"
+#include "ShaderParserLogFilter.h"
+#include "ShaderParserLogFormat.h"
+#include "ShaderParserMessageQueue.h"
+#include "ShaderParserFormat.h"
 #include "ShaderParserStringUtils.h"
 #include "ShaderParserException.h"
 
@@ -109,14 +113,88 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		}
 	};
 
+	namespace
+	{
+		//! The generations counter
+		std::atomic< uint32_t > g_generations( 0 );
+		//! The generation of the current logger, 0 if none
+		std::atomic< uint32_t > g_liveGeneration( 0 );
+
+		/** The message cache of the current thread, released when the thread ends.
+		*/
+		struct SThreadMessageCache
+		{
+			~SThreadMessageCache()
+			{
+				if ( m_cache && g_liveGeneration == m_generation )
+				{
+					m_cache->m_inUse = false;
+				}
+			}
+
+			//! The generation of the logger owning the cache
+			uint32_t m_generation = 0;
+			//! The cache
+			SMessageCache * m_cache = NULL;
+		};
+
+		thread_local SThreadMessageCache g_threadCache;
+
+		/** Formats a printf-like message, without length limit.
+		@remarks
+			The text is written in the output's existing storage, which is only grown if the text doesn't fit.
+		*/
+		void FormatArguments( std::string & output, char const * format, va_list args )
+		{
+			va_list l_args;
+			va_copy( l_args, args );
+			output.resize( output.capacity() );
+			int l_size = vsnprintf( &output[0], output.size() + 1, format, l_args );
+			va_end( l_args );
+
+			if ( l_size < 0 )
+			{
+				output.clear();
+			}
+			else if ( size_t( l_size ) > output.size() )
+			{
+				output.resize( l_size );
+				vsnprintf( &output[0], output.size() + 1, format, args );
+			}
+			else
+			{
+				output.resize( l_size );
+			}
+		}
+	}
+
 	CLogger * CLogger::_singleton = NULL;
 	bool CLogger::_ownInstance = true;
 	uint32_t CLogger::_counter = 0;
 
 	CLogger::CLogger()
 		: _impl( NULL )
+		, _deferred( false )
+		, _generation( ++g_generations )
+		, _queue( std::make_unique< CMessageQueue >() )
+		, _overflow( EBackpressure_BLOCK )
+		, _reported{ 0 }
+		, _report( std::make_unique< SMessage >() )
+		, _filter( std::make_unique< CLogFilter >() )
+		, _stopped( true )
+		, _pending( false )
+		, _blocked( 0 )
+		, _flushRequests( 0 )
+		, _flushesDone( 0 )
 	{
 		std::unique_lock< std::mutex > lock( _mutex );
+
+		for ( auto & l_dropped : _dropped )
+		{
+			l_dropped = 0;
+		}
+
+		g_liveGeneration = _generation;
 		_headers[ELogType_DEBUG] = STR( "***DEBUG*** " );
 		_headers[ELogType_INFO] = STR( "" );
 		_headers[ELogType_WARNING] = STR( "***WARNING*** " );
@@ -139,6 +217,7 @@ BEGIN_NAMESPACE_SHADER_PARSER
 
 	CLogger::~CLogger()
 	{
+		g_liveGeneration = 0;
 		delete _cout;
 		delete _cerr;
 		delete _clog;
@@ -220,6 +299,95 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		}
 	}
 
+	void CLogger::SetQueueCapacity( size_t capacity, EBackpressure overflow )
+	{
+		CLogger & l_logger = GetSingleton();
+		bool l_running = l_logger._logThread.joinable();
+		l_logger.DoCleanupThread();
+
+		if ( capacity )
+		{
+			l_logger._ring = std::make_unique< CMessageRing >( capacity );
+		}
+		else
+		{
+			l_logger._ring.reset();
+		}
+
+		l_logger._overflow = overflow;
+
+		if ( l_running )
+		{
+			l_logger.DoInitialiseThread();
+		}
+	}
+
+	uint64_t CLogger::GetDroppedCount( ELogType logLevel )
+	{
+		return GetSingleton()._dropped[logLevel];
+	}
+
+	void CLogger::SetRepeatWindow( std::chrono::milliseconds const & window )
+	{
+		GetSingleton()._filter->SetRepeatWindow( window );
+	}
+
+	void CLogger::SetRateLimit( ELogType logLevel, uint32_t limit )
+	{
+		GetSingleton()._filter->SetRateLimit( logLevel, limit );
+	}
+
+	uint64_t CLogger::GetRepeatedCount( ELogType logLevel )
+	{
+		return GetSingleton()._filter->GetRepeatedCount( logLevel );
+	}
+
+	uint64_t CLogger::GetRateLimitedCount( ELogType logLevel )
+	{
+		return GetSingleton()._filter->GetRateLimitedCount( logLevel );
+	}
+
+	bool CLogger::IsEnabled( ELogType logLevel )
+	{
+		return logLevel >= GetSingleton()._logLevel;
+	}
+
+	void CLogger::SetDeferredFormatting( bool deferred )
+	{
+		GetSingleton()._deferred = deferred;
+	}
+
+	void CLogger::SetBinaryFileName( String const & logFilePath )
+	{
+		if ( GetSingleton()._impl )
+		{
+			std::unique_lock< std::mutex > lock( GetSingleton()._mutex );
+			GetSingleton()._impl->SetBinaryFileName( logFilePath );
+		}
+	}
+
+	void CLogger::AddSink( LogSinkSPtr sink, bool ownThread )
+	{
+		if ( GetSingleton()._impl )
+		{
+			GetSingleton()._impl->AddSink( sink, ownThread );
+		}
+	}
+
+	void CLogger::RemoveSink( LogSinkSPtr sink )
+	{
+		if ( GetSingleton()._impl )
+		{
+			GetSingleton().DoFlush();
+			GetSingleton()._impl->RemoveSink( sink );
+		}
+	}
+
+	String const & CLogger::GetHeader( ELogType logLevel )
+	{
+		return GetSingleton()._headers[logLevel];
+	}
+
 	void CLogger::SetFileName( String const & logFilePath, ELogType logLevel )
 	{
 		if ( GetSingleton()._impl )
@@ -232,13 +400,10 @@ BEGIN_NAMESPACE_SHADER_PARSER
 	{
 		if ( format )
 		{
-			char buffer[256];
 			va_list vaList;
 			va_start( vaList, format );
-			std::string format( format );
-			vsnprintf( buffer, 256, format.c_str(), vaList );
+			GetSingleton().DoPushMessage( ELogType_DEBUG, format, vaList );
 			va_end( vaList );
-			LogDebug( std::string( buffer ) );
 		}
 	}
 
@@ -288,13 +453,10 @@ BEGIN_NAMESPACE_SHADER_PARSER
 	{
 		if ( format )
 		{
-			char buffer[256];
 			va_list vaList;
 			va_start( vaList, format );
-			std::string format( format );
-			vsnprintf( buffer, 256, format.c_str(), vaList );
+			GetSingleton().DoPushMessage( ELogType_INFO, format, vaList );
 			va_end( vaList );
-			LogInfo( std::string( buffer ) );
 		}
 	}
 
@@ -344,13 +506,10 @@ BEGIN_NAMESPACE_SHADER_PARSER
 	{
 		if ( format )
 		{
-			char buffer[256];
 			va_list vaList;
 			va_start( vaList, format );
-			std::string format( format );
-			vsnprintf( buffer, 256, format.c_str(), vaList );
+			GetSingleton().DoPushMessage( ELogType_WARNING, format, vaList );
 			va_end( vaList );
-			LogWarning( std::string( buffer ) );
 		}
 	}
 
@@ -400,13 +559,10 @@ BEGIN_NAMESPACE_SHADER_PARSER
 	{
 		if ( format )
 		{
-			char buffer[256];
 			va_list vaList;
 			va_start( vaList, format );
-			std::string format( format );
-			vsnprintf( buffer, 256, format.c_str(), vaList );
+			GetSingleton().DoPushMessage( ELogType_ERROR, format, vaList );
 			va_end( vaList );
-			LogError( std::string( buffer ) );
 		}
 	}
 
@@ -452,6 +608,16 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		LogError( ss.str() );
 	}
 
+	void CLogger::Flush()
+	{
+		GetSingleton().DoFlush();
+
+		if ( GetSingleton()._impl )
+		{
+			GetSingleton()._impl->FlushSinks();
+		}
+	}
+
 	CLogger & CLogger::GetSingleton()
 	{
 		if ( !_singleton )
@@ -483,8 +649,13 @@ BEGIN_NAMESPACE_SHADER_PARSER
 				_impl->PrintMessage( logLevel, message );
 			}
 #endif
-			std::unique_lock< std::mutex > l_lock( _mutexQueue );
-			_queue.push_back( std::make_unique< SMessage >( logLevel, message ) );
+			SMessage * l_message = DoGetThreadCache().Acquire();
+			l_message->m_type = logLevel;
+			l_message->m_time = std::chrono::steady_clock::now();
+			l_message->m_wide = false;
+			l_message->m_format = NULL;
+			l_message->m_message.assign( message );
+			DoPush( l_message );
 		}
 	}
 
@@ -498,53 +669,400 @@ BEGIN_NAMESPACE_SHADER_PARSER
 				_impl->PrintMessage( logLevel, message );
 			}
 #endif
-			std::unique_lock< std::mutex > l_lock( _mutexQueue );
-			_queue.push_back( std::make_unique< SWMessage >( logLevel, message ) );
+			SMessage * l_message = DoGetThreadCache().Acquire();
+			l_message->m_type = logLevel;
+			l_message->m_time = std::chrono::steady_clock::now();
+			l_message->m_wide = true;
+			l_message->m_format = NULL;
+			l_message->m_wmessage.assign( message );
+			DoPush( l_message );
+		}
+	}
+
+	void CLogger::DoPushMessage( ELogType logLevel, char const * format, va_list args )
+	{
+		if ( logLevel >= _logLevel )
+		{
+			SMessage * l_message = DoGetThreadCache().Acquire();
+			l_message->m_type = logLevel;
+			l_message->m_time = std::chrono::steady_clock::now();
+			l_message->m_wide = false;
+
+			if ( _deferred )
+			{
+#if !defined( NDEBUG )
+				{
+					va_list l_args;
+					va_copy( l_args, args );
+					std::string l_text;
+					FormatArguments( l_text, format, l_args );
+					va_end( l_args );
+					std::unique_lock< std::mutex > lock( _mutex );
+					_impl->PrintMessage( logLevel, l_text );
+				}
+#endif
+				l_message->m_format = format;
+				LogFormat::Capture( l_message->m_arguments, format, args );
+			}
+			else
+			{
+				//!@remarks The text is formatted in the storage of the cached message, so no allocation happens once it is large enough.
+				l_message->m_format = NULL;
+				FormatArguments( l_message->m_message, format, args );
+#if !defined( NDEBUG )
+				{
+					std::unique_lock< std::mutex > lock( _mutex );
+					_impl->PrintMessage( logLevel, l_message->m_message );
+				}
+#endif
+			}
+
+			DoPush( l_message );
+		}
+	}
+
+	SMessageCache & CLogger::DoGetThreadCache()
+	{
+		if ( g_threadCache.m_generation != _generation )
+		{
+			//!@remarks First message from this thread, reuse the cache of an ended thread, or create one.
+			std::unique_lock< std::mutex > lock( _mutexCaches );
+			SMessageCache * l_cache = NULL;
+
+			for ( auto && l_it : _caches )
+			{
+				bool l_inUse = false;
+
+				if ( !l_cache && l_it->m_inUse.compare_exchange_strong( l_inUse, true ) )
+				{
+					l_cache = l_it.get();
+				}
+			}
+
+			if ( !l_cache )
+			{
+				_caches.push_back( std::make_unique< SMessageCache >() );
+				l_cache = _caches.back().get();
+				l_cache->m_inUse = true;
+			}
+
+			g_threadCache.m_cache = l_cache;
+			g_threadCache.m_generation = _generation;
 		}
+
+		return *g_threadCache.m_cache;
 	}
 
-	void CLogger::DoFlushQueue( bool display )
+	void CLogger::DoPush( SMessage * message )
 	{
-		if ( !_queue.empty() )
+		if ( !_ring )
 		{
-			MessageQueue queue;
+			_queue->Push( message );
+			DoSignalMessages();
+		}
+		else if ( _ring->TryPush( message ) )
+		{
+			DoSignalMessages();
+		}
+		else if ( _overflow == EBackpressure_BLOCK )
+		{
+			std::unique_lock< std::mutex > l_lock( _mutexWakeup );
+			bool l_pushed = false;
+			++_blocked;
+
+			while ( !_stopped && !( l_pushed = _ring->TryPush( message ) ) )
+			{
+				_pending = true;
+				_wakeup.notify_one();
+				_spaceAvailable.wait( l_lock );
+			}
 
+			--_blocked;
+
+			if ( l_pushed )
+			{
+				_pending = true;
+				_wakeup.notify_one();
+			}
+			else
+			{
+				//!@remarks No logging thread to make room.
+				++_dropped[message->m_type];
+				message->m_cache->Release( message );
+			}
+		}
+		else if ( _overflow == EBackpressure_DROP_OLDEST )
+		{
+			do
 			{
-				std::unique_lock< std::mutex > l_lock( _mutexQueue );
-				std::swap( queue, _queue );
+				SMessage * l_oldest = _ring->TryPop();
+
+				if ( l_oldest )
+				{
+					++_dropped[l_oldest->m_type];
+					l_oldest->m_cache->Release( l_oldest );
+				}
 			}
+			while ( !_ring->TryPush( message ) );
 
-			_impl->LogMessageQueue( queue, display );
+			DoSignalMessages();
+		}
+		else
+		{
+			++_dropped[message->m_type];
+			message->m_cache->Release( message );
 		}
 	}
 
+	void CLogger::DoSignalMessages()
+	{
+		//!@remarks Only the first message of a burst takes the mutex to wake the logging thread up.
+		if ( !_pending.load( std::memory_order_relaxed ) && !_pending.exchange( true ) )
+		{
+			std::unique_lock< std::mutex > l_lock( _mutexWakeup );
+			_wakeup.notify_one();
+		}
+	}
+
+	void CLogger::DoFlush()
+	{
+		std::unique_lock< std::mutex > l_lock( _mutexWakeup );
+
+		if ( !_stopped )
+		{
+			uint64_t l_request = ++_flushRequests;
+			_wakeup.notify_one();
+			_flushed.wait( l_lock, [this, l_request]()
+			{
+				return _flushesDone >= l_request;
+			} );
+		}
+	}
+
+	void CLogger::DoFlushQueue( bool display, bool complete )
+	{
+		SMessage * l_message = _queue->Pop();
+
+		while ( l_message || ( complete && !_queue->IsEmpty() ) )
+		{
+			if ( l_message )
+			{
+				_processing.push_back( l_message );
+			}
+			else
+			{
+				//!@remarks A producer is linking its message, which may be followed by already pushed ones.
+				std::this_thread::yield();
+			}
+
+			l_message = _queue->Pop();
+		}
+
+		DoProcessMessages( display );
+
+		if ( _ring )
+		{
+			//!@remarks The ring is drained by batches of its capacity, so the processed messages count stays bounded too.
+			size_t l_capacity = _ring->GetCapacity();
+			bool l_full = false;
+
+			do
+			{
+				while ( _processing.size() < l_capacity )
+				{
+					l_message = _ring->TryPop();
+
+					if ( l_message )
+					{
+						_processing.push_back( l_message );
+					}
+					else if ( complete && !_ring->IsEmpty() )
+					{
+						std::this_thread::yield();
+					}
+					else
+					{
+						break;
+					}
+				}
+
+				{
+					std::unique_lock< std::mutex > l_lock( _mutexWakeup );
+
+					if ( _blocked )
+					{
+						_spaceAvailable.notify_all();
+					}
+				}
+
+				l_full = _processing.size() == l_capacity;
+				DoProcessMessages( display );
+			}
+			while ( l_full );
+		}
+	}
+
+	void CLogger::DoProcessMessages( bool display )
+	{
+		if ( !_processing.empty() )
+		{
+			if ( _filter->IsEnabled() )
+			{
+				_filter->Filter( _processing, _filtered );
+
+				if ( !_filtered.empty() )
+				{
+					_impl->LogMessageQueue( _filtered, display );
+					_filtered.clear();
+				}
+
+				_filter->Recycle();
+			}
+			else
+			{
+				_impl->LogMessageQueue( _processing, display );
+			}
+
+			for ( auto && l_processed : _processing )
+			{
+				l_processed->m_cache->Release( l_processed );
+			}
+
+			_processing.clear();
+		}
+	}
+
+	bool CLogger::DoHasUnreportedDrops()const
+	{
+		for ( int i = 0; i < ELogType_COUNT; i++ )
+		{
+			if ( _dropped[i] != _reported[i] )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void CLogger::DoReportDrops( bool display, bool force )
+	{
+		auto l_now = std::chrono::steady_clock::now();
+
+		if ( !force && l_now - _lastReport < std::chrono::seconds( 1 ) )
+		{
+			return;
+		}
+
+		String & l_text = _report->m_message;
+		l_text.assign( "Logger queue full, dropped messages since last report:" );
+		bool l_dropped = false;
+		static char const * const l_names[ELogType_COUNT] = { "debug", "info", "warning", "error" };
+
+		for ( int i = 0; i < ELogType_COUNT; i++ )
+		{
+			uint64_t l_count = _dropped[i];
+
+			if ( l_count != _reported[i] )
+			{
+				PARSER_FORMAT_TO( l_text, " {} {}", l_count - _reported[i], l_names[i] );
+				_reported[i] = l_count;
+				l_dropped = true;
+			}
+		}
+
+		if ( l_dropped )
+		{
+			_lastReport = l_now;
+			_report->m_type = ELogType_WARNING;
+			_report->m_time = l_now;
+			_report->m_wide = false;
+			_report->m_format = NULL;
+			_processing.push_back( _report.get() );
+			_impl->LogMessageQueue( _processing, display );
+			_processing.clear();
+		}
+	}
+
+	void CLogger::DoReportSummaries( bool display, bool force )
+	{
+		_filter->Summarise( std::chrono::steady_clock::now(), force, _filtered );
+
+		if ( !_filtered.empty() )
+		{
+			_impl->LogMessageQueue( _filtered, display );
+			_filtered.clear();
+		}
+
+		_filter->Recycle();
+	}
+
 	void CLogger::DoInitialiseThread()
 	{
 		_stopped = false;
 		_logThread = std::thread( [this]()
 		{
+			std::unique_lock< std::mutex > l_lock( _mutexWakeup );
+
 			while ( !_stopped )
 			{
-				DoFlushQueue( true );
-				std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+				auto l_wakeup = [this]()
+				{
+					return _pending || _stopped || _flushRequests != _flushesDone;
+				};
+
+				if ( DoHasUnreportedDrops() )
+				{
+					//!@remarks The dropped messages are reported at least once per second.
+					_wakeup.wait_for( l_lock, std::chrono::seconds( 1 ), l_wakeup );
+				}
+				else if ( _filter->HasPendingSummaries() )
+				{
+					_wakeup.wait_for( l_lock, _filter->GetSummaryDelay(), l_wakeup );
+				}
+				else
+				{
+					_wakeup.wait( l_lock, l_wakeup );
+				}
+
+				uint64_t l_flushRequests = _flushRequests;
+				l_lock.unlock();
+				//!@remarks Reset before draining, so a message pushed meanwhile signals again.
+				_pending = false;
+				DoFlushQueue( true, l_flushRequests != _flushesDone );
+				DoReportDrops( true, l_flushRequests != _flushesDone );
+				DoReportSummaries( true, l_flushRequests != _flushesDone );
+				l_lock.lock();
+
+				if ( l_flushRequests != _flushesDone )
+				{
+					_flushesDone = l_flushRequests;
+					_flushed.notify_all();
+				}
 			}
 
-			DoFlushQueue( false );
-			{
-				std::unique_lock< std::mutex > l_lock( _mutexThreadEnded );
-				_threadEnded.notify_one();
-			}
+			l_lock.unlock();
+			DoFlushQueue( false, true );
+			DoReportDrops( false, true );
+			DoReportSummaries( false, true );
+			l_lock.lock();
+			_flushesDone = _flushRequests;
+			_flushed.notify_all();
 		} );
 	}
 
 	void CLogger::DoCleanupThread()
 	{
-		_stopped = true;
+		if ( _logThread.joinable() )
 		{
-			std::unique_lock< std::mutex > l_lock( _mutexThreadEnded );
-			_threadEnded.wait( l_lock );
+			{
+				std::unique_lock< std::mutex > l_lock( _mutexWakeup );
+				_stopped = true;
+				_wakeup.notify_one();
+				_spaceAvailable.notify_all();
+			}
+			_logThread.join();
 		}
-		_logThread.join();
 	}
 }
 END_NAMESPACE_SHADER_PARSER
@@ -15,6 +15,7 @@
 
 #include "ShaderParserPrerequisites.h"
 
+#include "EBackpressure.h"
 #include "ELogType.h"
 
 #include <condition_variable>
@@ -66,7 +67,117 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		*/
 		ShaderParserExport static void SetFileName( String const & logFilePath, ELogType logType = ELogType_COUNT );
 
+		/** Bounds the number of messages waiting for the logging thread.
+		@remarks
+			The waiting messages are then held in a fixed capacity ring buffer, instead of an unbounded queue.
+			The dropped messages are counted per level, and reported in a warning line at least once per second.
+			Must not be called while messages are logged from other threads, since the logging thread is restarted.
+		@param[in] capacity
+			The maximum number of waiting messages, rounded up to a power of two, 0 for an unbounded queue
+		@param[in] overflow
+			The behaviour when the ring buffer is full
+		*/
+		ShaderParserExport static void SetQueueCapacity( size_t capacity, EBackpressure overflow = EBackpressure_BLOCK );
+
+		/** Retrieves the number of messages dropped because the ring buffer was full.
+		@param[in] logLevel
+			The messages log level
+		@return
+			The count, since the logger initialisation.
+		*/
+		ShaderParserExport static uint64_t GetDroppedCount( ELogType logLevel );
+
+		/** Collapses the repeated messages.
+		@remarks
+			A message identical to one logged less than window ago is not written, the suppressed repeats are
+			reported in a "Message repeated N times" line, of the same level, once the window has elapsed.
+		@param[in] window
+			The suppression window, 0 to disable the suppression
+		*/
+		ShaderParserExport static void SetRepeatWindow( std::chrono::milliseconds const & window );
+
+		/** Limits the number of messages written per second for a log level.
+		@remarks
+			The messages exceeding the limit are dropped, and reported in a warning line at least once per second.
+		@param[in] logLevel
+			The log level
+		@param[in] limit
+			The maximum number of messages per second, bursts of this size are allowed, 0 for no limit
+		*/
+		ShaderParserExport static void SetRateLimit( ELogType logLevel, uint32_t limit );
+
+		/** Retrieves the number of repeated messages suppressed.
+		@param[in] logLevel
+			The messages log level
+		@return
+			The count, since the logger initialisation.
+		*/
+		ShaderParserExport static uint64_t GetRepeatedCount( ELogType logLevel );
+
+		/** Retrieves the number of messages dropped by the rate limit.
+		@param[in] logLevel
+			The messages log level
+		@return
+			The count, since the logger initialisation.
+		*/
+		ShaderParserExport static uint64_t GetRateLimitedCount( ELogType logLevel );
+
+		/** Tells if the messages of the given level are logged.
+		@remarks
+			Used by the PARSER_LOG_* macros, to avoid building the messages of disabled levels.
+		@param[in] logLevel
+			The log level
+		@return
+			\p true if logLevel is greater than or equal to the current logging level.
+		*/
+		ShaderParserExport static bool IsEnabled( ELogType logLevel );
+
+		/** Defers the formatting of the messages logged using va_args.
+		@remarks
+			The arguments are captured when the message is logged, and the message is formatted
+			by the logging thread, or not at all if it is written to a binary log file.
+		@param[in] deferred
+			Tells if the formatting is deferred
+		*/
+		ShaderParserExport static void SetDeferredFormatting( bool deferred );
+
+		/** Sets the binary log file.
+		@remarks
+			When set, all the messages are written to this file instead of the text log files,
+			the messages which formatting is deferred are written unformatted.
+			Such files are decoded with LogFormat::DecodeBinary, or the ShaderParserLogDecoder tool.
+		@param[in] logFilePath
+			The binary log file path, empty to go back to the text log files
+		*/
+		ShaderParserExport static void SetBinaryFileName( String const & logFilePath );
+
+		/** Registers a log sink, receiving the messages processed by the logging thread, in addition to the log files.
+		@remarks
+			The binary log file doesn't prevent the sinks from receiving the messages.
+		@param[in] sink
+			The sink
+		@param[in] ownThread
+			Tells if the sink receives the messages from its own thread, so it doesn't slow down the logging thread
+		*/
+		ShaderParserExport static void AddSink( LogSinkSPtr sink, bool ownThread = false );
+
+		/** Unregisters a log sink, after the messages waiting for it have been given to it.
+		@param[in] sink
+			The sink, as given to AddSink
+		*/
+		ShaderParserExport static void RemoveSink( LogSinkSPtr sink );
+
+		/** Retrieves the header written in front of the lines of the given log level.
+		@param[in] logLevel
+			The log level
+		@return
+			The header.
+		*/
+		ShaderParserExport static String const & GetHeader( ELogType logLevel );
+
 		/** Logs a debug message in the log file, using va_args
+		@remarks
+			When the formatting is deferred, the format is kept until the message is processed, so it must be a string literal.
 		@param[in] format
 			The line format
 		@param[in] ...
@@ -107,6 +218,8 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		ShaderParserExport static void LogDebug( std::wostream const & msg );
 
 		/** Logs a message in the log file, using va_args
+		@remarks
+			When the formatting is deferred, the format is kept until the message is processed, so it must be a string literal.
 		@param[in] format
 			The line format
 		@param[in] ...
@@ -147,6 +260,8 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		ShaderParserExport static void LogInfo( std::wostream const & msg );
 
 		/** Logs a warning in the log file, using va_args
+		@remarks
+			When the formatting is deferred, the format is kept until the message is processed, so it must be a string literal.
 		@param[in] format
 			The line format
 		@param[in] ...
@@ -187,6 +302,8 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		ShaderParserExport static void LogWarning( std::wostream const & msg );
 
 		/** Logs an error in the log file, using va_args
+		@remarks
+			When the formatting is deferred, the format is kept until the message is processed, so it must be a string literal.
 		@param[in] format
 			The line format
 		@param[in]	...
@@ -226,6 +343,13 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		*/
 		ShaderParserExport static void LogError( std::wostream const & msg );
 
+		/** Waits until the messages logged before this call have been processed by the logging thread.
+		@remarks
+			The log sinks are flushed too.
+			Returns immediately if the logging thread is not running.
+		*/
+		ShaderParserExport static void Flush();
+
 		/** Returns a reference over the instance
 		@return
 			The instance
@@ -240,11 +364,20 @@ BEGIN_NAMESPACE_SHADER_PARSER
 
 	private:
 		void DoSetFileName( String const & logFilePath, ELogType logType = ELogType_COUNT );
+		SMessageCache & DoGetThreadCache();
 		void DoPushMessage( ELogType type, std::string const & message );
 		void DoPushMessage( ELogType type, std::wstring const & message );
+		void DoPushMessage( ELogType type, char const * format, va_list args );
+		void DoPush( SMessage * message );
+		void DoSignalMessages();
+		void DoProcessMessages( bool display );
+		bool DoHasUnreportedDrops()const;
+		void DoReportDrops( bool display, bool force );
+		void DoReportSummaries( bool display, bool force );
+		void DoFlush();
 		void DoInitialiseThread();
 		void DoCleanupThread();
-		void DoFlushQueue( bool display );
+		void DoFlushQueue( bool display, bool complete );
 
 	private:
 		friend class CLoggerImpl;
@@ -273,22 +406,84 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		std::mutex _mutex;
 		//! the current logging level, all logs lower than this level are ignored
 		ELogType _logLevel;
+		//! Tells if the formatting of the messages logged using va_args is deferred
+		std::atomic_bool _deferred;
 		//! The header for each lg line of given log level
 		String _headers[ELogType_COUNT];
+		//! The logger generation, used to detect the thread message caches of a previous logger
+		uint32_t _generation;
+		//! The producer threads messages caches
+		std::vector< std::unique_ptr< SMessageCache > > _caches;
+		//! The mutex protecting the messages caches list
+		std::mutex _mutexCaches;
 		//! The message queue
-		MessageQueue _queue;
-		//! The mutex protecting the message queue
-		std::mutex _mutexQueue;
+		std::unique_ptr< CMessageQueue > _queue;
+		//! The bounded ring buffer, replacing the message queue when set
+		std::unique_ptr< CMessageRing > _ring;
+		//! The behaviour when the ring buffer is full
+		EBackpressure _overflow;
+		//! The dropped messages count, per level
+		std::atomic< uint64_t > _dropped[ELogType_COUNT];
+		//! The dropped messages count already reported, per level
+		uint64_t _reported[ELogType_COUNT];
+		//! The time of the last dropped messages report
+		std::chrono::steady_clock::time_point _lastReport;
+		//! The message used to report the dropped messages
+		std::unique_ptr< SMessage > _report;
+		//! The messages being processed by the logging thread
+		MessageQueue _processing;
+		//! The repeated messages and rate limits filter
+		std::unique_ptr< CLogFilter > _filter;
+		//! The messages kept by the filter, and its summaries
+		MessageQueue _filtered;
 		//! The logging thread
 		std::thread _logThread;
 		//! Tells if the thread must be stopped
 		std::atomic_bool _stopped;
-		//! Event raised when the thread is ended
-		std::condition_variable _threadEnded;
-		//! Mutex used to wait for the thread end
-		std::mutex _mutexThreadEnded;
+		//! Tells if messages were pushed since the logging thread last woke up, so a burst of messages signals it once
+		std::atomic_bool _pending;
+		//! Event raised to wake the logging thread up
+		std::condition_variable _wakeup;
+		//! Event raised when the logging thread has made room in the ring buffer
+		std::condition_variable _spaceAvailable;
+		//! The number of producers waiting for room in the ring buffer
+		uint32_t _blocked;
+		//! Event raised when the logging thread has processed a flush request
+		std::condition_variable _flushed;
+		//! Mutex protecting the logging thread wake up and the flush requests
+		std::mutex _mutexWakeup;
+		//! The flush requests count
+		uint64_t _flushRequests;
+		//! The processed flush requests count
+		uint64_t _flushesDone;
 	};
 }
 END_NAMESPACE_SHADER_PARSER
 
+#if !defined( PARSER_LOG_MIN_LEVEL )
+//! The minimum log level compiled in, the logs of lower levels are removed at compile time.
+#	if defined( NDEBUG )
+#		define PARSER_LOG_MIN_LEVEL NAMESPACE_SHADER_PARSER::ELogType_INFO
+#	else
+#		define PARSER_LOG_MIN_LEVEL NAMESPACE_SHADER_PARSER::ELogType_DEBUG
+#	endif
+#endif
+
+/** Logs a message with the given CLogger function, the arguments are evaluated only if the level is enabled.
+*/
+#define PARSER_LOG( level, function, ... )\
+	do\
+	{\
+		if ( NAMESPACE_SHADER_PARSER::level >= PARSER_LOG_MIN_LEVEL && NAMESPACE_SHADER_PARSER::CLogger::IsEnabled( NAMESPACE_SHADER_PARSER::level ) )\
+		{\
+			NAMESPACE_SHADER_PARSER::CLogger::function( __VA_ARGS__ );\
+		}\
+	}\
+	while ( 0 )
+
+#define PARSER_LOG_DEBUG( ... ) PARSER_LOG( ELogType_DEBUG, LogDebug, __VA_ARGS__ )
+#define PARSER_LOG_INFO( ... ) PARSER_LOG( ELogType_INFO, LogInfo, __VA_ARGS__ )
+#define PARSER_LOG_WARNING( ... ) PARSER_LOG( ELogType_WARNING, LogWarning, __VA_ARGS__ )
+#define PARSER_LOG_ERROR( ... ) PARSER_LOG( ELogType_ERROR, LogError, __VA_ARGS__ )
+
 #endif
@@ -17,6 +17,7 @@
 
 #include "ShaderParserLoggerConsole.h"
 #include "ShaderParserLogger.h"
+#include "ShaderParserLogSink.h"
 #include "ShaderParserStringUtils.h"
 #include "ShaderParserFileUtils.h"
 
@@ -24,7 +25,15 @@ BEGIN_NAMESPACE_SHADER_PARSER
 {
 	class CLoggerImpl;
 
+	namespace
+	{
+		//! The size of the files buffers, the buffered lines are written when it is reached
+		static const size_t LOG_FILE_BUFFER_SIZE = 64 * 1024;
+	}
+
 	CLoggerImpl::CLoggerImpl()
+		: _logFiles{}
+		, _binaryFile{}
 	{
 #if defined( NDEBUG )
 		_console = std::make_unique< CDefaultConsole >();
@@ -48,10 +57,22 @@ BEGIN_NAMESPACE_SHADER_PARSER
 
 	void CLoggerImpl::Cleanup()
 	{
+		std::unique_lock< std::mutex > l_lock( _mutexFiles );
+		_sinks.clear();
+
+		for ( auto & path : _logFilePath )
+		{
+			path.clear();
+		}
+
+		DoCloseUnusedFiles();
+		DoCloseBinaryFile();
 	}
 
 	void CLoggerImpl::SetFileName( String const & logFilePath, ELogType logLevel )
 	{
+		std::unique_lock< std::mutex > l_lock( _mutexFiles );
+
 		if ( logLevel == ELogType_COUNT )
 		{
 			for ( auto & path : _logFilePath )
@@ -64,12 +85,95 @@ BEGIN_NAMESPACE_SHADER_PARSER
 			_logFilePath[logLevel] = logFilePath;
 		}
 
-		FILE * file;
+		//!@remarks The file is truncated, even if it was already opened.
+		auto && l_it = _files.find( logFilePath );
+
+		if ( l_it != _files.end() )
+		{
+			DoWriteFile( l_it->second );
+			fclose( l_it->second.m_file );
+			_files.erase( l_it );
+		}
+
+		FILE * file = NULL;
 		FileUtils::FOpen( file, logFilePath.c_str(), "w" );
 
 		if ( file )
 		{
-			fclose( file );
+			//!@remarks The lines are buffered by the logger, so the file writes them directly.
+			setvbuf( file, NULL, _IONBF, 0 );
+			SLogFile & logFile = _files[logFilePath];
+			logFile.m_file = file;
+			logFile.m_buffer.reserve( LOG_FILE_BUFFER_SIZE );
+		}
+
+		DoCloseUnusedFiles();
+	}
+
+	void CLoggerImpl::SetBinaryFileName( String const & logFilePath )
+	{
+		std::unique_lock< std::mutex > l_lock( _mutexFiles );
+		DoCloseBinaryFile();
+
+		if ( !logFilePath.empty() )
+		{
+			FileUtils::FOpen( _binaryFile.m_file, logFilePath.c_str(), "wb" );
+
+			if ( _binaryFile.m_file )
+			{
+				setvbuf( _binaryFile.m_file, NULL, _IONBF, 0 );
+				_binaryFile.m_buffer.reserve( LOG_FILE_BUFFER_SIZE );
+				LogFormat::WriteBinaryHeader( _binaryFile.m_buffer );
+			}
+		}
+	}
+
+	void CLoggerImpl::AddSink( LogSinkSPtr sink, bool ownThread )
+	{
+		LogSinkSPtr l_target = sink;
+
+		if ( ownThread )
+		{
+			l_target = std::make_shared< CThreadedLogSink >( sink );
+		}
+
+		std::unique_lock< std::mutex > l_lock( _mutexFiles );
+		_sinks.push_back( std::make_pair( sink, l_target ) );
+	}
+
+	void CLoggerImpl::RemoveSink( LogSinkSPtr sink )
+	{
+		LogSinkSPtr l_target;
+
+		{
+			std::unique_lock< std::mutex > l_lock( _mutexFiles );
+			auto && l_it = std::find_if( _sinks.begin(), _sinks.end(), [&sink]( std::pair< LogSinkSPtr, LogSinkSPtr > const & p_pair )
+			{
+				return p_pair.first == sink;
+			} );
+
+			if ( l_it != _sinks.end() )
+			{
+				l_target = l_it->second;
+				_sinks.erase( l_it );
+			}
+		}
+
+		//!@remarks Flushed outside of the lock, since a threaded sink waits for its thread.
+		if ( l_target )
+		{
+			l_target->Flush();
+		}
+	}
+
+	void CLoggerImpl::FlushSinks()
+	{
+		//!@remarks The lock prevents the logging thread from giving messages to a sink while it is flushed.
+		std::unique_lock< std::mutex > l_lock( _mutexFiles );
+
+		for ( auto && l_sink : _sinks )
+		{
+			l_sink.second->Flush();
 		}
 	}
 
@@ -85,117 +189,168 @@ BEGIN_NAMESPACE_SHADER_PARSER
 
 	void CLoggerImpl::LogMessageQueue( MessageQueue const & p_queue, bool display )
 	{
-		static const String LOG_TIMESTAMP = STR( "%Y-%m-%d %H:%M:%S" );
-		std::tm l_dtToday = { 0 };
-		time_t l_tTime;
-		time( &l_tTime );
-		l_dtToday = *localtime( &l_tTime );
-		char l_buffer[33] = { 0 };
-		strftime( l_buffer, 32, LOG_TIMESTAMP.c_str(), &l_dtToday );
-		String l_timeStamp( l_buffer );
+		//!@remarks Computed once per flush, so the system clock adjustments are followed.
+		int64_t l_offset = LogFormat::GetSteadyToSystemOffset();
 
-		FILE * logFiles[ELogType_COUNT] = { NULL };
-		std::map< String, FILE * > opened;
+		std::unique_lock< std::mutex > l_lock( _mutexFiles );
 
-		try
+		if ( !_sinks.empty() )
 		{
+			_records.clear();
+
 			for ( auto && message : p_queue )
 			{
-				FILE * file = logFiles[message->m_type];
-
-				if ( !file )
-				{
-					auto && l_it = opened.find( _logFilePath[message->m_type] );
-
-					if ( l_it == opened.end() )
-					{
-						FileUtils::FOpen( file, _logFilePath[message->m_type].c_str(), "a" );
-
-						if ( file )
-						{
-							opened.insert( std::make_pair( _logFilePath[message->m_type], file ) );
-						}
-					}
-					else
-					{
-						file = l_it->second;
-					}
-
-					logFiles[message->m_type] = file;
-				}
+				_records.push_back( { message->m_type, LogFormat::ToSystemTime( message->m_time, l_offset ), message->GetMessage() } );
+			}
 
-				if ( file )
-				{
-					String toLog = message->GetMessage();
-
-					if ( toLog.find( STR( '\n' ) ) != String::npos )
-					{
-						StringArray array = StringUtils::Split( toLog, STR( "\n" ), uint32_t( std::count( toLog.begin(), toLog.end(), STR( '\n' ) ) + 1 ) );
-
-						for ( auto && line : array )
-						{
-							DoLogLine( l_timeStamp, line, file, message->m_type, display );
-						}
-					}
-					else
-					{
-						DoLogLine( l_timeStamp, toLog, file, message->m_type, display );
-					}
-				}
+			for ( auto && l_sink : _sinks )
+			{
+				l_sink.second->Log( _records );
 			}
+		}
 
-			for ( auto && it : opened )
+		if ( _binaryFile.m_file )
+		{
+			for ( auto && message : p_queue )
 			{
-				fclose( it.second );
+				DoLogBinary( *message, LogFormat::ToSystemTime( message->m_time, l_offset ) );
 			}
 
-			opened.clear();
+			DoWriteFile( _binaryFile );
+			return;
 		}
-		catch ( std::exception & )
+
+		for ( size_t i = 0; i < p_queue.size(); ++i )
 		{
-			//m_pConsole->Print( STR( "Couldn't open log file : " ) + String( exc.what() ), true );
+			SMessage const * message = p_queue[i];
+			SLogFile * file = _logFiles[message->m_type];
+
+			if ( file )
+			{
+				//!@remarks The message may already have been formatted for the sinks.
+				String const & toLog = _sinks.empty() ? message->GetMessage( _text ) : _records[i].m_text;
+				_timestamp.clear();
+				_timestampFormatter.Format( _timestamp, LogFormat::ToSystemTime( message->m_time, l_offset ) );
+
+				for ( auto && line : StringUtils::SplitView( toLog, STR( '\n' ) ) )
+				{
+					DoLogLine( _timestamp, line, *file, message->m_type, display );
+				}
+			}
+		}
+
+		for ( auto && it : _files )
+		{
+			DoWriteFile( it.second );
 		}
 	}
 
 	void CLoggerImpl::DoPrintMessage( ELogType logLevel, String const & message )
 	{
-		if ( message.find( STR( '\n' ) ) != String::npos )
+		for ( auto && line : StringUtils::SplitView( message, STR( '\n' ) ) )
 		{
-			StringArray array = StringUtils::Split( message, STR( "\n" ), uint32_t( std::count( message.begin(), message.end(), STR( '\n' ) ) + 1 ) );
+			DoPrintLine( line, logLevel );
+		}
+	}
+
+	void CLoggerImpl::DoPrintLine( StringView const & line, ELogType logLevel )
+	{
+		_console->BeginLog( logLevel );
+		_console->Print( line.str(), true );
+	}
+
+	void CLoggerImpl::DoLogLine( String const & timestamp, StringView const & line, SLogFile & logFile, ELogType logLevel, bool display )
+	{
+#if defined( NDEBUG )
+
+		if ( display )
+		{
+			DoPrintLine( line, logLevel );
+		}
+
+#endif
+
+		std::string & buffer = logFile.m_buffer;
+		buffer.append( timestamp );
+		buffer.append( STR( " - " ) );
+		buffer.append( _headers[logLevel] );
+		buffer.append( line.data(), line.size() );
+		buffer.push_back( '\n' );
 
-			for ( auto && line : array )
+		if ( buffer.size() >= LOG_FILE_BUFFER_SIZE )
+		{
+			DoWriteFile( logFile );
+		}
+	}
+
+	void CLoggerImpl::DoLogBinary( SMessage const & message, int64_t time )
+	{
+		if ( message.m_format )
+		{
+			auto && l_it = _binaryFormats.find( message.m_format );
+
+			if ( l_it == _binaryFormats.end() )
 			{
-				DoPrintLine( line, logLevel );
+				l_it = _binaryFormats.insert( std::make_pair( message.m_format, uint32_t( _binaryFormats.size() + 1 ) ) ).first;
+				LogFormat::WriteBinaryFormat( _binaryFile.m_buffer, l_it->second, message.m_format );
 			}
+
+			LogFormat::WriteBinaryMessage( _binaryFile.m_buffer, message.m_type, time, l_it->second, message.m_arguments );
 		}
 		else
 		{
-			DoPrintLine( message, logLevel );
+			LogFormat::WriteBinaryMessage( _binaryFile.m_buffer, message.m_type, time, 0, message.GetMessage( _text ) );
+		}
+
+		if ( _binaryFile.m_buffer.size() >= LOG_FILE_BUFFER_SIZE )
+		{
+			DoWriteFile( _binaryFile );
 		}
 	}
 
-	void CLoggerImpl::DoPrintLine( String const & line, ELogType logLevel )
+	void CLoggerImpl::DoCloseBinaryFile()
 	{
-		_console->BeginLog( logLevel );
-		_console->Print( line, true );
+		if ( _binaryFile.m_file )
+		{
+			DoWriteFile( _binaryFile );
+			fclose( _binaryFile.m_file );
+			_binaryFile.m_file = NULL;
+		}
+
+		_binaryFormats.clear();
 	}
 
-	void CLoggerImpl::DoLogLine( String const & timestamp, String const & line, FILE * logFile, ELogType logLevel, bool display )
+	void CLoggerImpl::DoWriteFile( SLogFile & logFile )
 	{
-#if defined( NDEBUG )
+		if ( !logFile.m_buffer.empty() )
+		{
+			fwrite( logFile.m_buffer.data(), 1, logFile.m_buffer.size(), logFile.m_file );
+			logFile.m_buffer.clear();
+		}
+	}
 
-		if ( display )
+	void CLoggerImpl::DoCloseUnusedFiles()
+	{
+		for ( int i = 0; i < ELogType_COUNT; i++ )
 		{
-			DoPrintLine( line, logLevel );
+			auto && l_it = _files.find( _logFilePath[i] );
+			_logFiles[i] = l_it != _files.end() ? &l_it->second : NULL;
 		}
 
-#endif
+		auto && l_it = _files.begin();
 
-		if ( logFile )
+		while ( l_it != _files.end() )
 		{
-			std::string logLine = timestamp + STR( " - " ) + _headers[logLevel] + line;
-			fwrite( logLine.c_str(), 1, logLine.size(), logFile );
-			fwrite( "\n", 1, 1, logFile );
+			if ( std::find( std::begin( _logFilePath ), std::end( _logFilePath ), l_it->first ) == std::end( _logFilePath ) )
+			{
+				DoWriteFile( l_it->second );
+				fclose( l_it->second.m_file );
+				l_it = _files.erase( l_it );
+			}
+			else
+			{
+				++l_it;
+			}
 		}
 	}
 }
@@ -16,96 +16,24 @@
 #include "ShaderParserPrerequisites.h"
 
 #include "ELogType.h"
-#include "ShaderParserStringUtils.h"
+#include "ShaderParserLogFormat.h"
+#include "ShaderParserMessageQueue.h"
+#include "ShaderParserStringView.h"
 
 #pragma warning( push )
 #pragma warning( disable:4290 )
 
 BEGIN_NAMESPACE_SHADER_PARSER
 {
-	/** Base class for a message representation
+	/** A log file, kept opened while the logger uses it.
 	*/
-	struct SMessageBase
+	struct SLogFile
 	{
-		/** Constructor
-		@param[in] type
-			The message type
-		*/
-		SMessageBase( ELogType type )
-			: m_type( type )
-		{
-		}
-
-		/** Retrieves the message content
-		@return
-			The message text
-		*/
-		virtual String GetMessage() = 0;
-
-		//! The message type
-		ELogType m_type;
-	};
-
-	/** Template class, holding character type dependant message text
-	*/
-	template< typename Char, typename Converter >
-	struct SBasicMessage
-		: public SMessageBase
-	{
-		typedef std::basic_string< Char > string_type;
-
-		/** Constructor
-		@param[in] type
-			The message type
-		@param[in] message
-			The message text
-		*/
-		SBasicMessage( ELogType type, string_type const & message )
-			: SMessageBase( type )
-			, m_message( message )
-		{
-		}
-
-		//@copydoc ShaderParser::SMessageBase::GetMessage
-		virtual String GetMessage()
-		{
-			return Converter::ToString( m_message );
-		}
-
-		//! The message text
-		string_type m_message;
-	};
-	
-	/** Template class, used to convert message to String
-	*/
-	template< typename Char > struct SMsgConverter;
-	
-	/** SMsgConverter specialisation, for char (no conversion)
-	*/
-	template<>
-	struct SMsgConverter< char >
-	{
-		static String ToString( const std::string & msg )
-		{
-			return msg;
-		}
+		//! The file
+		FILE * m_file;
+		//! The lines waiting to be written in the file
+		std::string m_buffer;
 	};
-	
-	/** SMsgConverter specialisation, for wchar_t
-	*/
-	template<>
-	struct SMsgConverter< wchar_t >
-	{
-		static String ToString( const std::wstring & msg )
-		{
-			return StringUtils::ToStr( msg );
-		}
-	};
-
-	//! A char message
-	typedef SBasicMessage< char, SMsgConverter< char > > SMessage;
-	//! A wchar_t message
-	typedef SBasicMessage< wchar_t, SMsgConverter< wchar_t > > SWMessage;
 
 	/** Helper class for Logger
 	*/
@@ -139,6 +67,30 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		*/
 		void SetFileName( String const & logFilePath, ELogType logLevel );
 
+		/** Sets the binary log file, replacing the text log files
+		@param[in] logFilePath
+			The file path, empty to go back to the text log files
+		*/
+		void SetBinaryFileName( String const & logFilePath );
+
+		/** Registers a log sink
+		@param[in] sink
+			The sink
+		@param[in] ownThread
+			Tells if the sink receives the messages from its own thread
+		*/
+		void AddSink( LogSinkSPtr sink, bool ownThread );
+
+		/** Unregisters a log sink
+		@param[in] sink
+			The sink, as given to AddSink
+		*/
+		void RemoveSink( LogSinkSPtr sink );
+
+		/** Flushes the log sinks
+		*/
+		void FlushSinks();
+
 		/** Prints a message to the console
 		@param[in] logLevel
 			The log level.
@@ -178,11 +130,11 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		@param[in] logType
 			The log level
 		*/
-		void DoPrintLine( String const & line, ELogType logType );
+		void DoPrintLine( StringView const & line, ELogType logType );
 
-		/** Logs a line in the given file
+		/** Logs a line in the given file buffer
 		@param[in] timestamp
-			The line timestamp
+			The line formatted timestamp
 		@param[in] line
 			The line
 		@param logFile
@@ -192,15 +144,57 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		@param[in] display
 			Tells if the line must be printed on console
 		*/
-		void DoLogLine( String const & timestamp, String const & line, FILE * logFile, ELogType logType, bool display );
+		void DoLogLine( String const & timestamp, StringView const & line, SLogFile & logFile, ELogType logType, bool display );
+
+		/** Logs a message in the binary log file buffer
+		@param[in] message
+			The message
+		@param[in] time
+			The message time, in microseconds since the system clock epoch
+		*/
+		void DoLogBinary( SMessage const & message, int64_t time );
+
+		/** Closes the binary log file
+		*/
+		void DoCloseBinaryFile();
+
+		/** Writes the buffered lines of the given file
+		@param logFile
+			The file
+		*/
+		void DoWriteFile( SLogFile & logFile );
+
+		/** Closes the files which are no more used by any log level
+		*/
+		void DoCloseUnusedFiles();
 
 	private:
 		//! The files paths, per log level
 		String _logFilePath[ELogType_COUNT];
+		//! The opened files, per log level
+		SLogFile * _logFiles[ELogType_COUNT];
+		//! The opened files, by path
+		std::map< String, SLogFile > _files;
+		//! The binary log file, its m_file is NULL when the text log files are used
+		SLogFile _binaryFile;
+		//! The identifiers of the formats already written in the binary log file
+		std::map< char const *, uint32_t > _binaryFormats;
+		//! The mutex protecting the files, since they are written by the logging thread
+		std::mutex _mutexFiles;
 		//! The headers, per log level
 		String _headers[ELogType_COUNT];
 		//! The console
 		std::unique_ptr< CProgramConsole > _console;
+		//! The log sinks, as registered, and the sinks actually receiving the messages
+		std::vector< std::pair< LogSinkSPtr, LogSinkSPtr > > _sinks;
+		//! The messages given to the log sinks
+		LogRecordArray _records;
+		//! The timestamps formatter
+		LogFormat::CTimestampFormatter _timestampFormatter;
+		//! The formatted timestamp of the message being logged
+		std::string _timestamp;
+		//! The text of the message being logged, when it must be formatted or converted
+		String _text;
 	};
 }
 END_NAMESPACE_SHADER_PARSER
@@ -0,0 +1,276 @@
+/************************************************************************//**
+* @file ShaderParserMessageQueue.cpp
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+* @brief CMessageQueue class
+*
+* @details Lock-free multiple producers, single consumer, queue of log messages,
+*	with per producer message caches.
+*
+***************************************************************************/
+
+#include "ShaderParserPch.h"
+
+#include "ShaderParserMessageQueue.h"
+
+#include "ShaderParserLogFormat.h"
+#include "ShaderParserStringUtils.h"
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	SMessage::SMessage()
+		: m_next( NULL )
+		, m_cache( NULL )
+		, m_type( ELogType_INFO )
+		, m_wide( false )
+		, m_format( NULL )
+	{
+	}
+
+	String SMessage::GetMessage()const
+	{
+		if ( m_format )
+		{
+			String result;
+			LogFormat::Format( result, m_format, m_arguments );
+			return result;
+		}
+
+		if ( m_wide )
+		{
+			return StringUtils::ToStr( m_wmessage );
+		}
+
+		return m_message;
+	}
+
+	String const & SMessage::GetMessage( String & buffer )const
+	{
+		if ( m_format )
+		{
+			buffer.clear();
+			LogFormat::Format( buffer, m_format, m_arguments );
+			return buffer;
+		}
+
+		if ( m_wide )
+		{
+			buffer = StringUtils::ToStr( m_wmessage );
+			return buffer;
+		}
+
+		return m_message;
+	}
+
+	SMessageCache::SMessageCache()
+		: m_free( NULL )
+		, m_released( NULL )
+		, m_inUse( false )
+	{
+	}
+
+	SMessageCache::~SMessageCache()
+	{
+		for ( SMessage * list : { m_free, m_released.exchange( NULL ) } )
+		{
+			while ( list )
+			{
+				SMessage * next = list->m_next.load( std::memory_order_relaxed );
+				delete list;
+				list = next;
+			}
+		}
+	}
+
+	SMessage * SMessageCache::Acquire()
+	{
+		if ( !m_free )
+		{
+			m_free = m_released.exchange( NULL, std::memory_order_acquire );
+		}
+
+		SMessage * message = m_free;
+
+		if ( message )
+		{
+			m_free = message->m_next.load( std::memory_order_relaxed );
+		}
+		else
+		{
+			message = new SMessage;
+			message->m_cache = this;
+		}
+
+		return message;
+	}
+
+	void SMessageCache::Release( SMessage * message )
+	{
+		SMessage * head = m_released.load( std::memory_order_relaxed );
+
+		do
+		{
+			message->m_next.store( head, std::memory_order_relaxed );
+		}
+		while ( !m_released.compare_exchange_weak( head, message, std::memory_order_release, std::memory_order_relaxed ) );
+	}
+
+	CMessageQueue::CMessageQueue()
+		: m_head( &m_stub )
+		, m_tail( &m_stub )
+	{
+	}
+
+	CMessageQueue::~CMessageQueue()
+	{
+	}
+
+	void CMessageQueue::Push( SMessage * message )
+	{
+		message->m_next.store( NULL, std::memory_order_relaxed );
+		SMessage * previous = m_head.exchange( message, std::memory_order_acq_rel );
+		previous->m_next.store( message, std::memory_order_release );
+	}
+
+	SMessage * CMessageQueue::Pop()
+	{
+		SMessage * tail = m_tail;
+		SMessage * next = tail->m_next.load( std::memory_order_acquire );
+
+		if ( tail == &m_stub )
+		{
+			if ( !next )
+			{
+				return NULL;
+			}
+
+			m_tail = next;
+			tail = next;
+			next = next->m_next.load( std::memory_order_acquire );
+		}
+
+		if ( next )
+		{
+			m_tail = next;
+			return tail;
+		}
+
+		if ( tail != m_head.load( std::memory_order_acquire ) )
+		{
+			//!@remarks A producer is between its exchange and its link, the message will be available on next call.
+			return NULL;
+		}
+
+		Push( &m_stub );
+		next = tail->m_next.load( std::memory_order_acquire );
+
+		if ( next )
+		{
+			m_tail = next;
+			return tail;
+		}
+
+		return NULL;
+	}
+
+	bool CMessageQueue::IsEmpty()const
+	{
+		return m_tail == &m_stub && m_head.load( std::memory_order_acquire ) == &m_stub;
+	}
+
+	CMessageRing::CMessageRing( size_t capacity )
+		: m_mask( 0 )
+		, m_enqueue( 0 )
+		, m_dequeue( 0 )
+	{
+		//!@remarks With a single cell, the sequence of a filled cell would match the next push position, and the push would overwrite it.
+		size_t size = 2;
+
+		while ( size < capacity )
+		{
+			size <<= 1;
+		}
+
+		m_cells.reset( new SCell[size] );
+
+		for ( size_t i = 0; i < size; ++i )
+		{
+			m_cells[i].m_sequence.store( i, std::memory_order_relaxed );
+			m_cells[i].m_message = NULL;
+		}
+
+		m_mask = size - 1;
+	}
+
+	CMessageRing::~CMessageRing()
+	{
+	}
+
+	bool CMessageRing::TryPush( SMessage * message )
+	{
+		size_t position = m_enqueue.load( std::memory_order_relaxed );
+
+		while ( true )
+		{
+			SCell & cell = m_cells[position & m_mask];
+			size_t sequence = cell.m_sequence.load( std::memory_order_acquire );
+			intptr_t difference = intptr_t( sequence ) - intptr_t( position );
+
+			if ( difference == 0 )
+			{
+				if ( m_enqueue.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+				{
+					cell.m_message = message;
+					cell.m_sequence.store( position + 1, std::memory_order_release );
+					return true;
+				}
+			}
+			else if ( difference < 0 )
+			{
+				return false;
+			}
+			else
+			{
+				position = m_enqueue.load( std::memory_order_relaxed );
+			}
+		}
+	}
+
+	SMessage * CMessageRing::TryPop()
+	{
+		size_t position = m_dequeue.load( std::memory_order_relaxed );
+
+		while ( true )
+		{
+			SCell & cell = m_cells[position & m_mask];
+			size_t sequence = cell.m_sequence.load( std::memory_order_acquire );
+			intptr_t difference = intptr_t( sequence ) - intptr_t( position + 1 );
+
+			if ( difference == 0 )
+			{
+				if ( m_dequeue.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+				{
+					SMessage * message = cell.m_message;
+					cell.m_sequence.store( position + m_mask + 1, std::memory_order_release );
+					return message;
+				}
+			}
+			else if ( difference < 0 )
+			{
+				return NULL;
+			}
+			else
+			{
+				position = m_dequeue.load( std::memory_order_relaxed );
+			}
+		}
+	}
+
+	bool CMessageRing::IsEmpty()const
+	{
+		return m_dequeue.load( std::memory_order_acquire ) == m_enqueue.load( std::memory_order_acquire );
+	}
+}
+END_NAMESPACE_SHADER_PARSER
@@ -0,0 +1,224 @@
+/************************************************************************//**
+* @file ShaderParserMessageQueue.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+* @brief CMessageQueue class
+*
+* @details Lock-free multiple producers, single consumer, queue of log messages,
+*	with per producer message caches.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_MESSAGE_QUEUE_H___
+#define ___SHADER_PARSER_MESSAGE_QUEUE_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include "ELogType.h"
+
+#include <atomic>
+#include <chrono>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** A log message, node of the message queue.
+	@remarks
+		The messages are recycled, so their texts keep their capacity, and a producer
+		logging messages of similar sizes doesn't allocate memory once warmed up.
+	*/
+	struct SMessage
+	{
+		/** Constructor
+		*/
+		SMessage();
+
+		/** Retrieves the message content
+		@return
+			The message text
+		*/
+		String GetMessage()const;
+
+		/** Retrieves the message content, without copying it if it is already formatted
+		@param[in,out] buffer
+			Receives the message text, if it must be formatted or converted
+		@return
+			The message text, m_message or buffer
+		*/
+		String const & GetMessage( String & buffer )const;
+
+		//! The next message, in the queue or in the cache
+		std::atomic< SMessage * > m_next;
+		//! The cache the message belongs to
+		SMessageCache * m_cache;
+		//! The message type
+		ELogType m_type;
+		//! The time the message was logged
+		std::chrono::steady_clock::time_point m_time;
+		//! Tells if the message text is m_wmessage
+		bool m_wide;
+		//! The message text
+		std::string m_message;
+		//! The unicode message text
+		std::wstring m_wmessage;
+		//! The printf format of a message which formatting is deferred, NULL if the message text is already formatted
+		char const * m_format;
+		//! The arguments captured for m_format
+		std::string m_arguments;
+	};
+
+	/** The messages cache of a producer thread.
+	@remarks
+		The producer takes its messages from its own list, and refills it with the whole list of messages
+		given back by the consumer, so neither side needs a lock, and the message list is ABA safe.
+	*/
+	struct SMessageCache
+	{
+		/** Constructor
+		*/
+		SMessageCache();
+
+		/** Destructor, deletes the cached messages
+		*/
+		~SMessageCache();
+
+		/** Retrieves an unused message, allocating it if the cache is empty.
+		@remarks
+			Called by the producer thread.
+		*/
+		SMessage * Acquire();
+
+		/** Gives back a processed message.
+		@remarks
+			Called by the consumer thread.
+		@param[in] message
+			The message
+		*/
+		void Release( SMessage * message );
+
+		//! The messages available to the producer
+		SMessage * m_free;
+		//! The messages given back by the consumer
+		std::atomic< SMessage * > m_released;
+		//! Tells if a producer thread uses this cache
+		std::atomic_bool m_inUse;
+	};
+
+	/** Lock-free multiple producers, single consumer, intrusive queue of log messages.
+	*/
+	class CMessageQueue
+	{
+	public:
+		/** Constructor
+		*/
+		CMessageQueue();
+
+		/** Destructor
+		*/
+		~CMessageQueue();
+
+		/** Pushes a message at the end of the queue.
+		@remarks
+			Wait-free, can be called from any thread.
+		@param[in] message
+			The message
+		*/
+		void Push( SMessage * message );
+
+		/** Pops the message at the front of the queue.
+		@remarks
+			Must be called from the consumer thread only.
+		@return
+			The message, NULL if the queue is empty, or if the first pushed message is not yet linked.
+		*/
+		SMessage * Pop();
+
+		/** Tells if the queue is empty.
+		@remarks
+			Must be called from the consumer thread only.
+			A queue holding a message not yet linked by its producer is not empty, though Pop returns NULL.
+		@return
+			\p true if no message remains in the queue.
+		*/
+		bool IsEmpty()const;
+
+	private:
+		//! The last pushed message
+		std::atomic< SMessage * > m_head;
+		//! The next message to pop, consumer side
+		SMessage * m_tail;
+		//! The stub message, allowing the queue to be empty
+		SMessage m_stub;
+	};
+
+	/** Lock-free bounded multiple producers, multiple consumers, ring buffer of log messages.
+	@remarks
+		Producers may pop messages too, to drop the oldest ones when the ring is full.
+	*/
+	class CMessageRing
+	{
+	public:
+		/** Constructor
+		@param[in] capacity
+			The ring capacity, rounded up to a power of two, at least 2
+		*/
+		explicit CMessageRing( size_t capacity );
+
+		/** Destructor
+		*/
+		~CMessageRing();
+
+		/** Pushes a message at the end of the ring.
+		@param[in] message
+			The message
+		@return
+			\p false if the ring is full.
+		*/
+		bool TryPush( SMessage * message );
+
+		/** Pops the message at the front of the ring.
+		@return
+			The message, NULL if the ring is empty, or if the first pushed message is not yet published.
+		*/
+		SMessage * TryPop();
+
+		/** Tells if the ring is empty.
+		@return
+			\p true if every pushed message has been popped.
+		*/
+		bool IsEmpty()const;
+
+		/** Retrieves the ring capacity.
+		@return
+			The capacity.
+		*/
+		size_t GetCapacity()const
+		{
+			return m_mask + 1;
+		}
+
+	private:
+		/** A ring cell
+		*/
+		struct SCell
+		{
+			//! The cell sequence, telling if the cell is ready to be written or read
+			std::atomic< size_t > m_sequence;
+			//! The message
+			SMessage * m_message;
+		};
+
+		//! The cells
+		std::unique_ptr< SCell[] > m_cells;
+		//! The capacity mask
+		size_t m_mask;
+		//! The next write position
+		std::atomic< size_t > m_enqueue;
+		//! The next read position
+		std::atomic< size_t > m_dequeue;
+	};
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif
@@ -0,0 +1,213 @@
+/************************************************************************//**
+* @file ShaderParserParsePool.cpp
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief CParsePool class definition.
+*
+***************************************************************************/
+
+#include "ShaderParserPch.h"
+
+#include "ShaderParserParsePool.h"
+#include "ShaderParserFactoryManager.h"
+#include "ShaderParserException.h"
+#include "ShaderParserFormat.h"
+#include "ShaderParserLogger.h"
+#include "ShaderGrammar.h"
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	static constexpr char ERROR_DB_GRAMMAR_NOT_CREATED[] = "Grammar type {} could not be created";
+	static const String ERROR_PARSE_CALLBACK = STR( "Parse request completion callback failed" );
+
+	CParsePool::CParsePool( String const & p_grammarType, uint32_t p_workers, size_t p_capacity, EBackpressure p_backpressure )
+		: m_capacity( std::max< size_t >( 1, p_capacity ) )
+		, m_backpressure( p_backpressure )
+		, m_stopped( false )
+	{
+		//!@remarks The grammars are created here, since the factory manager is not thread safe.
+		for ( uint32_t i = 0; i < std::max< uint32_t >( 1, p_workers ); ++i )
+		{
+			std::unique_ptr< CShaderGrammar > l_grammar( CFactoryManager::Instance().CreateInstance( p_grammarType ) );
+
+			if ( !l_grammar )
+			{
+				PARSER_EXCEPT( EShaderParserExceptionCodes_NullPointer, PARSER_FORMAT( ERROR_DB_GRAMMAR_NOT_CREATED, p_grammarType ) );
+			}
+
+			m_grammars.push_back( std::move( l_grammar ) );
+		}
+
+		for ( auto && l_grammar : m_grammars )
+		{
+			CShaderGrammar const * l_worker = l_grammar.get();
+			m_workers.emplace_back( [this, l_worker]()
+			{
+				DoWork( *l_worker );
+			} );
+		}
+	}
+
+	CParsePool::~CParsePool()
+	{
+		std::deque< std::unique_ptr< SRequest > > l_pending;
+		{
+			std::unique_lock< std::mutex > l_lock( m_mutex );
+			m_stopped = true;
+			std::swap( l_pending, m_queue );
+		}
+
+		m_notEmpty.notify_all();
+		m_notFull.notify_all();
+
+		for ( auto && l_worker : m_workers )
+		{
+			l_worker.join();
+		}
+
+		for ( auto && l_request : l_pending )
+		{
+			DoAbandon( *l_request, EParseStatus_CANCELLED );
+		}
+	}
+
+	std::future< SParseResult > CParsePool::ParseAsync( String const & p_source, SParseOptions const & p_options )
+	{
+		auto l_request = std::make_unique< SRequest >();
+		l_request->m_source = p_source;
+		l_request->m_options = p_options;
+		std::future< SParseResult > l_result = l_request->m_promise.get_future();
+		DoPush( std::move( l_request ) );
+		return l_result;
+	}
+
+	void CParsePool::ParseAsync( String const & p_source, SParseOptions const & p_options, Callback const & p_callback )
+	{
+		auto l_request = std::make_unique< SRequest >();
+		l_request->m_source = p_source;
+		l_request->m_options = p_options;
+		l_request->m_callback = p_callback;
+		DoPush( std::move( l_request ) );
+	}
+
+	void CParsePool::DoPush( std::unique_ptr< SRequest > p_request )
+	{
+		std::unique_ptr< SRequest > l_abandoned;
+		bool l_stopped;
+		{
+			std::unique_lock< std::mutex > l_lock( m_mutex );
+
+			if ( m_queue.size() >= m_capacity && !m_stopped )
+			{
+				switch ( m_backpressure )
+				{
+				case EBackpressure_REJECT:
+					l_abandoned = std::move( p_request );
+					break;
+
+				case EBackpressure_DROP_OLDEST:
+					l_abandoned = std::move( m_queue.front() );
+					m_queue.pop_front();
+					break;
+
+				default:
+					m_notFull.wait( l_lock, [this]()
+					{
+						return m_queue.size() < m_capacity || m_stopped;
+					} );
+					break;
+				}
+			}
+
+			l_stopped = m_stopped;
+
+			if ( p_request && l_stopped )
+			{
+				l_abandoned = std::move( p_request );
+			}
+
+			if ( p_request )
+			{
+				m_queue.push_back( std::move( p_request ) );
+			}
+		}
+
+		if ( l_abandoned )
+		{
+			DoAbandon( *l_abandoned, l_stopped ? EParseStatus_CANCELLED : EParseStatus_REJECTED );
+		}
+		else
+		{
+			m_notEmpty.notify_one();
+		}
+	}
+
+	void CParsePool::DoWork( CShaderGrammar const & p_grammar )
+	{
+		while ( true )
+		{
+			std::unique_ptr< SRequest > l_request;
+			{
+				std::unique_lock< std::mutex > l_lock( m_mutex );
+				m_notEmpty.wait( l_lock, [this]()
+				{
+					return !m_queue.empty() || m_stopped;
+				} );
+
+				if ( m_stopped )
+				{
+					break;
+				}
+
+				l_request = std::move( m_queue.front() );
+				m_queue.pop_front();
+			}
+
+			m_notFull.notify_one();
+
+			try
+			{
+				DoComplete( *l_request, p_grammar.Parse( l_request->m_source, l_request->m_options ) );
+			}
+			catch ( ... )
+			{
+				if ( l_request->m_callback )
+				{
+					try
+					{
+						throw;
+					}
+					COMMON_CATCH( ERROR_PARSE_CALLBACK )
+				}
+				else
+				{
+					l_request->m_promise.set_exception( std::current_exception() );
+				}
+			}
+		}
+	}
+
+	void CParsePool::DoAbandon( SRequest & p_request, EParseStatus p_status )
+	{
+		SParseResult l_result;
+		l_result.m_status = p_status;
+		l_result.m_source = std::move( p_request.m_source );
+		DoComplete( p_request, std::move( l_result ) );
+	}
+
+	void CParsePool::DoComplete( SRequest & p_request, SParseResult && p_result )
+	{
+		if ( p_request.m_callback )
+		{
+			p_request.m_callback( p_result );
+		}
+		else
+		{
+			p_request.m_promise.set_value( std::move( p_result ) );
+		}
+	}
+}
+END_NAMESPACE_SHADER_PARSER
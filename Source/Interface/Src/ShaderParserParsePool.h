@@ -0,0 +1,144 @@
+/************************************************************************//**
+* @file ShaderParserParsePool.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief CParsePool class declaration.
+*
+* @details Runs parse requests asynchronously, on a pool of worker threads
+*	fed through a bounded request queue.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_PARSE_POOL_H___
+#define ___SHADER_PARSER_PARSE_POOL_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include "EBackpressure.h"
+#include "ShaderParserParseResult.h"
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** Runs parse requests asynchronously, on a pool of worker threads.
+	@remarks
+		Each worker owns its grammar, created through CFactoryManager, so the
+		pool must be destroyed before the plugin providing the grammar is unloaded.
+		Requests are queued in a bounded queue, shared by all submitters and workers,
+		the behaviour when it is full is given by the backpressure policy.
+	*/
+	class CParsePool
+	{
+	public:
+		//! The completion callback, called from a worker thread, or from the submitter thread for rejected requests.
+		using Callback = std::function< void( SParseResult const & ) >;
+
+	public:
+		/** Constructor, creates the workers and their grammars.
+		@param[in] grammarType
+			The grammar object type, given to CFactoryManager::CreateInstance.
+		@param[in] workers
+			The number of worker threads.
+		@param[in] capacity
+			The maximum number of pending requests.
+		@param[in] backpressure
+			The behaviour when a request is submitted while the queue is full.
+		@throw EShaderParserExceptionCodes_ItemNotFound, EShaderParserExceptionCodes_NullPointer
+		*/
+		ShaderParserExport CParsePool( String const & grammarType, uint32_t workers, size_t capacity, EBackpressure backpressure );
+
+		/** Destructor, waits for the running requests.
+		@remarks
+			The pending requests are completed with the EParseStatus_CANCELLED status.
+		*/
+		ShaderParserExport ~CParsePool();
+
+		/** Submits a parse request.
+		@param[in] source
+			The shader source.
+		@param[in] options
+			The parse options.
+		@return
+			The future parse result.
+		*/
+		ShaderParserExport std::future< SParseResult > ParseAsync( String const & source, SParseOptions const & options = SParseOptions() );
+
+		/** Submits a parse request.
+		@param[in] source
+			The shader source.
+		@param[in] options
+			The parse options.
+		@param[in] callback
+			The function receiving the parse result.
+		*/
+		ShaderParserExport void ParseAsync( String const & source, SParseOptions const & options, Callback const & callback );
+
+	private:
+		/** A pending parse request.
+		*/
+		struct SRequest
+		{
+			//! The shader source
+			String m_source;
+			//! The parse options
+			SParseOptions m_options;
+			//! The promise, used if there is no callback
+			std::promise< SParseResult > m_promise;
+			//! The completion callback
+			Callback m_callback;
+		};
+
+		/** Queues a request, applying the backpressure policy.
+		@param[in] request
+			The request.
+		*/
+		void DoPush( std::unique_ptr< SRequest > request );
+
+		/** Worker thread loop.
+		@param[in] grammar
+			The worker grammar.
+		*/
+		void DoWork( CShaderGrammar const & grammar );
+
+		/** Completes a request without parsing it.
+		@param[in] request
+			The request.
+		@param[in] status
+			The result status.
+		*/
+		static void DoAbandon( SRequest & request, EParseStatus status );
+
+		/** Gives the result to the request owner.
+		@param[in] request
+			The request.
+		@param[in] result
+			The parse result.
+		*/
+		static void DoComplete( SRequest & request, SParseResult && result );
+
+	private:
+		//! The workers grammars
+		std::vector< std::unique_ptr< CShaderGrammar > > m_grammars;
+		//! The worker threads
+		std::vector< std::thread > m_workers;
+		//! The pending requests
+		std::deque< std::unique_ptr< SRequest > > m_queue;
+		//! Protects the queue
+		std::mutex m_mutex;
+		//! Signaled when a request is queued, or when the pool stops
+		std::condition_variable m_notEmpty;
+		//! Signaled when a request is dequeued, or when the pool stops
+		std::condition_variable m_notFull;
+		//! The maximum number of pending requests
+		size_t m_capacity;
+		//! The full queue behaviour
+		EBackpressure m_backpressure;
+		//! Tells the workers to stop
+		bool m_stopped;
+	};
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif // ___SHADER_PARSER_PARSE_POOL_H___
@@ -0,0 +1,102 @@
+/************************************************************************//**
+* @file ShaderParserParseResult.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief Parse result structures.
+*
+* @details Holds the options of CShaderGrammar::Parse, the partial syntax tree
+*	and the diagnostics it produces, and the edits given to CShaderGrammar::Reparse.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_PARSE_RESULT_H___
+#define ___SHADER_PARSER_PARSE_RESULT_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include "EParseStatus.h"
+
+#include <chrono>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** A syntax error, located in the parsed source.
+	*/
+	struct SParseDiagnostic
+	{
+		//! The offset of the erroneous construct, in the source
+		size_t m_offset;
+		//! The line of the erroneous construct, starting at 1
+		uint32_t m_line;
+		//! The column of the erroneous construct, starting at 1
+		uint32_t m_column;
+		//! The error description
+		String m_message;
+	};
+
+	/** A node of the syntax tree.
+	@remarks
+		Top level nodes are the external declarations, their children are
+		the statements recovered from function bodies.
+	*/
+	struct SParseNode
+	{
+		//! The offset of the first character of the node, in the source
+		size_t m_begin;
+		//! The offset following the last character of the node, in the source
+		size_t m_end;
+		//! Tells if the node was successfully parsed
+		bool m_valid;
+		//! The nodes recovered inside an invalid node
+		std::vector< SParseNode > m_children;
+	};
+
+	/** The options of a parse request.
+	*/
+	struct SParseOptions
+	{
+		//! The maximum nesting depth of parentheses, brackets, braces, prefix operators, statements and assignment or conditional chains.
+		//! A declaration going deeper is reported as a single error, since the grammar would recurse on the native stack.
+		uint32_t m_maxDepth = 128;
+		//! The cancellation token, checked before each external declaration and inside its statements and expressions, none if null.
+		CancellationTokenSPtr m_cancellation;
+		//! The maximum number of characters to parse, 0 for no limit.
+		size_t m_maxBytes = 0;
+		//! The maximum parse duration, 0 for no limit.
+		std::chrono::milliseconds m_timeout = std::chrono::milliseconds( 0 );
+	};
+
+	/** A text edit, applied to a previously parsed source.
+	*/
+	struct SParseEdit
+	{
+		//! The offset of the edit, in the previous source
+		size_t m_offset;
+		//! The number of characters removed at m_offset
+		size_t m_removed;
+		//! The text inserted at m_offset
+		String m_inserted;
+	};
+
+	/** The result of a parse request.
+	*/
+	struct SParseResult
+	{
+		//! The parse outcome
+		EParseStatus m_status;
+		//! The parsed source, kept to allow incremental reparse
+		String m_source;
+		//! The top level nodes (one per external declaration)
+		std::vector< SParseNode > m_declarations;
+		//! All the syntax errors, in source order
+		std::vector< SParseDiagnostic > m_diagnostics;
+		//! The number of top level nodes taken from the previous result, by CShaderGrammar::Reparse
+		size_t m_reused = 0;
+	};
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif // ___SHADER_PARSER_PARSE_RESULT_H___
@@ -18,6 +18,7 @@
 #include "ShaderParserPlugin.h"
 #include "ShaderParserPluginManager.h"
 #include "ShaderParserException.h"
+#include "ShaderParserFormat.h"
 
 #include "ShaderParserLogger.h"
 
@@ -26,13 +27,13 @@ BEGIN_NAMESPACE_SHADER_PARSER
 	const String SYMBOL_DLL_STOP = STR( "DllStopPlugin" );
 	const String SYMBOL_DLL_START = STR( "DllStartPlugin" );
 
-	const String INFO_DB_INSTALLING_PLUGIN = STR( "Installing plugin \"%s\"" );
-	const String INFO_DB_PLUGIN_SUCCESSFULLY_INSTALLED = STR( "CPlugin \"%s\" successfully installed" );
-	const String INFO_DB_UNINSTALLING_PLUGIN = STR( "Uninstalling plugin \"%s\"" );
-	const String INFO_DB_PLUGIN_SUCCESSFULLY_UNINSTALLED = STR( "CPlugin \"%s\" successfully uninstalled" );
+	constexpr char INFO_DB_INSTALLING_PLUGIN[] = "Installing plugin \"{}\"";
+	constexpr char INFO_DB_PLUGIN_SUCCESSFULLY_INSTALLED[] = "CPlugin \"{}\" successfully installed";
+	constexpr char INFO_DB_UNINSTALLING_PLUGIN[] = "Uninstalling plugin \"{}\"";
+	constexpr char INFO_DB_PLUGIN_SUCCESSFULLY_UNINSTALLED[] = "CPlugin \"{}\" successfully uninstalled";
 
-	const String ERROR_DB_SYMBOL_DLL_STOP_NOT_FOUND = STR( "Cannot find symbol DllStopPlugin in library " );
-	const String ERROR_DB_SYMBOL_DLL_START_NOT_FOUND = STR( "Cannot find symbol DllStartPlugin in library " );
+	constexpr char ERROR_DB_SYMBOL_DLL_STOP_NOT_FOUND[] = "Cannot find symbol DllStopPlugin in library {}";
+	constexpr char ERROR_DB_SYMBOL_DLL_START_NOT_FOUND[] = "Cannot find symbol DllStartPlugin in library {}";
 
 	typedef void ( *DLL_START_PLUGIN )();
 	typedef void ( *DLL_STOP_PLUGIN )();
@@ -117,9 +118,7 @@ BEGIN_NAMESPACE_SHADER_PARSER
 
 			if ( !l_func )
 			{
-				StringStream l_stream;
-				l_stream << ERROR_DB_SYMBOL_DLL_START_NOT_FOUND << p_pluginName;
-				PARSER_EXCEPT( EShaderParserExceptionCodes_ItemNotFound, l_stream.str() );
+				PARSER_EXCEPT( EShaderParserExceptionCodes_ItemNotFound, PARSER_FORMAT( ERROR_DB_SYMBOL_DLL_START_NOT_FOUND, p_pluginName ) );
 			}
 
 			//!@remarks This must call InstallPlugin
@@ -129,18 +128,18 @@ BEGIN_NAMESPACE_SHADER_PARSER
 
 	void CPluginManager::InstallPlugin( PluginShaderParserRPtr p_plugin )
 	{
-		CLogger::LogDebug( ( Format( INFO_DB_INSTALLING_PLUGIN ) % p_plugin->GetName() ).str() );
+		PARSER_LOG_DEBUG( PARSER_FORMAT( INFO_DB_INSTALLING_PLUGIN, p_plugin->GetName() ) );
 
 		m_plugins.push_back( p_plugin );
 		p_plugin->Install();
 		p_plugin->Initialise();
 
-		CLogger::LogDebug( ( Format( INFO_DB_PLUGIN_SUCCESSFULLY_INSTALLED ) % p_plugin->GetName() ).str() );
+		PARSER_LOG_DEBUG( PARSER_FORMAT( INFO_DB_PLUGIN_SUCCESSFULLY_INSTALLED, p_plugin->GetName() ) );
 	}
 
 	void CPluginManager::UninstallPlugin( PluginShaderParserRPtr p_plugin )
 	{
-		CLogger::LogDebug( ( Format( INFO_DB_UNINSTALLING_PLUGIN ) % p_plugin->GetName() ).str() );
+		PARSER_LOG_DEBUG( PARSER_FORMAT( INFO_DB_UNINSTALLING_PLUGIN, p_plugin->GetName() ) );
 
 		auto && l_it = std::find( m_plugins.begin(), m_plugins.end(), p_plugin );
 
@@ -151,7 +150,7 @@ BEGIN_NAMESPACE_SHADER_PARSER
 			m_plugins.erase( l_it );
 		}
 
-		CLogger::LogDebug( ( Format( INFO_DB_PLUGIN_SUCCESSFULLY_UNINSTALLED ) % p_plugin->GetName() ).str() );
+		PARSER_LOG_DEBUG( PARSER_FORMAT( INFO_DB_PLUGIN_SUCCESSFULLY_UNINSTALLED, p_plugin->GetName() ) );
 	}
 
 	void CPluginManager::UnloadPlugin( const String & p_pluginName )
@@ -171,9 +170,7 @@ BEGIN_NAMESPACE_SHADER_PARSER
 
 			if ( !l_func )
 			{
-				StringStream l_stream;
-				l_stream  << ERROR_DB_SYMBOL_DLL_STOP_NOT_FOUND << p_pluginName;
-				PARSER_EXCEPT( EShaderParserExceptionCodes_ItemNotFound, l_stream.str() );
+				PARSER_EXCEPT( EShaderParserExceptionCodes_ItemNotFound, PARSER_FORMAT( ERROR_DB_SYMBOL_DLL_STOP_NOT_FOUND, p_pluginName ) );
 			}
 
 			//!@remarks This must call UninstallPlugin
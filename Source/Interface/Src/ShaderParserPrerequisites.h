@@ -30,6 +30,8 @@
 #include <locale>
 #include <functional>
 #include <deque>
+#include <future>
+#include <condition_variable>
 
 #include <cstdint>
 #include <cstdlib>
@@ -71,8 +73,9 @@ namespace ShaderParser
 	using InputStream = std::basic_istream< TChar >;
 	using Format = boost::basic_format< TChar >;
 
-	using Rule = qi::rule< String::iterator, qi::space_type >;
-	using Grammar = qi::grammar< String::iterator, qi::space_type >;
+	using Rule = qi::rule< String::iterator, qi::ascii::space_type >;
+	using LexemeRule = qi::rule< String::iterator >;
+	using Grammar = qi::grammar< String::iterator, qi::ascii::space_type >;
 
 #	define STR( x ) x
 #	define tcout std::cout
@@ -84,10 +87,16 @@ namespace ShaderParser
 #endif
 
 	// Logging related classes
-	struct SMessageBase;
+	struct SMessage;
+	struct SMessageCache;
+	class CMessageQueue;
+	class CMessageRing;
+	class CLogFilter;
 	class CLogger;
 	class CLoggerImpl;
 	class CProgramConsole;
+	class ILogSink;
+	struct SLogRecord;
 
 	// Plugin related stuff
 	class CDynLib;
@@ -104,15 +113,25 @@ namespace ShaderParser
 	class CShaderParser;
 	class CShaderGrammar;
 	class CShaderParserException;
+	class CCancellationToken;
+	class CParsePool;
+	struct SParseDiagnostic;
+	struct SParseNode;
+	struct SParseOptions;
+	struct SParseEdit;
+	struct SParseResult;
 
 	// Pointers
 	DECLARE_SMART_PTR( DynLib );
 	DECLARE_SMART_PTR( PluginShaderParser );
 	DECLARE_SMART_PTR( ShaderParser );
+	DECLARE_SMART_PTR( CancellationToken );
+	using LogSinkSPtr = std::shared_ptr< ILogSink >;
 
 	// Containers
 	using StringArray = std::vector< String >;
-	using MessageQueue = std::deque< std::unique_ptr< SMessageBase > >;
+	using MessageQueue = std::vector< SMessage * >;
+	using LogRecordArray = std::vector< SLogRecord >;
 
 	// Factory type constants
 	static const String FACTORY_SHADER_PARSER_TYPE = STR( "Factory shader parser" );
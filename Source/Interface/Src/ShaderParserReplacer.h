@@ -0,0 +1,330 @@
+/************************************************************************//**
+* @file ShaderParserReplacer.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief CBasicReplacer class
+*
+* @details Replaces a set of patterns in a single pass, using an Aho-Corasick automaton.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_REPLACER_H___
+#define ___SHADER_PARSER_REPLACER_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include <algorithm>
+#include <cstring>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** Replaces multiple patterns in strings, in a single pass.
+	@remarks
+		The patterns set is compiled once, in an Aho-Corasick automaton, and can then be applied to any number of strings.
+		The matches are replaced from left to right, the longest one wins when several start at the same position,
+		and the replacements are not searched again.
+		When no replacement is longer than its pattern, the strings are rewritten in place.
+	*/
+	template< typename CharType >
+	class CBasicReplacer
+	{
+	public:
+		typedef std::basic_string< CharType > string_type;
+		typedef std::map< string_type, string_type > map_type;
+
+	public:
+		/** Constructor, compiles the patterns
+		@param[in] replacements
+			The replacement of each pattern, the empty patterns are ignored
+		*/
+		explicit CBasicReplacer( map_type const & replacements )
+			: m_inPlace( true )
+		{
+			m_nodes.push_back( SNode() );
+
+			for ( auto && l_it : replacements )
+			{
+				if ( !l_it.first.empty() )
+				{
+					DoAddPattern( l_it.first, l_it.second );
+				}
+			}
+
+			DoLinkNodes();
+		}
+
+		/** Replaces the patterns in a string
+		@param[in,out] str
+			The string to modify
+		@return
+			A reference on the modified string
+		*/
+		string_type & Replace( string_type & str )const
+		{
+			if ( m_patterns.empty() || str.empty() )
+			{
+				return str;
+			}
+
+			if ( m_inPlace )
+			{
+				//!@remarks The output never goes past the input being read, so it is written over it.
+				size_t l_written = DoReplace( str, &str[0] );
+				str.resize( l_written );
+			}
+			else
+			{
+				string_type l_result;
+				l_result.reserve( str.size() + str.size() / 4 );
+				DoReplace( str, l_result );
+				str.swap( l_result );
+			}
+
+			return str;
+		}
+
+		/** Tells if the strings are rewritten in place
+		@return
+			\p true if no replacement is longer than its pattern.
+		*/
+		bool IsInPlace()const
+		{
+			return m_inPlace;
+		}
+
+	private:
+		/** A compiled pattern
+		*/
+		struct SPattern
+		{
+			//! The pattern length
+			size_t m_length;
+			//! The pattern replacement
+			string_type m_replacement;
+		};
+
+		/** An automaton state, the trie node of a patterns prefix
+		*/
+		struct SNode
+		{
+			SNode()
+				: m_depth( 0 )
+				, m_fail( 0 )
+				, m_output( NO_PATTERN )
+			{
+			}
+
+			//! The children nodes, sorted by character
+			std::vector< std::pair< CharType, uint32_t > > m_children;
+			//! The prefix length
+			size_t m_depth;
+			//! The node of the longest proper suffix of the prefix which is also a prefix
+			uint32_t m_fail;
+			//! The longest pattern which is a suffix of the prefix, NO_PATTERN if there is none
+			uint32_t m_output;
+		};
+
+		/** A match waiting to be replaced
+		*/
+		struct SMatch
+		{
+			//! The match start
+			size_t m_start;
+			//! The matched pattern
+			uint32_t m_pattern;
+		};
+
+		//! The value of an unset pattern index
+		static const uint32_t NO_PATTERN = ~uint32_t( 0 );
+
+	private:
+		/** Adds a pattern to the trie
+		*/
+		void DoAddPattern( string_type const & pattern, string_type const & replacement )
+		{
+			uint32_t l_node = 0;
+
+			for ( auto l_char : pattern )
+			{
+				uint32_t l_child = DoGetChild( l_node, l_char );
+
+				if ( l_child == 0 )
+				{
+					l_child = uint32_t( m_nodes.size() );
+					auto & l_children = m_nodes[l_node].m_children;
+					l_children.insert( std::lower_bound( l_children.begin(), l_children.end(), std::make_pair( l_char, uint32_t( 0 ) ) ), std::make_pair( l_char, l_child ) );
+					SNode l_new;
+					l_new.m_depth = m_nodes[l_node].m_depth + 1;
+					m_nodes.push_back( l_new );
+				}
+
+				l_node = l_child;
+			}
+
+			m_nodes[l_node].m_output = uint32_t( m_patterns.size() );
+			m_patterns.push_back( SPattern{ pattern.size(), replacement } );
+			m_inPlace &= replacement.size() <= pattern.size();
+		}
+
+		/** Computes the failure links, breadth first, and propagates the outputs along them
+		*/
+		void DoLinkNodes()
+		{
+			std::vector< uint32_t > l_queue;
+			l_queue.reserve( m_nodes.size() );
+
+			for ( auto && l_child : m_nodes[0].m_children )
+			{
+				l_queue.push_back( l_child.second );
+			}
+
+			for ( size_t i = 0; i < l_queue.size(); ++i )
+			{
+				uint32_t l_node = l_queue[i];
+
+				for ( auto && l_child : m_nodes[l_node].m_children )
+				{
+					uint32_t l_fail = DoGetNext( m_nodes[l_node].m_fail, l_child.first );
+					SNode & l_childNode = m_nodes[l_child.second];
+					l_childNode.m_fail = l_fail;
+
+					if ( l_childNode.m_output == NO_PATTERN )
+					{
+						//!@remarks The failure node is shallower, so its output is already final.
+						l_childNode.m_output = m_nodes[l_fail].m_output;
+					}
+
+					l_queue.push_back( l_child.second );
+				}
+			}
+		}
+
+		/** Retrieves the child of a node for a character
+		@return
+			The child, 0 if there is none.
+		*/
+		uint32_t DoGetChild( uint32_t node, CharType value )const
+		{
+			auto & l_children = m_nodes[node].m_children;
+			auto l_it = std::lower_bound( l_children.begin(), l_children.end(), std::make_pair( value, uint32_t( 0 ) ) );
+			return ( l_it != l_children.end() && l_it->first == value ) ? l_it->second : 0;
+		}
+
+		/** Retrieves the automaton state following a node, for a character
+		*/
+		uint32_t DoGetNext( uint32_t node, CharType value )const
+		{
+			uint32_t l_child = DoGetChild( node, value );
+
+			while ( l_child == 0 && node != 0 )
+			{
+				node = m_nodes[node].m_fail;
+				l_child = DoGetChild( node, value );
+			}
+
+			return l_child;
+		}
+
+		/** Appends characters to a string output
+		*/
+		static void DoWrite( string_type & output, size_t & written, CharType const * data, size_t size )
+		{
+			output.append( data, size );
+			written += size;
+		}
+
+		/** Writes characters to an in place output
+		*/
+		static void DoWrite( CharType * output, size_t & written, CharType const * data, size_t size )
+		{
+			std::char_traits< CharType >::move( output + written, data, size );
+			written += size;
+		}
+
+		/** Replaces the patterns
+		@param[in] str
+			The input string
+		@param[out] output
+			The output, a string or the input buffer itself
+		@return
+			The output size.
+		*/
+		template< typename OutputType >
+		size_t DoReplace( string_type const & str, OutputType && output )const
+		{
+			CharType const * l_input = str.data();
+			size_t l_size = str.size();
+			size_t l_position = 0;
+			size_t l_consumed = 0;
+			size_t l_written = 0;
+			uint32_t l_state = 0;
+			SMatch l_pending = { 0, NO_PATTERN };
+
+			while ( true )
+			{
+				bool l_commit = false;
+
+				if ( l_position == l_size )
+				{
+					if ( l_pending.m_pattern == NO_PATTERN )
+					{
+						break;
+					}
+
+					l_commit = true;
+				}
+				else
+				{
+					l_state = DoGetNext( l_state, l_input[l_position++] );
+					SNode const & l_node = m_nodes[l_state];
+
+					if ( l_node.m_output != NO_PATTERN )
+					{
+						//!@remarks The longest match ending here starts the earliest, it supersedes a pending match starting at the same position or after.
+						size_t l_start = l_position - m_patterns[l_node.m_output].m_length;
+
+						if ( l_pending.m_pattern == NO_PATTERN || l_start <= l_pending.m_start )
+						{
+							l_pending = { l_start, l_node.m_output };
+						}
+					}
+
+					//!@remarks The pending match is final once no match in progress can start at or before it.
+					l_commit = l_pending.m_pattern != NO_PATTERN && l_pending.m_start + l_node.m_depth < l_position;
+				}
+
+				if ( l_commit )
+				{
+					SPattern const & l_pattern = m_patterns[l_pending.m_pattern];
+					DoWrite( output, l_written, l_input + l_consumed, l_pending.m_start - l_consumed );
+					DoWrite( output, l_written, l_pattern.m_replacement.data(), l_pattern.m_replacement.size() );
+					//!@remarks The characters read after the match are searched again, from the root.
+					l_consumed = l_pending.m_start + l_pattern.m_length;
+					l_position = l_consumed;
+					l_state = 0;
+					l_pending.m_pattern = NO_PATTERN;
+				}
+			}
+
+			DoWrite( output, l_written, l_input + l_consumed, l_size - l_consumed );
+			return l_written;
+		}
+
+	private:
+		//! The automaton nodes, the first one is the root
+		std::vector< SNode > m_nodes;
+		//! The patterns
+		std::vector< SPattern > m_patterns;
+		//! Tells if the strings are rewritten in place
+		bool m_inPlace;
+	};
+
+	typedef CBasicReplacer< char > CReplacer;
+	typedef CBasicReplacer< wchar_t > CWReplacer;
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif
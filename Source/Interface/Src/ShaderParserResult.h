@@ -0,0 +1,203 @@
+/************************************************************************//**
+* @file ShaderParserResult.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief CResult class
+*
+* @details The result of the non throwing Try* functions: a value, or an
+*	error code with a message built only when it is requested.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_RESULT_H___
+#define ___SHADER_PARSER_RESULT_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include "ShaderParserException.h"
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** The result of an operation which can fail, without throwing.
+	@remarks
+		Holds either a value, or an error code from EShaderParserExceptionCodes.
+		The error message is only built when GetErrorMessage is called, from the partial value
+		given by the failed operation and an argument, so rejected inputs cost neither an exception nor a formatting.
+		The value type must be default constructible.
+	*/
+	template< typename T >
+	class CResult
+	{
+	public:
+		/** Builds the error message of a failure.
+		@param[in] partial
+			The partial value given by the failed operation
+		@param[in] argument
+			The failure argument
+		@return
+			The message.
+		*/
+		typedef String ( *MessageBuilder )( T const & partial, String const & argument );
+
+	public:
+		/** Creates a successful result
+		@param[in] value
+			The value
+		@return
+			The result.
+		*/
+		static CResult Success( T value )
+		{
+			CResult l_result;
+			l_result.m_value = std::move( value );
+			return l_result;
+		}
+
+		/** Creates a failed result
+		@param[in] code
+			The error code
+		@param[in] partial
+			The partial value given by the failed operation
+		@param[in] argument
+			The failure argument, given to the message builder
+		@param[in] builder
+			The message builder
+		@return
+			The result.
+		*/
+		static CResult Failure( EShaderParserExceptionCodes code, T partial, String argument, MessageBuilder builder )
+		{
+			CResult l_result;
+			l_result.m_value = std::move( partial );
+			l_result.m_success = false;
+			l_result.m_code = code;
+			l_result.m_argument = std::move( argument );
+			l_result.m_builder = builder;
+			return l_result;
+		}
+
+		/** Tells if the operation succeeded
+		@return
+			\p true if the result holds a value.
+		*/
+		bool HasValue()const
+		{
+			return m_success;
+		}
+
+		/** Tells if the operation succeeded
+		@return
+			\p true if the result holds a value.
+		*/
+		explicit operator bool()const
+		{
+			return m_success;
+		}
+
+		/** Retrieves the value
+		@return
+			The value.
+		@throws CShaderParserException
+			With the error code and message, if the operation failed.
+		*/
+		T & GetValue()
+		{
+			DoCheckValue();
+			return m_value;
+		}
+
+		/** Retrieves the value
+		@return
+			The value.
+		@throws CShaderParserException
+			With the error code and message, if the operation failed.
+		*/
+		T const & GetValue()const
+		{
+			DoCheckValue();
+			return m_value;
+		}
+
+		/** Retrieves the value, or the partial value given by the failed operation
+		@return
+			The value.
+		*/
+		T & GetPartialValue()
+		{
+			return m_value;
+		}
+
+		/** Retrieves the value, or the partial value given by the failed operation
+		@return
+			The value.
+		*/
+		T const & GetPartialValue()const
+		{
+			return m_value;
+		}
+
+		/** Retrieves the error code
+		@return
+			The code, EShaderParserExceptionCodes_LastCode if the operation succeeded.
+		*/
+		EShaderParserExceptionCodes GetError()const
+		{
+			return m_code;
+		}
+
+		/** Retrieves the error message, built on the first call
+		@return
+			The message, empty if the operation succeeded.
+		*/
+		String const & GetErrorMessage()const
+		{
+			if ( !m_success && m_message.empty() && m_builder )
+			{
+				m_message = m_builder( m_value, m_argument );
+			}
+
+			return m_message;
+		}
+
+	private:
+		/** Constructor, successful result with a default value
+		*/
+		CResult()
+			: m_value()
+			, m_success( true )
+			, m_code( EShaderParserExceptionCodes_LastCode )
+			, m_builder( NULL )
+		{
+		}
+
+		/** Throws the error, if the operation failed
+		*/
+		void DoCheckValue()const
+		{
+			if ( !m_success )
+			{
+				PARSER_EXCEPT( m_code, GetErrorMessage() );
+			}
+		}
+
+	private:
+		//! The value, or the partial value given by the failed operation
+		T m_value;
+		//! Tells if the operation succeeded
+		bool m_success;
+		//! The error code
+		EShaderParserExceptionCodes m_code;
+		//! The failure argument
+		String m_argument;
+		//! The error message builder
+		MessageBuilder m_builder;
+		//! The error message, built on demand
+		mutable String m_message;
+	};
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif // ___SHADER_PARSER_RESULT_H___
@@ -13,13 +13,16 @@
 
 #include "ShaderParserStringUtils.h"
 
-#include "ShaderParserBlockGuard.h"
 #include "ShaderParserException.h"
 #include "ShaderParserLogger.h"
+#include "ShaderParserReplacer.h"
 
 #include <boost/locale.hpp>
 
-#include <clocale>
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#	define SHADER_PARSER_HAS_SSE2 1
+#	include <emmintrin.h>
+#endif
 
 BEGIN_NAMESPACE_SHADER_PARSER
 {
@@ -28,196 +31,294 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		namespace detail
 		{
 			static const String ERROR_DB_FORMALIZE = STR( "Error while formatting: " );
-			static const String ERROR_DB_CONVERSION = STR( "Error while performing a strings conversion: " );
 
-			static const String INFO_UNKNOWN = STR( "UNKNOWN" );
-			std::mutex g_conversionMutex;
+			//! The replacement character, for the invalid sequences
+			static const char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+			/** Decodes the UTF-8 non ASCII sequence starting at the given index
+			@param[in] src
+				The buffer
+			@param[in] size
+				The buffer size
+			@param index
+				The sequence index, receives the index following it
+			@return
+				The code point, REPLACEMENT_CHARACTER if the sequence is invalid.
+			*/
+			char32_t utf8_decode( char const * src, size_t size, size_t & index )
+			{
+				uint8_t l_lead = uint8_t( src[index++] );
+				size_t l_count;
+				char32_t l_result;
+				char32_t l_min;
 
-#if !defined( _MSC_VER )
+				if ( l_lead >= 0xC2 && l_lead <= 0xDF )
+				{
+					l_count = 1;
+					l_result = l_lead & 0x1F;
+					l_min = 0x80;
+				}
+				else if ( l_lead >= 0xE0 && l_lead <= 0xEF )
+				{
+					l_count = 2;
+					l_result = l_lead & 0x0F;
+					l_min = 0x800;
+				}
+				else if ( l_lead >= 0xF0 && l_lead <= 0xF4 )
+				{
+					l_count = 3;
+					l_result = l_lead & 0x07;
+					l_min = 0x10000;
+				}
+				else
+				{
+					return REPLACEMENT_CHARACTER;
+				}
 
-			template< typename OutChar, typename InChar >
-			std::basic_string< OutChar > str_convert( std::basic_string< InChar > const & )
-			{
-			//	static_assert( false, "Not implemented" );
+				for ( size_t i = 0; i < l_count; ++i )
+				{
+					if ( index == size || ( uint8_t( src[index] ) & 0xC0 ) != 0x80 )
+					{
+						//!@remarks The truncated sequence is replaced, the following byte is decoded on its own.
+						return REPLACEMENT_CHARACTER;
+					}
+
+					l_result = ( l_result << 6 ) | ( uint8_t( src[index++] ) & 0x3F );
+				}
+
+				if ( l_result < l_min || l_result > 0x10FFFF || ( l_result >= 0xD800 && l_result <= 0xDFFF ) )
+				{
+					return REPLACEMENT_CHARACTER;
+				}
+
+				return l_result;
 			}
 
-			template<>
-			std::basic_string< wchar_t > str_convert< wchar_t, char >( std::basic_string< char > const & src )
+			/** Encodes a code point in UTF-8
+			@param[in] codePoint
+				The code point
+			@param[out] dst
+				Receives the code units
+			@return
+				The code units count.
+			*/
+			size_t utf8_encode( char32_t codePoint, char * dst )
 			{
-				std::basic_string< wchar_t > dst;
+				if ( codePoint > 0x10FFFF || ( codePoint >= 0xD800 && codePoint <= 0xDFFF ) )
+				{
+					codePoint = REPLACEMENT_CHARACTER;
+				}
 
-				if ( !src.empty() )
+				if ( codePoint < 0x80 )
 				{
-					try
-					{
-						std::unique_lock< std::mutex > lock( g_conversionMutex );
-						char * szloc = setlocale( LC_CTYPE, "" );
-						mbtowc( NULL, NULL, 0 );
-						size_t max = src.size();
-						int length = 1;
-						const char * in = src.c_str();
-						dst.reserve( src.size() );
-
-						while ( max > 0 && length >= 1 )
-						{
-							wchar_t wc;
-							length = mbtowc( &wc, in, max );
+					dst[0] = char( codePoint );
+					return 1;
+				}
 
-							if ( length >= 1 )
-							{
-								dst += wc;
-								max -= length;
-								in += length;
-							}
-						}
+				if ( codePoint < 0x800 )
+				{
+					dst[0] = char( 0xC0 | ( codePoint >> 6 ) );
+					dst[1] = char( 0x80 | ( codePoint & 0x3F ) );
+					return 2;
+				}
 
-						setlocale( LC_CTYPE, szloc );
-					}
-					catch ( std::exception & exc )
-					{
-						CLogger::LogError( StringStream() << ERROR_DB_CONVERSION << exc.what() );
-					}
-					catch ( ... )
-					{
-						CLogger::LogError( StringStream() << ERROR_DB_CONVERSION << INFO_UNKNOWN );
-					}
+				if ( codePoint < 0x10000 )
+				{
+					dst[0] = char( 0xE0 | ( codePoint >> 12 ) );
+					dst[1] = char( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+					dst[2] = char( 0x80 | ( codePoint & 0x3F ) );
+					return 3;
 				}
 
-				return std::move( dst );
+				dst[0] = char( 0xF0 | ( codePoint >> 18 ) );
+				dst[1] = char( 0x80 | ( ( codePoint >> 12 ) & 0x3F ) );
+				dst[2] = char( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+				dst[3] = char( 0x80 | ( codePoint & 0x3F ) );
+				return 4;
 			}
 
-			template<>
-			std::basic_string< char > str_convert< char, wchar_t >( std::basic_string< wchar_t > const & src )
+			/** Encodes a code point in UTF-16
+			*/
+			template< typename CharT >
+			size_t wide_encode( char32_t codePoint, CharT * dst, std::integral_constant< size_t, 2 > )
 			{
-				std::basic_string< char > dst;
-
-				if ( !src.empty() )
+				if ( codePoint >= 0x10000 )
 				{
-					try
-					{
-						std::unique_lock< std::mutex > lock( g_conversionMutex );
-						std::string szloc = setlocale( LC_CTYPE, "" );
-						size_t max = src.size();
-						int length = 1;
-						const wchar_t * in = src.c_str();
-						char buffer[32] = { 0 };
-						dst.reserve( 1 + src.size() * 2 );
-
-						while ( *in && length >= 1 )
-						{
-							length = wctomb( buffer, *in );
+					codePoint -= 0x10000;
+					dst[0] = CharT( 0xD800 | ( codePoint >> 10 ) );
+					dst[1] = CharT( 0xDC00 | ( codePoint & 0x3FF ) );
+					return 2;
+				}
 
-							if ( length >= 1 )
-							{
-								dst += buffer;
-								in++;
-							}
-						}
+				dst[0] = CharT( codePoint );
+				return 1;
+			}
 
-						setlocale( LC_CTYPE, szloc.c_str() );
-					}
-					catch ( std::exception & exc )
-					{
-						CLogger::LogError( StringStream() << ERROR_DB_CONVERSION << exc.what() );
-					}
-					catch ( ... )
+			/** Encodes a code point in UTF-32
+			*/
+			template< typename CharT >
+			size_t wide_encode( char32_t codePoint, CharT * dst, std::integral_constant< size_t, 4 > )
+			{
+				dst[0] = CharT( codePoint );
+				return 1;
+			}
+
+			/** Decodes the UTF-16 non ASCII code point starting at the given index
+			*/
+			template< typename CharT >
+			char32_t wide_decode( CharT const * src, size_t size, size_t & index, std::integral_constant< size_t, 2 > )
+			{
+				char32_t l_result = char32_t( uint16_t( src[index++] ) );
+
+				if ( l_result >= 0xD800 && l_result <= 0xDBFF && index < size )
+				{
+					char32_t l_low = char32_t( uint16_t( src[index] ) );
+
+					if ( l_low >= 0xDC00 && l_low <= 0xDFFF )
 					{
-						CLogger::LogError( StringStream() << ERROR_DB_CONVERSION << INFO_UNKNOWN );
+						++index;
+						return 0x10000 + ( ( l_result - 0xD800 ) << 10 ) + ( l_low - 0xDC00 );
 					}
 				}
 
-				return std::move( dst );
+				//!@remarks The unpaired surrogates are replaced by utf8_encode.
+				return l_result;
 			}
 
-#else
-
-			template< typename OutChar, typename InChar >
-			std::basic_string< OutChar > str_convert( std::basic_string< InChar > const & )
+			/** Decodes the UTF-32 non ASCII code point starting at the given index
+			*/
+			template< typename CharT >
+			char32_t wide_decode( CharT const * src, size_t /*size*/, size_t & index, std::integral_constant< size_t, 4 > )
 			{
-				static_assert( false, "Not implemented" );
+				return char32_t( src[index++] );
 			}
 
-			template<>
-			std::basic_string< wchar_t > str_convert< wchar_t, char >( std::basic_string< char > const & src )
+			/** Converts a UTF-8 string to UTF-16 or UTF-32, depending on the size of CharT
+			*/
+			template< typename CharT >
+			std::basic_string< CharT > utf8_to_wide( std::string const & src )
 			{
-				std::basic_string< wchar_t > dst;
+				typedef std::integral_constant< size_t, sizeof( CharT ) > l_unit;
+				std::basic_string< CharT > l_result;
 
 				if ( !src.empty() )
 				{
-					std::unique_lock< std::mutex > lock( g_conversionMutex );
-					char * szloc = setlocale( LC_CTYPE, "" );
-					size_t size = mbstowcs( NULL, src.c_str(), 0 ) + 1;
-					wchar_t * buffer = NULL;
+					//!@remarks A code point never takes more UTF-16 or UTF-32 units than UTF-8 ones.
+					l_result.resize( src.size() );
+					CharT * l_dst = &l_result[0];
+					char const * l_src = src.data();
+					size_t l_size = src.size();
+					size_t l_index = 0;
+					size_t l_written = 0;
+
+					while ( l_index < l_size )
 					{
-						auto guard = make_block_guard( [&buffer, &size]()
-						{
-							buffer = new wchar_t[size + 1];
-						}, [&buffer]()
+						size_t l_ascii = l_index + AsciiLength( l_src + l_index, l_size - l_index );
+
+						for ( ; l_index < l_ascii; ++l_index )
 						{
-							delete [] buffer;
-						} );
+							l_dst[l_written++] = CharT( l_src[l_index] );
+						}
 
-						size = std::min( size, mbstowcs( buffer, src.c_str(), size ) );
-						setlocale( LC_CTYPE, szloc );
-						dst.assign( buffer, buffer + size );
+						if ( l_index < l_size )
+						{
+							l_written += wide_encode( utf8_decode( l_src, l_size, l_index ), l_dst + l_written, l_unit() );
+						}
 					}
+
+					l_result.resize( l_written );
 				}
 
-				return dst;
+				return l_result;
 			}
 
-			template<>
-			std::basic_string< char > str_convert< char, wchar_t >( std::basic_string< wchar_t > const & src )
+			/** Converts a UTF-16 or UTF-32 string, depending on the size of CharT, to UTF-8
+			*/
+			template< typename CharT >
+			std::string wide_to_utf8( std::basic_string< CharT > const & src )
 			{
-				std::basic_string< char > dst;
+				typedef std::integral_constant< size_t, sizeof( CharT ) > l_unit;
+				std::string l_result;
 
 				if ( !src.empty() )
 				{
-					std::unique_lock< std::mutex > lock( g_conversionMutex );
-					char * szloc = setlocale( LC_CTYPE, "" );
-					size_t size = wcstombs( NULL, src.c_str(), 0 ) + 1;
-					char * buffer = NULL;
+					//!@remarks A UTF-16 unit gives at most 3 UTF-8 units, a UTF-32 one gives at most 4.
+					l_result.resize( src.size() * ( sizeof( CharT ) == 2 ? 3 : 4 ) );
+					char * l_dst = &l_result[0];
+					CharT const * l_src = src.data();
+					size_t l_size = src.size();
+					size_t l_index = 0;
+					size_t l_written = 0;
+
+					while ( l_index < l_size )
 					{
-						auto guard = make_block_guard( [&buffer, &size]()
+						while ( l_index < l_size && uint32_t( l_src[l_index] ) < 0x80 )
 						{
-							buffer = new char[size + 1];
-						}, [&buffer]()
-						{
-							delete [] buffer;
-						} );
+							l_dst[l_written++] = char( l_src[l_index++] );
+						}
 
-						size = std::min( size, wcstombs( buffer, src.c_str(), size ) );
-						setlocale( LC_CTYPE, szloc );
-						dst.assign( buffer, buffer + size );
+						if ( l_index < l_size )
+						{
+							l_written += utf8_encode( wide_decode( l_src, l_size, l_index, l_unit() ), l_dst + l_written );
+						}
 					}
+
+					l_result.resize( l_written );
 				}
 
-				return dst;
+				return l_result;
 			}
 
-#endif
+			/** Tells if a charset name designates UTF-8
+			*/
+			bool is_utf8( std::string const & charset )
+			{
+				std::string l_charset;
+
+				for ( auto l_char : charset )
+				{
+					if ( l_char != '-' && l_char != '_' )
+					{
+						l_charset.push_back( char( std::tolower( uint8_t( l_char ) ) ) );
+					}
+				}
+
+				return l_charset == "utf8";
+			}
 
 			template< typename CharType >
 			std::basic_string< CharType > & str_replace( std::basic_string< CharType > & p_str, std::basic_string< CharType > const & p_find, std::basic_string< CharType > const & p_replaced )
 			{
 				typedef std::basic_string< CharType > string_t;
+
+				if ( p_find.empty() )
+				{
+					return p_str;
+				}
+
+				if ( p_find.size() == 1 && p_replaced.size() == 1 )
+				{
+					std::replace( p_str.begin(), p_str.end(), p_find[0], p_replaced[0] );
+					return p_str;
+				}
+
 				string_t l_return;
 				std::size_t	l_currentPos = 0;
 				std::size_t	l_pos = 0;
 
 				while ( ( l_pos = p_str.find( p_find, l_currentPos ) ) != string_t::npos )
 				{
-					l_return.append( p_str.substr( l_currentPos, l_pos - l_currentPos ) );
+					l_return.append( p_str, l_currentPos, l_pos - l_currentPos );
 					l_return.append( p_replaced );
 					l_currentPos = l_pos + p_find.size();
 				}
 
-				if ( l_currentPos != p_str.size() )
+				if ( l_currentPos )
 				{
-					l_return.append( p_str.substr( l_currentPos, l_pos - l_currentPos ) );
+					l_return.append( p_str, l_currentPos, string_t::npos );
+					p_str.swap( l_return );
 				}
 
-				p_str = l_return;
 				return p_str;
 			}
 
@@ -346,34 +447,257 @@ BEGIN_NAMESPACE_SHADER_PARSER
 				return p_str;
 			}
 
-			template< typename CharType >
-			std::basic_string< CharType > str_upper( std::basic_string< CharType > const & p_str )
+#if defined( SHADER_PARSER_HAS_SSE2 )
+
+			/** Retrieves the letters to convert in a block of 16 ASCII characters
+			@return
+				0xFF for each lower case letter if Upper is true, for each upper case letter if it is false, 0 for the others.
+			*/
+			template< bool Upper >
+			__m128i ascii_letters( __m128i block )
 			{
-				typedef std::basic_string< CharType > string_t;
-				string_t l_strReturn;
-				std::locale loc;
+				//!@remarks The ASCII characters are positive, so the signed comparisons are correct.
+				__m128i const l_before = _mm_set1_epi8( Upper ? 'a' - 1 : 'A' - 1 );
+				__m128i const l_after = _mm_set1_epi8( Upper ? 'z' + 1 : 'Z' + 1 );
+				return _mm_and_si128( _mm_cmpgt_epi8( block, l_before ), _mm_cmplt_epi8( block, l_after ) );
+			}
+
+#endif
+
+			/** Retrieves the letters to convert in a block of 8 ASCII characters
+			@return
+				0x80 for each lower case letter if Upper is true, for each upper case letter if it is false, 0 for the others.
+			*/
+			template< bool Upper >
+			uint64_t ascii_letters( uint64_t block )
+			{
+				//!@remarks The characters are below 0x80, so the additions don't carry from one byte to the next.
+				static const uint64_t l_ones = 0x0101010101010101ULL;
+				uint64_t l_fromFirst = block + l_ones * ( 0x80 - ( Upper ? 'a' : 'A' ) );
+				uint64_t l_fromLast = block + l_ones * ( 0x80 - ( Upper ? 'z' : 'Z' ) - 1 );
+				return l_fromFirst & ~l_fromLast & 0x8080808080808080ULL;
+			}
+
+			/** Tells if an ASCII character is a letter to convert
+			@return
+				\p true for a lower case letter if Upper is true, for an upper case letter if it is false.
+			*/
+			template< bool Upper >
+			bool ascii_letter( uint32_t value )
+			{
+				return Upper ? ( value >= 'a' && value <= 'z' ) : ( value >= 'A' && value <= 'Z' );
+			}
 
-				for ( std::size_t i = 0; i < p_str.size(); i++ )
+			/** Converts the case of the ASCII characters at the beginning of a buffer, 16 or 8 at once
+			@param[in,out] str
+				The buffer
+			@param[in] size
+				The buffer size
+			@return
+				The index of the first non ASCII character, size if there is none.
+			*/
+			template< bool Upper >
+			size_t ascii_convert_case( char * str, size_t size )
+			{
+				size_t l_index = 0;
+
+#if defined( SHADER_PARSER_HAS_SSE2 )
+
+				__m128i const l_flip = _mm_set1_epi8( 0x20 );
+
+				for ( ; l_index + 16 <= size; l_index += 16 )
 				{
-					l_strReturn += std::toupper( p_str[i], loc );
+					__m128i l_block = _mm_loadu_si128( reinterpret_cast< __m128i const * >( str + l_index ) );
+
+					if ( _mm_movemask_epi8( l_block ) )
+					{
+						break;
+					}
+
+					l_block = _mm_xor_si128( l_block, _mm_and_si128( ascii_letters< Upper >( l_block ), l_flip ) );
+					_mm_storeu_si128( reinterpret_cast< __m128i * >( str + l_index ), l_block );
 				}
 
-				return l_strReturn;
+#endif
+
+				for ( ; l_index + 8 <= size; l_index += 8 )
+				{
+					uint64_t l_block;
+					std::memcpy( &l_block, str + l_index, sizeof( l_block ) );
+
+					if ( l_block & 0x8080808080808080ULL )
+					{
+						break;
+					}
+
+					l_block ^= ascii_letters< Upper >( l_block ) >> 2;
+					std::memcpy( str + l_index, &l_block, sizeof( l_block ) );
+				}
+
+				for ( ; l_index < size && !( uint8_t( str[l_index] ) & 0x80 ); ++l_index )
+				{
+					if ( ascii_letter< Upper >( uint8_t( str[l_index] ) ) )
+					{
+						str[l_index] ^= 0x20;
+					}
+				}
+
+				return l_index;
 			}
 
-			template< typename CharType >
-			std::basic_string< CharType > str_lower( std::basic_string< CharType > const & p_str )
+			/** Converts the case of the ASCII characters at the beginning of a buffer
+			@param[in,out] str
+				The buffer
+			@param[in] size
+				The buffer size
+			@return
+				The index of the first non ASCII character, size if there is none.
+			*/
+			template< bool Upper >
+			size_t ascii_convert_case( wchar_t * str, size_t size )
 			{
-				typedef std::basic_string< CharType > string_t;
-				string_t l_strReturn;
-				std::locale loc;
+				size_t l_index = 0;
 
-				for ( std::size_t i = 0; i < p_str.size(); i++ )
+				for ( ; l_index < size && uint32_t( str[l_index] ) < 0x80; ++l_index )
 				{
-					l_strReturn += std::tolower( p_str[i], loc );
+					if ( ascii_letter< Upper >( uint32_t( str[l_index] ) ) )
+					{
+						str[l_index] ^= 0x20;
+					}
 				}
 
-				return l_strReturn;
+				return l_index;
+			}
+
+			/** Finds the first letter to convert, or non ASCII character, in a buffer, looking at 16 or 8 characters at once
+			@param[in] str
+				The buffer
+			@param[in] size
+				The buffer size
+			@return
+				The character index, size if there is none.
+			*/
+			template< bool Upper >
+			size_t ascii_find_letter( char const * str, size_t size )
+			{
+				size_t l_index = 0;
+
+#if defined( SHADER_PARSER_HAS_SSE2 )
+
+				for ( ; l_index + 16 <= size; l_index += 16 )
+				{
+					__m128i l_block = _mm_loadu_si128( reinterpret_cast< __m128i const * >( str + l_index ) );
+
+					if ( _mm_movemask_epi8( _mm_or_si128( l_block, ascii_letters< Upper >( l_block ) ) ) )
+					{
+						break;
+					}
+				}
+
+#endif
+
+				for ( ; l_index + 8 <= size; l_index += 8 )
+				{
+					uint64_t l_block;
+					std::memcpy( &l_block, str + l_index, sizeof( l_block ) );
+
+					if ( ( l_block & 0x8080808080808080ULL ) || ascii_letters< Upper >( l_block ) )
+					{
+						break;
+					}
+				}
+
+				while ( l_index < size && !( uint8_t( str[l_index] ) & 0x80 ) && !ascii_letter< Upper >( uint8_t( str[l_index] ) ) )
+				{
+					++l_index;
+				}
+
+				return l_index;
+			}
+
+			/** Finds the first letter to convert, or non ASCII character, in a buffer
+			@param[in] str
+				The buffer
+			@param[in] size
+				The buffer size
+			@return
+				The character index, size if there is none.
+			*/
+			template< bool Upper >
+			size_t ascii_find_letter( wchar_t const * str, size_t size )
+			{
+				size_t l_index = 0;
+
+				while ( l_index < size && uint32_t( str[l_index] ) < 0x80 && !ascii_letter< Upper >( uint32_t( str[l_index] ) ) )
+				{
+					++l_index;
+				}
+
+				return l_index;
+			}
+
+			/** Converts the case of a character, using the locale
+			*/
+			template< bool Upper, typename CharType >
+			CharType locale_convert_case( CharType value, std::locale const & loc )
+			{
+				return Upper ? std::toupper( value, loc ) : std::tolower( value, loc );
+			}
+
+			/** Converts a string to upper or lower case, in place.
+			@remarks
+				The ASCII characters are converted without the locale, which is only used for the other ones.
+			*/
+			template< bool Upper, typename CharType >
+			std::basic_string< CharType > & str_convert_case( std::basic_string< CharType > & p_str )
+			{
+				CharType * l_str = &p_str[0];
+				size_t l_size = p_str.size();
+				size_t l_index = ascii_convert_case< Upper >( l_str, l_size );
+
+				if ( l_index < l_size )
+				{
+					std::locale l_loc;
+
+					while ( l_index < l_size )
+					{
+						l_str[l_index] = locale_convert_case< Upper >( l_str[l_index], l_loc );
+						++l_index;
+						l_index += ascii_convert_case< Upper >( l_str + l_index, l_size - l_index );
+					}
+				}
+
+				return p_str;
+			}
+
+			/** Tells if a string is in upper or lower case, meaning converting it would not change it.
+			@remarks
+				The ASCII characters are tested without the locale, which is only used for the other ones.
+			*/
+			template< bool Upper, typename CharType >
+			bool str_is_case( std::basic_string< CharType > const & p_str )
+			{
+				CharType const * l_str = p_str.data();
+				size_t l_size = p_str.size();
+				size_t l_index = ascii_find_letter< Upper >( l_str, l_size );
+
+				if ( l_index < l_size )
+				{
+					std::locale l_loc;
+
+					while ( l_index < l_size )
+					{
+						if ( uint32_t( l_str[l_index] ) < 0x80 || locale_convert_case< Upper >( l_str[l_index], l_loc ) != l_str[l_index] )
+						{
+							return false;
+						}
+
+						++l_index;
+						l_index += ascii_find_letter< Upper >( l_str + l_index, l_size - l_index );
+					}
+				}
+
+				return true;
 			}
 
 			template< typename CharType > size_t str_vprintf( CharType * out, size_t max, const CharType * format, va_list vaList );
@@ -417,66 +741,70 @@ BEGIN_NAMESPACE_SHADER_PARSER
 
 		bool IsUpperCase( const std::string & p_strToTest )
 		{
-			return p_strToTest == detail::str_upper( p_strToTest );
+			return detail::str_is_case< true >( p_strToTest );
 		}
 
 		bool IsLowerCase( const std::string & p_strToTest )
 		{
-			return p_strToTest == detail::str_lower( p_strToTest );
+			return detail::str_is_case< false >( p_strToTest );
 		}
 
 		bool IsUpperCase( const std::wstring & p_strToTest )
 		{
-			return p_strToTest == detail::str_upper( p_strToTest );
+			return detail::str_is_case< true >( p_strToTest );
 		}
 
 		bool IsLowerCase( const std::wstring & p_strToTest )
 		{
-			return p_strToTest == detail::str_lower( p_strToTest );
+			return detail::str_is_case< false >( p_strToTest );
 		}
 
 		std::string UpperCase( const std::string & p_str )
 		{
-			return detail::str_upper( p_str );
+			std::string l_result( p_str );
+			detail::str_convert_case< true >( l_result );
+			return l_result;
 		}
 
 		std::string LowerCase( const std::string & p_str )
 		{
-			return detail::str_lower( p_str );
+			std::string l_result( p_str );
+			detail::str_convert_case< false >( l_result );
+			return l_result;
 		}
 
 		std::wstring UpperCase( const std::wstring & p_str )
 		{
-			return detail::str_upper( p_str );
+			std::wstring l_result( p_str );
+			detail::str_convert_case< true >( l_result );
+			return l_result;
 		}
 
 		std::wstring LowerCase( const std::wstring & p_str )
 		{
-			return detail::str_lower( p_str );
+			std::wstring l_result( p_str );
+			detail::str_convert_case< false >( l_result );
+			return l_result;
 		}
 
 		std::string & ToUpperCase( std::string & p_str )
 		{
-			p_str = detail::str_upper( p_str );
-			return p_str;
+			return detail::str_convert_case< true >( p_str );
 		}
 
 		std::string & ToLowerCase( std::string & p_str )
 		{
-			p_str = detail::str_lower( p_str );
-			return p_str;
+			return detail::str_convert_case< false >( p_str );
 		}
 
 		std::wstring & ToUpperCase( std::wstring & p_str )
 		{
-			p_str = detail::str_upper( p_str );
-			return p_str;
+			return detail::str_convert_case< true >( p_str );
 		}
 
 		std::wstring & ToLowerCase( std::wstring & p_str )
 		{
-			p_str = detail::str_lower( p_str );
-			return p_str;
+			return detail::str_convert_case< false >( p_str );
 		}
 
 		std::vector< std::string > Split( const std::string & p_str, const std::string & p_delims, uint32_t p_maxSplits, bool p_bKeepVoid )
@@ -547,6 +875,16 @@ BEGIN_NAMESPACE_SHADER_PARSER
 			return detail::str_replace( p_str, p_find, p_replaced );
 		}
 
+		std::string & ReplaceAll( std::string & str, std::map< std::string, std::string > const & replacements )
+		{
+			return CReplacer( replacements ).Replace( str );
+		}
+
+		std::wstring & ReplaceAll( std::wstring & str, std::map< std::wstring, std::wstring > const & replacements )
+		{
+			return CWReplacer( replacements ).Replace( str );
+		}
+
 		void Formalize( std::string & formattedString, int maxSize, const char * format, ... )
 		{
 			formattedString.clear();
@@ -573,14 +911,79 @@ BEGIN_NAMESPACE_SHADER_PARSER
 			}
 		}
 
+		size_t AsciiLength( char const * src, size_t size )
+		{
+			size_t l_index = 0;
+
+#if defined( SHADER_PARSER_HAS_SSE2 )
+
+			for ( ; l_index + 16 <= size; l_index += 16 )
+			{
+				if ( _mm_movemask_epi8( _mm_loadu_si128( reinterpret_cast< __m128i const * >( src + l_index ) ) ) )
+				{
+					break;
+				}
+			}
+
+#endif
+
+			for ( ; l_index + 8 <= size; l_index += 8 )
+			{
+				uint64_t l_block;
+				std::memcpy( &l_block, src + l_index, sizeof( l_block ) );
+
+				if ( l_block & 0x8080808080808080ULL )
+				{
+					break;
+				}
+			}
+
+			while ( l_index < size && !( uint8_t( src[l_index] ) & 0x80 ) )
+			{
+				++l_index;
+			}
+
+			return l_index;
+		}
+
+		std::u16string Utf8ToUtf16( std::string const & src )
+		{
+			return detail::utf8_to_wide< char16_t >( src );
+		}
+
+		std::u32string Utf8ToUtf32( std::string const & src )
+		{
+			return detail::utf8_to_wide< char32_t >( src );
+		}
+
+		std::string Utf16ToUtf8( std::u16string const & src )
+		{
+			return detail::wide_to_utf8( src );
+		}
+
+		std::string Utf32ToUtf8( std::u32string const & src )
+		{
+			return detail::wide_to_utf8( src );
+		}
+
 		std::string ToStr( const std::wstring & src, const std::string & charset )
 		{
-			return detail::str_convert< char >( src );
+			if ( detail::is_utf8( charset ) )
+			{
+				return detail::wide_to_utf8( src );
+			}
+
+			return boost::locale::conv::from_utf( src, charset );
 		}
 
 		std::wstring ToWStr( const std::string & src, const std::string & charset )
 		{
-			return detail::str_convert< wchar_t >( src );
+			if ( detail::is_utf8( charset ) )
+			{
+				return detail::utf8_to_wide< wchar_t >( src );
+			}
+
+			return boost::locale::conv::to_utf< wchar_t >( src, charset );
 		}
 
 		String ToString( char p_char )
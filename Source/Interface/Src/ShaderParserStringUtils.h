@@ -14,6 +14,8 @@
 
 #include "ShaderParserPrerequisites.h"
 
+#include "ShaderParserStringView.h"
+
 BEGIN_NAMESPACE_SHADER_PARSER
 {
 	/** String functions class
@@ -144,6 +146,74 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		*/
 		ShaderParserExport std::vector< std::wstring > Split( const std::wstring & str, const std::wstring & p_delims, uint32_t p_maxSplits = 10, bool p_bKeepVoid = true );
 
+		/** Lazily cuts a string into substrings, using a delimiter
+		@remarks
+			Nothing is allocated, the substrings are views over the string, which must outlive the returned range.
+		@param[in] str
+			The string to cut
+		@param[in] delim
+			The delimiter
+		@param[in] keepVoid
+			Tells if the function keeps void substrings or not
+		@return
+			The range over the substrings
+		*/
+		inline CSplitView< char > SplitView( StringView const & str, char delim, bool keepVoid = true )
+		{
+			return CSplitView< char >( str, delim, keepVoid );
+		}
+
+		/** Lazily cuts a string into substrings, using delimiters
+		@remarks
+			Nothing is allocated, the substrings are views over the string, which must outlive the returned range, as the delimiters.
+		@param[in] str
+			The string to cut
+		@param[in] delims
+			The delimiters
+		@param[in] keepVoid
+			Tells if the function keeps void substrings or not
+		@return
+			The range over the substrings
+		*/
+		inline CSplitView< char > SplitView( StringView const & str, StringView const & delims, bool keepVoid = true )
+		{
+			return CSplitView< char >( str, delims, keepVoid );
+		}
+
+		/** Lazily cuts a string into substrings, using a delimiter
+		@remarks
+			Nothing is allocated, the substrings are views over the string, which must outlive the returned range.
+		@param[in] str
+			The string to cut
+		@param[in] delim
+			The delimiter
+		@param[in] keepVoid
+			Tells if the function keeps void substrings or not
+		@return
+			The range over the substrings
+		*/
+		inline CSplitView< wchar_t > SplitView( WStringView const & str, wchar_t delim, bool keepVoid = true )
+		{
+			return CSplitView< wchar_t >( str, delim, keepVoid );
+		}
+
+		/** Lazily cuts a string into substrings, using delimiters
+		@remarks
+			Nothing is allocated, the substrings are views over the string, which must outlive the returned range, as the delimiters.
+		@param[in] str
+			The string to cut
+		@param[in] delims
+			The delimiters
+		@param[in] keepVoid
+			Tells if the function keeps void substrings or not
+		@return
+			The range over the substrings
+		*/
+		inline CSplitView< wchar_t > SplitView( WStringView const & str, WStringView const & delims, bool keepVoid = true )
+		{
+			return CSplitView< wchar_t >( str, delims, keepVoid );
+		}
+
 		/** Removes spaces on the left and/or on the right of the given string
 		@param[in,out] str
 		 	The string to trim, receives the trimmed string
@@ -264,6 +334,34 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		*/
 		ShaderParserExport std::wstring & Replace( std::wstring & str, const std::wstring & find, const std::wstring & replacement );
 
+		/** Replaces all occurences of several strings in a string, in a single pass
+		@remarks
+			The matches are replaced from left to right, the longest one wins when several start at the same position,
+			and the replacements are not searched again.
+			To apply the same replacements to several strings, use a CReplacer, which compiles them only once.
+		@param[in,out] str
+		 	The String to modify
+		@param[in] replacements
+		 	The replacement of each value
+		@return
+			A reference on the modified string
+		*/
+		ShaderParserExport std::string & ReplaceAll( std::string & str, std::map< std::string, std::string > const & replacements );
+
+		/** Replaces all occurences of several strings in a string, in a single pass
+		@remarks
+			The matches are replaced from left to right, the longest one wins when several start at the same position,
+			and the replacements are not searched again.
+			To apply the same replacements to several strings, use a CWReplacer, which compiles them only once.
+		@param[in,out] str
+		 	The String to modify
+		@param[in] replacements
+		 	The replacement of each value
+		@return
+			A reference on the modified string
+		*/
+		ShaderParserExport std::wstring & ReplaceAll( std::wstring & str, std::map< std::wstring, std::wstring > const & replacements );
+
 		/** Format a string.
 		@param[out] formattedString
 			Formatted string.
@@ -314,21 +412,82 @@ BEGIN_NAMESPACE_SHADER_PARSER
 		*/
 		ShaderParserExport String ToString( wchar_t src );
 
-		/** Converts a std::string in a given charset to a std::wstring in the same charset
+		/** Retrieves the length of the leading ASCII characters of a buffer.
+		@remarks
+			The bytes are checked by blocks of 16 where SSE2 is available, 8 otherwise.
+		@param[in] src
+			The buffer
+		@param[in] size
+			The buffer size
+		@return
+			The index of the first byte having its high bit set, size if there is none.
+		*/
+		ShaderParserExport size_t AsciiLength( char const * src, size_t size );
+
+		/** Converts a UTF-8 string to UTF-16.
+		@remarks
+			Doesn't depend on the current locale, and doesn't lock.
+			The invalid sequences are replaced by U+FFFD.
+		@param[in] src
+			The UTF-8 string
+		@return
+			The UTF-16 string
+		*/
+		ShaderParserExport std::u16string Utf8ToUtf16( std::string const & src );
+
+		/** Converts a UTF-8 string to UTF-32.
+		@remarks
+			Doesn't depend on the current locale, and doesn't lock.
+			The invalid sequences are replaced by U+FFFD.
+		@param[in] src
+			The UTF-8 string
+		@return
+			The UTF-32 string
+		*/
+		ShaderParserExport std::u32string Utf8ToUtf32( std::string const & src );
+
+		/** Converts a UTF-16 string to UTF-8.
+		@remarks
+			Doesn't depend on the current locale, and doesn't lock.
+			The unpaired surrogates are replaced by U+FFFD.
+		@param[in] src
+			The UTF-16 string
+		@return
+			The UTF-8 string
+		*/
+		ShaderParserExport std::string Utf16ToUtf8( std::u16string const & src );
+
+		/** Converts a UTF-32 string to UTF-8.
+		@remarks
+			Doesn't depend on the current locale, and doesn't lock.
+			The invalid code points are replaced by U+FFFD.
+		@param[in] src
+			The UTF-32 string
+		@return
+			The UTF-8 string
+		*/
+		ShaderParserExport std::string Utf32ToUtf8( std::u32string const & src );
+
+		/** Converts a std::string in a given charset to a std::wstring
+		@remarks
+			The std::wstring is UTF-16 or UTF-32, depending on the size of wchar_t.
+			UTF-8 strings are converted without locale nor lock, the other charsets go through boost::locale.
 		@param[in] src
 			The string
 		@param[in] charset
 			The original string charset
 		@return
-			The std::string
+			The std::wstring
 		*/
 		ShaderParserExport std::wstring ToWStr( const std::string & src, const std::string & charset = "UTF-8" );
 
-		/** Converts a std::wstring in a given charset to a std::string in the same charset
+		/** Converts a std::wstring to a std::string in a given charset
+		@remarks
+			UTF-8 strings are converted without locale nor lock, the other charsets go through boost::locale.
 		@param[in] src
 			The string
 		@param[in] charset
-			The original string charset
+			The wanted string charset
 		@return
 			The std::string
 		*/
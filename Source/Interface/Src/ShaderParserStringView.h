@@ -0,0 +1,389 @@
+/************************************************************************//**
+* @file ShaderParserStringView.h
+* @author Sylvain Doremus
+* @version 1.0
+* @date 11/23/2015
+*
+*
+* @brief CBasicStringView and CSplitView classes
+*
+* @details Non owning views over strings, and lazy splitting of a string in such views.
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_STRING_VIEW_H___
+#define ___SHADER_PARSER_STRING_VIEW_H___
+
+#include "ShaderParserPrerequisites.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cwchar>
+#include <iterator>
+
+BEGIN_NAMESPACE_SHADER_PARSER
+{
+	/** Non owning view over a characters range.
+	@remarks
+		Follows the std::basic_string_view interface, for the used parts, since the library is built as C++14.
+		The viewed characters must outlive the view.
+	*/
+	template< typename CharType >
+	class CBasicStringView
+	{
+	public:
+		typedef CharType value_type;
+		typedef CharType const * const_iterator;
+		typedef CharType const * iterator;
+
+	public:
+		/** Constructor, empty view
+		*/
+		CBasicStringView()
+			: m_data( NULL )
+			, m_size( 0 )
+		{
+		}
+
+		/** Constructor
+		@param[in] data
+			The characters
+		@param[in] size
+			The characters count
+		*/
+		CBasicStringView( CharType const * data, size_t size )
+			: m_data( data )
+			, m_size( size )
+		{
+		}
+
+		/** Constructor, from a null terminated string
+		@param[in] data
+			The string
+		*/
+		CBasicStringView( CharType const * data )
+			: m_data( data )
+			, m_size( std::char_traits< CharType >::length( data ) )
+		{
+		}
+
+		/** Constructor, from a string
+		@param[in] str
+			The string
+		*/
+		CBasicStringView( std::basic_string< CharType > const & str )
+			: m_data( str.data() )
+			, m_size( str.size() )
+		{
+		}
+
+		/** Retrieves the viewed characters
+		@return
+			The characters, not null terminated.
+		*/
+		CharType const * data()const
+		{
+			return m_data;
+		}
+
+		/** Retrieves the characters count
+		@return
+			The count.
+		*/
+		size_t size()const
+		{
+			return m_size;
+		}
+
+		/** Tells if the view is empty
+		@return
+			\p true if the view has no character.
+		*/
+		bool empty()const
+		{
+			return m_size == 0;
+		}
+
+		/** Retrieves the beginning of the view
+		@return
+			The iterator.
+		*/
+		const_iterator begin()const
+		{
+			return m_data;
+		}
+
+		/** Retrieves the end of the view
+		@return
+			The iterator.
+		*/
+		const_iterator end()const
+		{
+			return m_data + m_size;
+		}
+
+		/** Retrieves a character
+		@param[in] index
+			The character index
+		@return
+			The character.
+		*/
+		CharType const & operator[]( size_t index )const
+		{
+			return m_data[index];
+		}
+
+		/** Copies the viewed characters in a string
+		@return
+			The string.
+		*/
+		std::basic_string< CharType > str()const
+		{
+			return std::basic_string< CharType >( m_data, m_size );
+		}
+
+	private:
+		//! The viewed characters
+		CharType const * m_data;
+		//! The characters count
+		size_t m_size;
+	};
+
+	template< typename CharType >
+	inline bool operator==( CBasicStringView< CharType > const & lhs, CBasicStringView< CharType > const & rhs )
+	{
+		return lhs.size() == rhs.size() && std::char_traits< CharType >::compare( lhs.data(), rhs.data(), lhs.size() ) == 0;
+	}
+
+	template< typename CharType >
+	inline bool operator!=( CBasicStringView< CharType > const & lhs, CBasicStringView< CharType > const & rhs )
+	{
+		return !( lhs == rhs );
+	}
+
+	template< typename CharType >
+	inline std::basic_ostream< CharType > & operator<<( std::basic_ostream< CharType > & stream, CBasicStringView< CharType > const & view )
+	{
+		return stream.write( view.data(), std::streamsize( view.size() ) );
+	}
+
+	typedef CBasicStringView< char > StringView;
+	typedef CBasicStringView< wchar_t > WStringView;
+
+	namespace detail
+	{
+		/** Finds a character in a range, using the vectorised C library search.
+		@return
+			The character position, last if not found.
+		*/
+		inline char const * find_char( char const * first, char const * last, char value )
+		{
+			void const * l_result = first == last ? NULL : std::memchr( first, value, size_t( last - first ) );
+			return l_result ? static_cast< char const * >( l_result ) : last;
+		}
+
+		/** Finds a character in a range, using the vectorised C library search.
+		@return
+			The character position, last if not found.
+		*/
+		inline wchar_t const * find_char( wchar_t const * first, wchar_t const * last, wchar_t value )
+		{
+			wchar_t const * l_result = first == last ? NULL : std::wmemchr( first, value, size_t( last - first ) );
+			return l_result ? l_result : last;
+		}
+	}
+
+	/** Lazy range over the pieces of a string separated by delimiters.
+	@remarks
+		The pieces are views over the split string, nothing is allocated, the split string must outlive the range.
+		When the empty pieces are kept, a string holding N delimiters gives N + 1 pieces.
+	*/
+	template< typename CharType >
+	class CSplitView
+	{
+	public:
+		/** Forward iterator over the pieces.
+		*/
+		class CIterator
+		{
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef CBasicStringView< CharType > value_type;
+			typedef ptrdiff_t difference_type;
+			typedef value_type const * pointer;
+			typedef value_type const & reference;
+
+		public:
+			/** Constructor
+			@param[in] split
+				The range, NULL for the end iterator
+			*/
+			explicit CIterator( CSplitView const * split )
+				: m_split( split )
+				, m_next( NULL )
+				, m_hasNext( split != NULL )
+			{
+				if ( m_split )
+				{
+					m_next = m_split->m_str.begin();
+					DoAdvance();
+				}
+			}
+
+			reference operator*()const
+			{
+				return m_piece;
+			}
+
+			pointer operator->()const
+			{
+				return &m_piece;
+			}
+
+			CIterator & operator++()
+			{
+				DoAdvance();
+				return *this;
+			}
+
+			CIterator operator++( int )
+			{
+				CIterator l_result = *this;
+				DoAdvance();
+				return l_result;
+			}
+
+			bool operator==( CIterator const & rhs )const
+			{
+				return m_split == rhs.m_split && m_piece.data() == rhs.m_piece.data() && m_hasNext == rhs.m_hasNext;
+			}
+
+			bool operator!=( CIterator const & rhs )const
+			{
+				return !( *this == rhs );
+			}
+
+		private:
+			/** Moves to the next piece, or to the end
+			*/
+			void DoAdvance()
+			{
+				while ( m_hasNext )
+				{
+					CharType const * l_first = m_next;
+					CharType const * l_last = m_split->m_str.end();
+					CharType const * l_delim = m_split->DoFind( l_first, l_last );
+					m_piece = CBasicStringView< CharType >( l_first, size_t( l_delim - l_first ) );
+					m_hasNext = l_delim != l_last;
+					m_next = m_hasNext ? l_delim + 1 : l_last;
+
+					if ( m_split->m_keepVoid || !m_piece.empty() )
+					{
+						return;
+					}
+				}
+
+				//!@remarks The end iterator.
+				m_split = NULL;
+				m_piece = CBasicStringView< CharType >();
+			}
+
+		private:
+			//! The range, NULL at the end
+			CSplitView const * m_split;
+			//! The current piece
+			CBasicStringView< CharType > m_piece;
+			//! The beginning of the next piece
+			CharType const * m_next;
+			//! Tells if a delimiter followed the current piece
+			bool m_hasNext;
+		};
+
+		typedef CIterator iterator;
+		typedef CIterator const_iterator;
+
+	public:
+		/** Constructor, for a single delimiter character
+		@param[in] str
+			The string to split
+		@param[in] delim
+			The delimiter
+		@param[in] keepVoid
+			Tells if the empty pieces are kept
+		*/
+		CSplitView( CBasicStringView< CharType > const & str, CharType delim, bool keepVoid = true )
+			: m_str( str )
+			, m_delim( delim )
+			, m_single( true )
+			, m_keepVoid( keepVoid )
+		{
+		}
+
+		/** Constructor, for a set of delimiter characters
+		@param[in] str
+			The string to split
+		@param[in] delims
+			The delimiters, any of them separates two pieces, must outlive the range
+		@param[in] keepVoid
+			Tells if the empty pieces are kept
+		*/
+		CSplitView( CBasicStringView< CharType > const & str, CBasicStringView< CharType > const & delims, bool keepVoid = true )
+			: m_str( str )
+			, m_delims( delims )
+			, m_delim( delims.size() == 1 ? delims[0] : CharType() )
+			, m_single( delims.size() == 1 )
+			, m_keepVoid( keepVoid )
+		{
+		}
+
+		/** Retrieves the first piece
+		@return
+			The iterator.
+		*/
+		CIterator begin()const
+		{
+			return CIterator( this );
+		}
+
+		/** Retrieves the end of the pieces
+		@return
+			The iterator.
+		*/
+		CIterator end()const
+		{
+			return CIterator( NULL );
+		}
+
+	private:
+		/** Finds the next delimiter
+		@param[in] first, last
+			The searched range
+		@return
+			The delimiter position, last if there is none.
+		*/
+		CharType const * DoFind( CharType const * first, CharType const * last )const
+		{
+			if ( m_single )
+			{
+				return detail::find_char( first, last, m_delim );
+			}
+
+			return std::find_first_of( first, last, m_delims.begin(), m_delims.end() );
+		}
+
+	private:
+		//! The split string
+		CBasicStringView< CharType > m_str;
+		//! The delimiters, when there are more than one
+		CBasicStringView< CharType > m_delims;
+		//! The delimiter, when there is only one
+		CharType m_delim;
+		//! Tells if there is only one delimiter
+		bool m_single;
+		//! Tells if the empty pieces are kept
+		bool m_keepVoid;
+	};
+}
+END_NAMESPACE_SHADER_PARSER
+
+#endif
@@ -35,6 +35,95 @@ BEGIN_NAMESPACE_GLSL_PARSER
 		/** Creates the grammar
 		*/
 		static CShaderGrammar * Create();
+
+	protected:
+		LexemeRule base_type_specifier;
+		LexemeRule vec_specifier;
+		LexemeRule mat_specifier;
+		LexemeRule fsampler_specifier;
+		LexemeRule isampler_specifier;
+		LexemeRule usampler_specifier;
+		LexemeRule image_specifier;
+		LexemeRule iimage_specifier;
+		LexemeRule uimage_specifier;
+		//! The keywords which are not type specifiers, used to build reserved_word
+		LexemeRule keyword;
+		Rule variable_identifier;
+		Rule field_selection;
+		Rule function_identifier;
+		Rule function_call_parameters;
+		Rule function_call;
+		Rule integer_expression;
+		Rule postfix_expression;
+		Rule unary_expression;
+		Rule unary_operator;
+		Rule multiplicative_expression;
+		Rule additive_expression;
+		Rule shift_expression;
+		Rule relational_expression;
+		Rule equality_expression;
+		Rule and_expression;
+		Rule exclusive_or_expression;
+		Rule inclusive_or_expression;
+		Rule logical_and_expression;
+		Rule logical_xor_expression;
+		Rule logical_or_expression;
+		Rule conditional_expression;
+		Rule assignment_operator;
+		Rule assignment_expression;
+		//! The assignment expression, without its nesting level
+		Rule assignment_expression_content;
+		Rule expression;
+		Rule primary_expression;
+		Rule type_name;
+		Rule constant_expression;
+		Rule type_qualifier;
+		Rule fully_specified_type;
+		Rule array_specifier;
+		Rule parameter_declaration;
+		Rule identifier_list;
+		Rule initializer;
+		Rule single_declaration;
+		Rule init_declarator_list;
+		Rule precision_qualifier;
+		Rule declaration;
+		Rule invariant_qualifier;
+		Rule interpolation_qualifier;
+		Rule layout_qualifier_id;
+		Rule layout_qualifier_id_list;
+		Rule layout_qualifier;
+		Rule precise_qualifier;
+		Rule type_name_list;
+		Rule storage_qualifier;
+		Rule type_specifier;
+		Rule single_type_qualifier;
+		Rule struct_declarator;
+		Rule struct_declarator_list;
+		Rule struct_declaration;
+		Rule struct_declaration_list;
+		Rule struct_specifier;
+		Rule type_specifier_nonarray;
+		Rule initializer_list;
+		Rule declaration_statement;
+		Rule compound_statement_no_new_scope;
+		Rule statement_no_new_scope;
+		Rule compound_statement;
+		Rule statement_list;
+		Rule expression_statement;
+		Rule selection_rest_statement;
+		Rule selection_statement;
+		Rule for_init_statement;
+		Rule condition;
+		Rule case_label;
+		Rule switch_statement;
+		Rule switch_statement_list;
+		Rule for_rest_statement;
+		Rule iteration_statement;
+		Rule jump_statement;
+		Rule simple_statement;
+		//! The statement, without its nesting level
+		Rule statement_content;
+		Rule function_definition;
 	};
 }
 END_NAMESPACE_GLSL_PARSER
@@ -18,6 +18,40 @@ BEGIN_NAMESPACE_GLSL_PARSER_TEST
 {
 	static const String GLSL_PLUGIN = STR( "GlslParser" );
 
+	void CheckEqual( SParseNode const & lhs, SParseNode const & rhs )
+	{
+		BOOST_CHECK_EQUAL( lhs.m_begin, rhs.m_begin );
+		BOOST_CHECK_EQUAL( lhs.m_end, rhs.m_end );
+		BOOST_CHECK_EQUAL( lhs.m_valid, rhs.m_valid );
+		BOOST_REQUIRE_EQUAL( lhs.m_children.size(), rhs.m_children.size() );
+
+		for ( size_t i = 0; i < lhs.m_children.size(); ++i )
+		{
+			CheckEqual( lhs.m_children[i], rhs.m_children[i] );
+		}
+	}
+
+	void CheckEqual( SParseResult const & lhs, SParseResult const & rhs )
+	{
+		BOOST_CHECK( lhs.m_source == rhs.m_source );
+		BOOST_CHECK_EQUAL( lhs.m_status, rhs.m_status );
+		BOOST_REQUIRE_EQUAL( lhs.m_declarations.size(), rhs.m_declarations.size() );
+
+		for ( size_t i = 0; i < lhs.m_declarations.size(); ++i )
+		{
+			CheckEqual( lhs.m_declarations[i], rhs.m_declarations[i] );
+		}
+
+		BOOST_REQUIRE_EQUAL( lhs.m_diagnostics.size(), rhs.m_diagnostics.size() );
+
+		for ( size_t i = 0; i < lhs.m_diagnostics.size(); ++i )
+		{
+			BOOST_CHECK_EQUAL( lhs.m_diagnostics[i].m_offset, rhs.m_diagnostics[i].m_offset );
+			BOOST_CHECK_EQUAL( lhs.m_diagnostics[i].m_line, rhs.m_diagnostics[i].m_line );
+			BOOST_CHECK_EQUAL( lhs.m_diagnostics[i].m_column, rhs.m_diagnostics[i].m_column );
+		}
+	}
+
 	CGlslGrammarTest::CGlslGrammarTest()
 	{
 	}
@@ -32,7 +66,7 @@ BEGIN_NAMESPACE_GLSL_PARSER_TEST
 #if BOOST_VERSION < 105900
 		m_testSuite = new boost::unit_test::test_suite( "CGlslGrammarTest" );
 #else
-		testSuite = new boost::unit_test::test_suite( "CGlslGrammarTest", __FILE__, __LINE__ );
+		m_testSuite = new boost::unit_test::test_suite( "CGlslGrammarTest", __FILE__, __LINE__ );
 #endif
 
 		//!@remarks Add the TC to the internal TS.
@@ -42,6 +76,12 @@ BEGIN_NAMESPACE_GLSL_PARSER_TEST
 		m_testSuite->add( BOOST_TEST_CASE( std::bind( &CGlslGrammarTest::TestCase_ParseGeometryShader, this ) ) );
 		m_testSuite->add( BOOST_TEST_CASE( std::bind( &CGlslGrammarTest::TestCase_ParseFragmentShader, this ) ) );
 		m_testSuite->add( BOOST_TEST_CASE( std::bind( &CGlslGrammarTest::TestCase_ParseComputeShader, this ) ) );
+		m_testSuite->add( BOOST_TEST_CASE( std::bind( &CGlslGrammarTest::TestCase_RecoverSyntaxErrors, this ) ) );
+		m_testSuite->add( BOOST_TEST_CASE( std::bind( &CGlslGrammarTest::TestCase_ReparseEdits, this ) ) );
+		m_testSuite->add( BOOST_TEST_CASE( std::bind( &CGlslGrammarTest::TestCase_NestingDepthLimit, this ) ) );
+		m_testSuite->add( BOOST_TEST_CASE( std::bind( &CGlslGrammarTest::TestCase_CancelParse, this ) ) );
+		m_testSuite->add( BOOST_TEST_CASE( std::bind( &CGlslGrammarTest::TestCase_ParseAsync, this ) ) );
+		m_testSuite->add( BOOST_TEST_CASE( std::bind( &CGlslGrammarTest::TestCase_TryParse, this ) ) );
 
 		//!@remarks Return the TS instance.
 		return m_testSuite;
@@ -78,5 +118,346 @@ BEGIN_NAMESPACE_GLSL_PARSER_TEST
 	void CGlslGrammarTest::TestCase_ParseComputeShader()
 	{
 	}
+
+	void CGlslGrammarTest::TestCase_RecoverSyntaxErrors()
+	{
+		CGlslGrammar l_grammar;
+
+		String l_valid = STR( "#version 330\n" )
+			STR( "uniform mat4 mvp;\n" )
+			STR( "layout( location = 0 ) in vec3 position;\n" )
+			STR( "// Entry point\n" )
+			STR( "void main()\n" )
+			STR( "{\n" )
+			STR( "	gl_Position = mvp * vec4( position, 1.0 );\n" )
+			STR( "}\n" );
+		SParseResult l_result = l_grammar.Parse( l_valid );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_SUCCESS );
+		BOOST_CHECK( l_result.m_diagnostics.empty() );
+		BOOST_CHECK_EQUAL( l_result.m_declarations.size(), 3 );
+
+		String l_invalid = STR( "uniform mat4 mvp;\n" )
+			STR( "float bad = ;\n" )
+			STR( "void main()\n" )
+			STR( "{\n" )
+			STR( "	vec4 p = mvp * vec4( 1.0 );\n" )
+			STR( "	if ( p.x > 0.0 )\n" )
+			STR( "	{\n" )
+			STR( "		p = p + ;\n" )
+			STR( "	}\n" )
+			STR( "	gl_Position = p;\n" )
+			STR( "}\n" )
+			STR( "out vec4 colour;\n" );
+		l_result = l_grammar.Parse( l_invalid );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_ERROR );
+		BOOST_REQUIRE_EQUAL( l_result.m_diagnostics.size(), 2 );
+		BOOST_CHECK_EQUAL( l_result.m_diagnostics[0].m_line, 2 );
+		BOOST_CHECK_EQUAL( l_result.m_diagnostics[0].m_column, 1 );
+		BOOST_CHECK_EQUAL( l_result.m_diagnostics[1].m_line, 8 );
+		BOOST_CHECK_EQUAL( l_result.m_diagnostics[1].m_column, 3 );
+		BOOST_REQUIRE_EQUAL( l_result.m_declarations.size(), 4 );
+		BOOST_CHECK( l_result.m_declarations[0].m_valid );
+		BOOST_CHECK( !l_result.m_declarations[1].m_valid );
+		BOOST_CHECK( !l_result.m_declarations[2].m_valid );
+		BOOST_CHECK_EQUAL( l_result.m_declarations[2].m_children.size(), 3 );
+		BOOST_CHECK( l_result.m_declarations[3].m_valid );
+
+		//!@remarks Non ASCII characters are syntax errors, not undefined behaviour.
+		String l_nonAscii = STR( "float caf\xC3\xA9 = 1.0;\n" )
+			STR( "float b = 2.0;\n" );
+		l_result = l_grammar.Parse( l_nonAscii );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_ERROR );
+		BOOST_REQUIRE_EQUAL( l_result.m_diagnostics.size(), 1 );
+		BOOST_CHECK_EQUAL( l_result.m_diagnostics[0].m_line, 1 );
+		BOOST_REQUIRE_EQUAL( l_result.m_declarations.size(), 2 );
+		BOOST_CHECK( l_result.m_declarations[1].m_valid );
+	}
+
+	void CGlslGrammarTest::TestCase_ReparseEdits()
+	{
+		CGlslGrammar l_grammar;
+
+		String l_source = STR( "uniform mat4 mvp;\n" )
+			STR( "vec4 Transform( vec3 position )\n" )
+			STR( "{\n" )
+			STR( "	return mvp * vec4( position, 1.0 );\n" )
+			STR( "}\n" )
+			STR( "float bad = ;\n" )
+			STR( "void main()\n" )
+			STR( "{\n" )
+			STR( "	gl_Position = Transform( vec3( 0.0 ) );\n" )
+			STR( "}\n" );
+		SParseResult l_result = l_grammar.Parse( l_source );
+		BOOST_CHECK_EQUAL( l_result.m_diagnostics.size(), 1 );
+		BOOST_CHECK_EQUAL( l_result.m_reused, 0 );
+
+		//!@remarks Break the first function body.
+		SParseEdit l_edit = { l_source.find( STR( "1.0" ) ), 3, STR( "1.0 +" ) };
+		SParseResult l_reparsed = l_grammar.Reparse( l_result, l_edit );
+		CheckEqual( l_reparsed, l_grammar.Parse( l_reparsed.m_source ) );
+		BOOST_CHECK_EQUAL( l_reparsed.m_diagnostics.size(), 2 );
+		//!@remarks Only the edited function is reparsed, the declarations before and after it are reused.
+		BOOST_CHECK_EQUAL( l_reparsed.m_reused, 3 );
+
+		//!@remarks Fix the erroneous declaration, on several lines.
+		l_edit = { l_reparsed.m_source.find( STR( "= ;" ) ), 3, STR( "=\n	2.0;" ) };
+		l_reparsed = l_grammar.Reparse( l_reparsed, l_edit );
+		CheckEqual( l_reparsed, l_grammar.Parse( l_reparsed.m_source ) );
+		BOOST_CHECK_EQUAL( l_reparsed.m_diagnostics.size(), 1 );
+		BOOST_CHECK_EQUAL( l_reparsed.m_reused, 3 );
+
+		//!@remarks Comment out the end of the source.
+		l_edit = { l_reparsed.m_source.find( STR( "void main" ) ), 0, STR( "/*" ) };
+		l_reparsed = l_grammar.Reparse( l_reparsed, l_edit );
+		CheckEqual( l_reparsed, l_grammar.Parse( l_reparsed.m_source ) );
+
+		//!@remarks Remove the comment and the first function body error.
+		l_edit = { l_reparsed.m_source.find( STR( "/*" ) ), 2, String() };
+		l_reparsed = l_grammar.Reparse( l_reparsed, l_edit );
+		l_edit = { l_reparsed.m_source.find( STR( " +" ) ), 2, String() };
+		l_reparsed = l_grammar.Reparse( l_reparsed, l_edit );
+		CheckEqual( l_reparsed, l_grammar.Parse( l_reparsed.m_source ) );
+		BOOST_CHECK_EQUAL( l_reparsed.m_status, EParseStatus_SUCCESS );
+	}
+
+	void CGlslGrammarTest::TestCase_NestingDepthLimit()
+	{
+		CGlslGrammar l_grammar;
+		String l_valid = STR( "float b = 1.0;\n" );
+
+		String l_parens = STR( "float a = " ) + String( 100, STR( '(' ) ) + STR( "1.0" ) + String( 100, STR( ')' ) ) + STR( ";\n" ) + l_valid;
+		SParseResult l_result = l_grammar.Parse( l_parens );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_SUCCESS );
+
+		SParseOptions l_options;
+		l_options.m_maxDepth = 50;
+		l_result = l_grammar.Parse( l_parens, l_options );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_ERROR );
+		BOOST_REQUIRE_EQUAL( l_result.m_diagnostics.size(), 1 );
+		BOOST_CHECK_EQUAL( l_result.m_diagnostics[0].m_offset, 60 );
+		BOOST_REQUIRE_EQUAL( l_result.m_declarations.size(), 2 );
+		BOOST_CHECK( l_result.m_declarations[1].m_valid );
+
+		String l_blocks = STR( "void main()\n{\n" ) + String( 100000, STR( '{' ) ) + String( 100000, STR( '}' ) ) + STR( "}\n" ) + l_valid;
+		l_result = l_grammar.Parse( l_blocks );
+		BOOST_REQUIRE_EQUAL( l_result.m_diagnostics.size(), 1 );
+		BOOST_REQUIRE_EQUAL( l_result.m_declarations.size(), 2 );
+		BOOST_CHECK( !l_result.m_declarations[0].m_valid );
+		BOOST_CHECK( l_result.m_declarations[1].m_valid );
+
+		String l_unary = STR( "float c = " ) + String( 100000, STR( '-' ) ) + STR( "1.0;\n" ) + l_valid;
+		l_result = l_grammar.Parse( l_unary );
+		BOOST_CHECK_EQUAL( l_result.m_diagnostics.size(), 1 );
+
+		String l_indices = STR( "float d = a" );
+
+		for ( int i = 0; i < 40; ++i )
+		{
+			l_indices += STR( "[a" );
+		}
+
+		l_indices += String( 40, STR( ']' ) ) + STR( ";\n" );
+		l_result = l_grammar.Parse( l_indices );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_SUCCESS );
+
+		//!@remarks The right recursive chains don't use any bracket, they are bounded by the grammar itself.
+		String l_assignments = STR( "void main()\n{\n\tfloat a;\n\t" );
+
+		for ( int i = 0; i < 100000; ++i )
+		{
+			l_assignments += STR( "a = " );
+		}
+
+		l_assignments += STR( "1.0;\n}\n" ) + l_valid;
+		l_result = l_grammar.Parse( l_assignments );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_ERROR );
+		BOOST_REQUIRE_EQUAL( l_result.m_diagnostics.size(), 1 );
+		BOOST_CHECK_EQUAL( l_result.m_diagnostics[0].m_line, 4 );
+		BOOST_REQUIRE_EQUAL( l_result.m_declarations.size(), 2 );
+		BOOST_CHECK( !l_result.m_declarations[0].m_valid );
+		BOOST_CHECK( l_result.m_declarations[1].m_valid );
+
+		String l_conditions = STR( "void main()\n{\n\tfloat a;\n\tif ( a > 0.0 ) a = 1.0;" );
+
+		for ( int i = 0; i < 100000; ++i )
+		{
+			l_conditions += STR( " else if ( a > 0.0 ) a = 1.0;" );
+		}
+
+		l_conditions += STR( "\n}\n" ) + l_valid;
+		l_result = l_grammar.Parse( l_conditions );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_ERROR );
+		BOOST_REQUIRE_EQUAL( l_result.m_diagnostics.size(), 1 );
+		BOOST_REQUIRE_EQUAL( l_result.m_declarations.size(), 2 );
+		BOOST_CHECK( !l_result.m_declarations[0].m_valid );
+		BOOST_CHECK( l_result.m_declarations[1].m_valid );
+
+		//!@remarks Shorter chains are still parsed.
+		l_options.m_maxDepth = 128;
+		l_result = l_grammar.Parse( STR( "float e = b = b ? b : b ? b : b;\n" ) + l_valid, l_options );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_SUCCESS );
+	}
+
+	void CGlslGrammarTest::TestCase_CancelParse()
+	{
+		CGlslGrammar l_grammar;
+		String l_source = STR( "float a = 1.0;\n" )
+			STR( "float b = 2.0;\n" )
+			STR( "float c = 3.0;\n" );
+
+		SParseOptions l_options;
+		l_options.m_cancellation = std::make_shared< CCancellationToken >();
+		SParseResult l_result = l_grammar.Parse( l_source, l_options );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_SUCCESS );
+		BOOST_CHECK_EQUAL( l_result.m_declarations.size(), 3 );
+
+		l_options.m_cancellation->Cancel();
+		l_result = l_grammar.Parse( l_source, l_options );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_CANCELLED );
+		BOOST_CHECK( l_result.m_declarations.empty() );
+
+		l_options.m_cancellation.reset();
+		//!@remarks The declaration crossing the budget is interrupted too.
+		l_options.m_maxBytes = 16;
+		l_result = l_grammar.Parse( l_source, l_options );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_CANCELLED );
+		BOOST_CHECK_EQUAL( l_result.m_declarations.size(), 1 );
+
+		SParseEdit l_edit = { 0, 0, STR( "float d = 4.0;\n" ) };
+		l_result = l_grammar.Reparse( l_grammar.Parse( l_source ), l_edit, l_options );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_SUCCESS );
+		BOOST_CHECK_EQUAL( l_result.m_declarations.size(), 4 );
+
+		//!@remarks A single large function is interrupted while its statements are parsed.
+		String l_function = l_source + STR( "void main()\n{\n\tfloat a = 1.0;\n" );
+
+		for ( int i = 0; i < 50000; ++i )
+		{
+			l_function += STR( "\ta = a * ( a + 1.0 ) - a / 2.0;\n" );
+		}
+
+		l_function += STR( "}\n" );
+		l_options.m_maxBytes = l_source.size() + 64;
+		l_result = l_grammar.Parse( l_function, l_options );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_CANCELLED );
+		BOOST_CHECK_EQUAL( l_result.m_declarations.size(), 3 );
+		BOOST_CHECK( l_result.m_diagnostics.empty() );
+
+		l_options.m_maxBytes = 0;
+		l_options.m_timeout = std::chrono::milliseconds( 1 );
+		l_result = l_grammar.Parse( l_function, l_options );
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_CANCELLED );
+		BOOST_CHECK_LE( l_result.m_declarations.size(), 3 );
+
+		l_options.m_timeout = std::chrono::milliseconds( 0 );
+		l_options.m_cancellation = std::make_shared< CCancellationToken >();
+		CancellationTokenSPtr l_token = l_options.m_cancellation;
+		std::thread l_canceller( [l_token]()
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+			l_token->Cancel();
+		} );
+		l_result = l_grammar.Parse( l_function, l_options );
+		l_canceller.join();
+		BOOST_CHECK_EQUAL( l_result.m_status, EParseStatus_CANCELLED );
+		BOOST_CHECK_LE( l_result.m_declarations.size(), 3 );
+	}
+
+	void CGlslGrammarTest::TestCase_ParseAsync()
+	{
+		InitialiseSingletons();
+		LoadPlugins( "" );
+
+		String l_valid = STR( "float a = 1.0;\n" );
+		String l_invalid = STR( "float b = ;\n" );
+		{
+			CParsePool l_pool( GLSL_PARSER_TYPE, 2, 4, EBackpressure_BLOCK );
+			std::vector< std::future< SParseResult > > l_results;
+
+			for ( int i = 0; i < 16; ++i )
+			{
+				l_results.push_back( l_pool.ParseAsync( ( i % 2 ) ? l_invalid : l_valid ) );
+			}
+
+			for ( size_t i = 0; i < l_results.size(); ++i )
+			{
+				BOOST_CHECK_EQUAL( l_results[i].get().m_status, ( i % 2 ) ? EParseStatus_ERROR : EParseStatus_SUCCESS );
+			}
+		}
+
+		for ( auto l_backpressure : { EBackpressure_REJECT, EBackpressure_DROP_OLDEST } )
+		{
+			CParsePool l_pool( GLSL_PARSER_TYPE, 1, 1, l_backpressure );
+			std::promise< void > l_started;
+			std::promise< void > l_release;
+			std::shared_future< void > l_released = l_release.get_future().share();
+
+			//!@remarks Keep the only worker busy, from its completion callback.
+			l_pool.ParseAsync( l_valid, SParseOptions(), [&l_started, l_released]( SParseResult const & )
+			{
+				l_started.set_value();
+				l_released.wait();
+			} );
+			l_started.get_future().wait();
+
+			auto l_first = l_pool.ParseAsync( l_valid );
+			auto l_second = l_pool.ParseAsync( l_invalid );
+
+			if ( l_backpressure == EBackpressure_REJECT )
+			{
+				BOOST_CHECK_EQUAL( l_second.get().m_status, EParseStatus_REJECTED );
+				l_release.set_value();
+				BOOST_CHECK_EQUAL( l_first.get().m_status, EParseStatus_SUCCESS );
+			}
+			else
+			{
+				BOOST_CHECK_EQUAL( l_first.get().m_status, EParseStatus_REJECTED );
+				l_release.set_value();
+				BOOST_CHECK_EQUAL( l_second.get().m_status, EParseStatus_ERROR );
+			}
+		}
+
+		UnloadPlugins();
+	}
+
+	void CGlslGrammarTest::TestCase_TryParse()
+	{
+		InitialiseSingletons();
+		LoadPlugins( "" );
+
+		auto l_missing = CFactoryManager::Instance().TryCreateInstance( STR( "MissingParser" ) );
+		BOOST_CHECK( !l_missing );
+		BOOST_CHECK_EQUAL( l_missing.GetError(), EShaderParserExceptionCodes_ItemNotFound );
+		BOOST_CHECK( l_missing.GetErrorMessage().find( STR( "MissingParser" ) ) != String::npos );
+		BOOST_CHECK_THROW( l_missing.GetValue(), CShaderParserException );
+
+		auto l_created = CFactoryManager::Instance().TryCreateInstance( GLSL_PARSER_TYPE );
+		BOOST_REQUIRE( l_created.HasValue() );
+		BOOST_CHECK( l_created.GetErrorMessage().empty() );
+		std::unique_ptr< CShaderGrammar > l_grammar( l_created.GetValue() );
+		BOOST_REQUIRE( l_grammar );
+
+		auto l_valid = l_grammar->TryParse( STR( "float a = 1.0;\n" ) );
+		BOOST_REQUIRE( l_valid.HasValue() );
+		BOOST_CHECK_EQUAL( l_valid.GetValue().m_declarations.size(), 1 );
+
+		auto l_invalid = l_grammar->TryParse( STR( "float a = 1.0;\nfloat b = ;\n" ) );
+		BOOST_CHECK( !l_invalid );
+		BOOST_CHECK_EQUAL( l_invalid.GetError(), EShaderParserExceptionCodes_ParseError );
+		BOOST_CHECK_EQUAL( l_invalid.GetPartialValue().m_status, EParseStatus_ERROR );
+		BOOST_CHECK_EQUAL( l_invalid.GetPartialValue().m_declarations.size(), 2 );
+		BOOST_CHECK( l_invalid.GetErrorMessage().find( STR( "line 2, column 1" ) ) != String::npos );
+
+		SParseOptions l_options;
+		l_options.m_cancellation = std::make_shared< CCancellationToken >();
+		l_options.m_cancellation->Cancel();
+		auto l_cancelled = l_grammar->TryParse( STR( "float a = 1.0;\n" ), l_options );
+		BOOST_CHECK( !l_cancelled );
+		BOOST_CHECK_EQUAL( l_cancelled.GetError(), EShaderParserExceptionCodes_Cancelled );
+		BOOST_CHECK( !l_cancelled.GetErrorMessage().empty() );
+
+		l_grammar.reset();
+		UnloadPlugins();
+	}
 }
 END_NAMESPACE_GLSL_PARSER_TEST
@@ -77,6 +77,30 @@ BEGIN_NAMESPACE_GLSL_PARSER_TEST
 		*/
 		void TestCase_ParseComputeShader();
 
+		/** Test GLSL grammar recovery from syntax errors
+		*/
+		void TestCase_RecoverSyntaxErrors();
+
+		/** Test GLSL grammar incremental reparse
+		*/
+		void TestCase_ReparseEdits();
+
+		/** Test GLSL grammar nesting depth limit
+		*/
+		void TestCase_NestingDepthLimit();
+
+		/** Test GLSL grammar cancellation and budgets
+		*/
+		void TestCase_CancelParse();
+
+		/** Test GLSL grammar asynchronous parse, through a parse pool
+		*/
+		void TestCase_ParseAsync();
+
+		/** Test GLSL grammar non throwing creation and parse
+		*/
+		void TestCase_TryParse();
+
 		//!@}
 	};
 }
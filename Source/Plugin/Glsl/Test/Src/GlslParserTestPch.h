@@ -25,7 +25,9 @@
  * \defgroup ShaderParser Includes
  * @{
  */
+#include <ShaderParserCancellationToken.h>
 #include <ShaderParserFactoryManager.h>
+#include <ShaderParserParsePool.h>
 #include <ShaderParserPluginManager.h>
 #include <ShaderParserStringUtils.h>
 
@@ -0,0 +1,112 @@
+/************************************************************************//**
+ * @file ShaderParserExceptionTest.cpp
+ * @author Sylvain Doremus
+ * @version 1.0
+ * @date 11/23/2015
+ *
+ *
+ * @brief Class testing CShaderParserException
+*
+***************************************************************************/
+
+#include "ShaderParserTestPch.h"
+
+#include "ShaderParserExceptionTest.h"
+
+#include <ShaderParserException.h>
+
+BEGIN_NAMESPACE_SHADER_PARSER_TEST
+{
+	CShaderParserExceptionTest::CShaderParserExceptionTest()
+	{
+	}
+
+	CShaderParserExceptionTest::~CShaderParserExceptionTest()
+	{
+	}
+
+	boost::unit_test::test_suite * CShaderParserExceptionTest::Init_Test_Suite()
+	{
+		//!@remarks Create the internal TS instance.
+#if BOOST_VERSION < 105900
+		testSuite = new boost::unit_test::test_suite( "CShaderParserExceptionTest" );
+#else
+		testSuite = new boost::unit_test::test_suite( "CShaderParserExceptionTest", __FILE__, __LINE__ );
+#endif
+
+		//!@remarks Add the TC to the internal TS.
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserExceptionTest::TestCase_ExceptionCallStack, this ) ) );
+
+		//!@remarks Return the TS instance.
+		return testSuite;
+	}
+
+	namespace
+	{
+		/** Throws an exception, always from the same place
+		*/
+		void ThrowException()
+		{
+			PARSER_EXCEPT( EShaderParserExceptionCodes_InternalError, STR( "TestCase_ExceptionCallStack" ) );
+		}
+
+		/** Catches the exception thrown by ThrowException
+		*/
+		std::unique_ptr< CShaderParserException > CatchException()
+		{
+			try
+			{
+				ThrowException();
+			}
+			catch ( CShaderParserException & exc )
+			{
+				return std::make_unique< CShaderParserException >( exc );
+			}
+
+			return nullptr;
+		}
+	}
+
+	void CShaderParserExceptionTest::TestCase_ExceptionCallStack()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_ExceptionCallStack ****" );
+
+		//!@remarks Both exceptions are thrown from the same call site, so they capture the same frames.
+		std::unique_ptr< CShaderParserException > l_exceptions[2];
+		size_t l_resolved[2] = { 0 };
+
+		for ( size_t i = 0; i < 2; ++i )
+		{
+			l_exceptions[i] = CatchException();
+			BOOST_REQUIRE( l_exceptions[i] );
+			l_exceptions[i]->GetCallStack();
+			l_resolved[i] = CShaderParserException::GetSymbolCacheSize();
+		}
+
+		std::string const & l_callStack = l_exceptions[0]->GetCallStack();
+
+#if defined( NDEBUG )
+
+		BOOST_CHECK( l_callStack.empty() );
+		BOOST_CHECK_EQUAL( l_resolved[1], 0 );
+
+#else
+
+		// The call stack is symbolized on first access, and given in the description
+		BOOST_CHECK( !l_callStack.empty() );
+		BOOST_CHECK_NE( std::string( l_exceptions[0]->what() ).find( l_callStack ), std::string::npos );
+		BOOST_CHECK_GT( l_resolved[0], 0 );
+
+		// A second access gives the cached call stack, without resolving the frames again
+		BOOST_CHECK_EQUAL( CShaderParserException::GetSymbolCacheSize(), l_resolved[1] );
+
+		// The second exception reuses the process wide symbol names, none is resolved again
+		BOOST_CHECK_EQUAL( l_exceptions[1]->GetCallStack(), l_callStack );
+		BOOST_CHECK_EQUAL( l_resolved[1], l_resolved[0] );
+
+#endif
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_ExceptionCallStack ****" );
+	}
+}
+END_NAMESPACE_SHADER_PARSER_TEST
@@ -0,0 +1,65 @@
+/************************************************************************//**
+ * @file ShaderParserExceptionTest.h
+ * @author Sylvain Doremus
+ * @version 1.0
+ * @date 11/23/2015
+ *
+ *
+ * @brief Class testing CShaderParserException
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_EXCEPTION_TEST_H___
+#define ___SHADER_PARSER_EXCEPTION_TEST_H___
+
+#include "ShaderParserTestPrerequisites.h"
+
+#include <boost/test/unit_test_suite.hpp>
+
+BEGIN_NAMESPACE_SHADER_PARSER_TEST
+{
+	/** ShaderParser unit test class
+	*/
+	class CShaderParserExceptionTest
+	{
+		/** @name Default constructor / Destructor */
+		//!@{
+	public:
+		/** Default constructor.
+		*/
+		CShaderParserExceptionTest();
+
+		/** Destructor.
+		*/
+		~CShaderParserExceptionTest();
+		//!@}
+
+	public:
+		/** @name Master TS implementation
+		*  Required Master TS implementation in TC
+		*/
+		//!@{
+		/** @brief  Initialization of the Internal TS
+		 @return testSuite Pointer on the TS to be included in the Master TS.
+		*/
+		boost::unit_test::test_suite * Init_Test_Suite();
+
+	private:
+		boost::unit_test::test_suite * testSuite; //!< Instance of the internal TS.
+		//!@}
+
+	private:
+		/** @name TCs' implementation
+		*/
+		//!@{
+
+		/** Test CShaderParserException::GetCallStack, and the symbol names cache
+		*/
+		void TestCase_ExceptionCallStack();
+
+		//!@}
+	};
+}
+END_NAMESPACE_SHADER_PARSER_TEST
+
+#endif // ___SHADER_PARSER_EXCEPTION_TEST_H___
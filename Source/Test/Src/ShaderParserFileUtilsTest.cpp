@@ -0,0 +1,439 @@
+/************************************************************************//**
+ * @file ShaderParserFileUtilsTest.cpp
+ * @author Sylvain Doremus
+ * @version 1.0
+ * @date 11/23/2015
+ *
+ *
+ * @brief Class testing FileUtils functions
+*
+***************************************************************************/
+
+#include "ShaderParserTestPch.h"
+
+#include "ShaderParserFileUtilsTest.h"
+
+#include "ShaderParserTestHelpers.h"
+
+#include <ShaderParserFileUtils.h>
+#include <ShaderParserFileWatcher.h>
+#include <ShaderParserFileWriter.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+#if !defined( _WIN32 )
+#	include <sys/resource.h>
+#	include <sys/stat.h>
+#endif
+
+extern NAMESPACE_SHADER_PARSER::String g_path;
+
+BEGIN_NAMESPACE_SHADER_PARSER_TEST
+{
+	namespace
+	{
+		/** Creates a files tree in the test folder
+		@return
+			The tree root.
+		*/
+		String CreateTree( std::vector< std::pair< String, String > > const & files )
+		{
+			String l_root = g_path + STR( "ShaderParserTestTree" );
+			boost::filesystem::remove_all( l_root );
+
+			for ( auto & l_file : files )
+			{
+				boost::filesystem::path l_path( l_root + PATH_SEP + l_file.first );
+				boost::filesystem::create_directories( l_path.parent_path() );
+				std::ofstream l_stream( l_path.string(), std::ios::binary );
+				l_stream << l_file.second;
+			}
+
+			return l_root;
+		}
+
+		/** Reads a file
+		*/
+		String ReadFile( String const & path )
+		{
+			std::ifstream l_stream( path, std::ios::binary );
+			return String( std::istreambuf_iterator< char >( l_stream ), std::istreambuf_iterator< char >() );
+		}
+
+		/** Writes a file
+		*/
+		void WriteFile( String const & path, String const & content )
+		{
+			std::ofstream l_stream( path, std::ios::binary );
+			l_stream << content;
+		}
+	}
+
+	CShaderParserFileUtilsTest::CShaderParserFileUtilsTest()
+	{
+	}
+
+	CShaderParserFileUtilsTest::~CShaderParserFileUtilsTest()
+	{
+	}
+
+	boost::unit_test::test_suite * CShaderParserFileUtilsTest::Init_Test_Suite()
+	{
+		//!@remarks Create the internal TS instance.
+#if BOOST_VERSION < 105900
+		testSuite = new boost::unit_test::test_suite( "CShaderParserFileUtilsTest" );
+#else
+		testSuite = new boost::unit_test::test_suite( "CShaderParserFileUtilsTest", __FILE__, __LINE__ );
+#endif
+
+		//!@remarks Add the TC to the internal TS.
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserFileUtilsTest::TestCase_FileUtilsListFiles, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserFileUtilsTest::TestCase_FileUtilsLoadTree, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserFileUtilsTest::TestCase_FileUtilsWatcher, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserFileUtilsTest::TestCase_FileUtilsWriter, this ) ) );
+
+		//!@remarks Return the TS instance.
+		return testSuite;
+	}
+
+	void CShaderParserFileUtilsTest::TestCase_FileUtilsListFiles()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_FileUtilsListFiles ****" );
+
+		String l_root = CreateTree(
+		{
+			{ STR( "a.vert" ), STR( "" ) },
+			{ STR( "b.frag" ), STR( "" ) },
+			{ STR( "notes.txt" ), STR( "" ) },
+			{ String( STR( "lib" ) ) + PATH_SEP + STR( "c.glsl" ), STR( "" ) },
+			{ String( STR( "lib" ) ) + PATH_SEP + STR( "deep" ) + PATH_SEP + STR( "d.vert" ), STR( "" ) },
+		} );
+
+		std::vector< String > l_files = FileUtils::ListFiles( l_root, STR( "*.vert;*.glsl" ) );
+		BOOST_REQUIRE_EQUAL( l_files.size(), 3 );
+		BOOST_CHECK_EQUAL( l_files[0], l_root + PATH_SEP + STR( "a.vert" ) );
+		BOOST_CHECK_EQUAL( l_files[1], l_root + PATH_SEP + STR( "lib" ) + PATH_SEP + STR( "c.glsl" ) );
+		BOOST_CHECK_EQUAL( l_files[2], l_root + PATH_SEP + STR( "lib" ) + PATH_SEP + STR( "deep" ) + PATH_SEP + STR( "d.vert" ) );
+		BOOST_CHECK_EQUAL( FileUtils::ListFiles( l_root, String() ).size(), 5 );
+		BOOST_CHECK_EQUAL( FileUtils::ListFiles( l_root, STR( "?.*" ) ).size(), 4 );
+		BOOST_CHECK_EQUAL( FileUtils::ListFiles( l_root, STR( "*s*t*" ) ).size(), 1 );
+		BOOST_CHECK( FileUtils::ListFiles( l_root, STR( "*.hlsl" ) ).empty() );
+		BOOST_CHECK( FileUtils::ListFiles( l_root + STR( "Missing" ), String() ).empty() );
+
+		boost::filesystem::remove_all( l_root );
+		CLogger::LogInfo( StringStream() << "**** End TestCase_FileUtilsListFiles ****" );
+	}
+
+	void CShaderParserFileUtilsTest::TestCase_FileUtilsLoadTree()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_FileUtilsLoadTree ****" );
+
+		std::vector< std::pair< String, String > > l_sources;
+		l_sources.push_back( { STR( "empty.glsl" ), String() } );
+		l_sources.push_back( { STR( "large.glsl" ), String( 1024 * 1024 + 17, 'x' ) } );
+
+		for ( int i = 0; i < 100; ++i )
+		{
+			l_sources.push_back( { STR( "folder" ) + std::to_string( i % 7 ) + PATH_SEP + STR( "shader" ) + std::to_string( i ) + STR( ".glsl" ), STR( "float a = " ) + std::to_string( i ) + STR( ".0;\n" ) } );
+		}
+
+		String l_root = CreateTree( l_sources );
+		std::map< String, String > l_expected;
+
+		for ( auto & l_source : l_sources )
+		{
+			l_expected[l_root + PATH_SEP + l_source.first] = l_source.second;
+		}
+
+		for ( auto l_method : { EReadMethod_AUTO, EReadMethod_THREADS } )
+		{
+			for ( size_t l_inFlight : { size_t( 1 ), size_t( 8 ), FileUtils::DEFAULT_READS_IN_FLIGHT } )
+			{
+				std::map< String, String > l_loaded;
+				size_t l_count = FileUtils::LoadTree( l_root, STR( "*.glsl" ), [&l_loaded]( FileUtils::SLoadedFile & file )
+				{
+					BOOST_CHECK_EQUAL( file.m_error, 0 );
+					l_loaded[file.m_path] = std::move( file.m_content );
+				}, l_inFlight, l_method );
+				BOOST_CHECK_EQUAL( l_count, l_expected.size() );
+				BOOST_CHECK( l_loaded == l_expected );
+
+				std::vector< FileUtils::SLoadedFile > l_files = FileUtils::LoadTree( l_root, STR( "*.glsl" ), l_inFlight, l_method );
+				BOOST_REQUIRE_EQUAL( l_files.size(), l_expected.size() );
+				auto l_it = l_expected.begin();
+
+				for ( auto & l_file : l_files )
+				{
+					BOOST_CHECK_EQUAL( l_file.m_path, l_it->first );
+					BOOST_CHECK( l_file.m_content == l_it->second );
+					++l_it;
+				}
+			}
+
+			// An exception thrown while loading doesn't leave reads in flight
+			size_t l_received = 0;
+			BOOST_CHECK_THROW( FileUtils::LoadTree( l_root, String(), [&l_received]( FileUtils::SLoadedFile & )
+			{
+				if ( ++l_received == 10 )
+				{
+					throw std::runtime_error( "Stop" );
+				}
+			}, 8, l_method ), std::runtime_error );
+			BOOST_CHECK_EQUAL( l_received, 10 );
+		}
+
+		BOOST_CHECK( FileUtils::LoadTree( l_root + STR( "Missing" ), String() ).empty() );
+
+		// The files which can't be read are reported with their error, the other ones are loaded
+		std::vector< String > l_paths{ l_root + PATH_SEP + STR( "empty.glsl" ), l_root + PATH_SEP + STR( "folder0" ), l_root + PATH_SEP + STR( "missing.glsl" ), l_root + PATH_SEP + STR( "large.glsl" ) };
+
+		for ( auto l_method : { EReadMethod_AUTO, EReadMethod_THREADS } )
+		{
+			std::map< String, FileUtils::SLoadedFile > l_loaded;
+			FileUtils::LoadFiles( l_paths, [&l_loaded]( FileUtils::SLoadedFile & file )
+			{
+				l_loaded[file.m_path] = std::move( file );
+			}, 8, l_method );
+			BOOST_REQUIRE_EQUAL( l_loaded.size(), l_paths.size() );
+			BOOST_CHECK_EQUAL( l_loaded[l_paths[0]].m_error, 0 );
+			BOOST_CHECK_NE( l_loaded[l_paths[1]].m_error, 0 );
+			BOOST_CHECK( l_loaded[l_paths[1]].m_content.empty() );
+			BOOST_CHECK_EQUAL( l_loaded[l_paths[2]].m_error, ENOENT );
+			BOOST_CHECK_EQUAL( l_loaded[l_paths[3]].m_error, 0 );
+			BOOST_CHECK( l_loaded[l_paths[3]].m_content == l_expected[l_paths[3]] );
+		}
+
+#if !defined( _WIN32 )
+
+		// More files than file descriptors, and more reads in flight than file descriptors
+		rlimit l_limit;
+		BOOST_REQUIRE_EQUAL( getrlimit( RLIMIT_NOFILE, &l_limit ), 0 );
+		rlimit l_lowered = l_limit;
+		l_lowered.rlim_cur = std::min< rlim_t >( l_limit.rlim_cur, 64 );
+		BOOST_REQUIRE_EQUAL( setrlimit( RLIMIT_NOFILE, &l_lowered ), 0 );
+
+		for ( auto l_method : { EReadMethod_AUTO, EReadMethod_THREADS } )
+		{
+			std::map< String, String > l_loaded;
+			size_t l_count = FileUtils::LoadTree( l_root, STR( "*.glsl" ), [&l_loaded]( FileUtils::SLoadedFile & file )
+			{
+				BOOST_CHECK_EQUAL( file.m_error, 0 );
+				l_loaded[file.m_path] = std::move( file.m_content );
+			}, 4096, l_method );
+			BOOST_CHECK_GT( l_count, l_lowered.rlim_cur );
+			BOOST_CHECK( l_loaded == l_expected );
+		}
+
+		setrlimit( RLIMIT_NOFILE, &l_limit );
+
+#endif
+
+		boost::filesystem::remove_all( l_root );
+		CLogger::LogInfo( StringStream() << "**** End TestCase_FileUtilsLoadTree ****" );
+	}
+
+	void CShaderParserFileUtilsTest::TestCase_FileUtilsWatcher()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_FileUtilsWatcher ****" );
+
+		String l_root = CreateTree(
+		{
+			{ STR( "common.h" ), STR( "float common;\n" ) },
+			{ STR( "a.glsl" ), STR( "#version 330\n#include \"common.h\"\n" ) },
+			{ STR( "b.glsl" ), STR( "  # include <lib/c.glsl>\n" ) },
+			{ String( STR( "lib" ) ) + PATH_SEP + STR( "c.glsl" ), STR( "#include \"../common.h\"\n" ) },
+			{ STR( "d.glsl" ), STR( "float d;\n" ) },
+			{ STR( "f.glsl" ), STR( "#include \"../ShaderParserTestShared/shared.h\"\n" ) },
+		} );
+		//!@remarks The watcher reports canonical paths.
+		l_root = boost::filesystem::canonical( l_root ).string();
+		String l_sep = PATH_SEP;
+		String l_shared = boost::filesystem::path( l_root ).parent_path().string() + l_sep + STR( "ShaderParserTestShared" );
+		boost::filesystem::remove_all( l_shared );
+		boost::filesystem::create_directories( l_shared );
+		WriteFile( l_shared + l_sep + STR( "shared.h" ), STR( "float shared;\n" ) );
+		std::chrono::milliseconds l_debounce( 50 );
+		std::mutex l_mutex;
+		std::condition_variable l_changed;
+		std::deque< std::vector< String > > l_changes;
+
+		auto l_wait = [&]( std::chrono::milliseconds timeout )
+		{
+			std::unique_lock< std::mutex > l_lock( l_mutex );
+			l_changed.wait_for( l_lock, timeout, [&l_changes]()
+			{
+				return !l_changes.empty();
+			} );
+			std::vector< String > l_result;
+
+			if ( !l_changes.empty() )
+			{
+				l_result = std::move( l_changes.front() );
+				l_changes.pop_front();
+			}
+
+			return l_result;
+		};
+
+		{
+			CFileWatcher l_watcher( l_root, STR( "*.glsl" ), [&]( std::vector< String > const & files )
+			{
+				std::unique_lock< std::mutex > l_lock( l_mutex );
+				l_changes.push_back( files );
+				l_changed.notify_one();
+			}, l_debounce );
+
+			if ( !l_watcher.IsWatching() )
+			{
+				CLogger::LogWarning( StringStream() << "TestCase_FileUtilsWatcher skipped, files watching is not supported" );
+				boost::filesystem::remove_all( l_shared );
+				boost::filesystem::remove_all( l_root );
+				return;
+			}
+
+			// A burst of writes to an included file is reported once, with all the files including it
+			for ( int i = 0; i < 5; ++i )
+			{
+				WriteFile( l_root + l_sep + STR( "common.h" ), STR( "float common" ) + std::to_string( i ) + STR( ";\n" ) );
+			}
+
+			std::vector< String > l_expected = { l_root + l_sep + STR( "a.glsl" ), l_root + l_sep + STR( "b.glsl" ), l_root + l_sep + STR( "lib" ) + l_sep + STR( "c.glsl" ) };
+			BOOST_CHECK( l_wait( std::chrono::seconds( 5 ) ) == l_expected );
+
+			// A file nobody includes is reported alone
+			WriteFile( l_root + l_sep + STR( "d.glsl" ), STR( "float d2;\n" ) );
+			l_expected = { l_root + l_sep + STR( "d.glsl" ) };
+			BOOST_CHECK( l_wait( std::chrono::seconds( 5 ) ) == l_expected );
+
+			// The new includes are followed
+			WriteFile( l_root + l_sep + STR( "d.glsl" ), STR( "#include \"common.h\"\n" ) );
+			BOOST_CHECK( l_wait( std::chrono::seconds( 5 ) ) == l_expected );
+			WriteFile( l_root + l_sep + STR( "common.h" ), STR( "float common;\n" ) );
+			BOOST_CHECK_EQUAL( l_wait( std::chrono::seconds( 5 ) ).size(), 4 );
+
+			// The files of new folders are reported, and watched
+			boost::filesystem::create_directories( l_root + l_sep + STR( "new" ) );
+			WriteFile( l_root + l_sep + STR( "new" ) + l_sep + STR( "e.glsl" ), STR( "float e;\n" ) );
+			l_expected = { l_root + l_sep + STR( "new" ) + l_sep + STR( "e.glsl" ) };
+			BOOST_CHECK( l_wait( std::chrono::seconds( 5 ) ) == l_expected );
+
+			// Deleting an included file reports the files including it, but not the deleted file
+			boost::filesystem::remove( l_root + l_sep + STR( "lib" ) + l_sep + STR( "c.glsl" ) );
+			l_expected = { l_root + l_sep + STR( "b.glsl" ) };
+			BOOST_CHECK( l_wait( std::chrono::seconds( 5 ) ) == l_expected );
+
+			// The files included from outside the tree are watched too, and report the files including them
+			WriteFile( l_shared + l_sep + STR( "shared.h" ), STR( "float shared2;\n" ) );
+			l_expected = { l_root + l_sep + STR( "f.glsl" ) };
+			BOOST_CHECK( l_wait( std::chrono::seconds( 5 ) ) == l_expected );
+
+			// The files not matching the pattern, and included by no file, are ignored, as the other files outside the tree
+			WriteFile( l_root + l_sep + STR( "notes.txt" ), STR( "notes" ) );
+			WriteFile( l_shared + l_sep + STR( "other.glsl" ), STR( "float other;\n" ) );
+			BOOST_CHECK( l_wait( 4 * l_debounce ).empty() );
+		}
+
+		boost::filesystem::remove_all( l_shared );
+		boost::filesystem::remove_all( l_root );
+		CLogger::LogInfo( StringStream() << "**** End TestCase_FileUtilsWatcher ****" );
+	}
+
+	void CShaderParserFileUtilsTest::TestCase_FileUtilsWriter()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_FileUtilsWriter ****" );
+
+		String l_root = CreateTree( { { STR( "old.bin" ), STR( "old content" ) } } );
+		String l_sep = PATH_SEP;
+		String l_large;
+
+		for ( int i = 0; l_large.size() < 3 * 4096; ++i )
+		{
+			l_large += std::to_string( i ) + STR( "," );
+		}
+
+		// The content is written in buffer sized chunks, and the destination file is only replaced on commit
+		for ( bool l_sync : { false, true } )
+		{
+			String l_path = l_root + l_sep + STR( "old.bin" );
+			CFileWriter l_writer( l_path, l_sync, 4096 );
+			l_writer.Write( l_large.substr( 0, 100 ) );
+			l_writer.Write( l_large.substr( 100, 4090 ) );
+			l_writer.Write( l_large.substr( 4190 ) );
+			BOOST_CHECK_EQUAL( ReadFile( l_path ), STR( "old content" ) );
+			l_writer.Commit();
+			BOOST_CHECK( ReadFile( l_path ) == l_large );
+			BOOST_CHECK_THROW( l_writer.Write( l_large ), CShaderParserException );
+			WriteFile( l_path, STR( "old content" ) );
+		}
+
+		// A writer destroyed without commit leaves the destination file untouched
+		{
+			CFileWriter l_writer( l_root + l_sep + STR( "old.bin" ) );
+			l_writer.Write( l_large );
+		}
+
+		BOOST_CHECK_EQUAL( ReadFile( l_root + l_sep + STR( "old.bin" ) ), STR( "old content" ) );
+		BOOST_CHECK_THROW( CFileWriter( l_root + l_sep + STR( "missing" ) + l_sep + STR( "new.bin" ) ), CShaderParserException );
+
+#if !defined( _WIN32 )
+
+		// The replaced file keeps its mode
+		for ( mode_t l_mode : { mode_t( 0600 ), mode_t( 0755 ) } )
+		{
+			String l_path = l_root + l_sep + STR( "old.bin" );
+			BOOST_REQUIRE_EQUAL( chmod( l_path.c_str(), l_mode ), 0 );
+			CFileWriter l_writer( l_path );
+			l_writer.Write( l_large );
+			l_writer.Commit();
+			struct stat l_stat;
+			BOOST_REQUIRE_EQUAL( stat( l_path.c_str(), &l_stat ), 0 );
+			BOOST_CHECK_EQUAL( l_stat.st_mode & 07777, l_mode );
+			WriteFile( l_path, STR( "old content" ) );
+		}
+
+#endif
+
+		// A batch shared by concurrent writers
+		{
+			CFileWriteBatch l_batch;
+			std::vector< std::thread > l_threads;
+			boost::filesystem::create_directories( l_root + l_sep + STR( "batch" ) );
+
+			for ( int t = 0; t < 4; ++t )
+			{
+				l_threads.emplace_back( [&l_batch, &l_root, &l_sep, t]()
+				{
+					for ( int i = 0; i < 25; ++i )
+					{
+						String l_name = STR( "file" ) + std::to_string( t * 25 + i ) + STR( ".bin" );
+						CFileWriter l_writer( l_root + l_sep + ( i % 2 ? STR( "batch" ) + l_sep : String() ) + l_name, l_batch );
+						l_writer.Write( l_name );
+						l_writer.Commit();
+					}
+				} );
+			}
+
+			for ( auto & l_thread : l_threads )
+			{
+				l_thread.join();
+			}
+
+			l_batch.Sync();
+		}
+
+		std::vector< String > l_files = FileUtils::ListFiles( l_root, String() );
+		BOOST_CHECK_EQUAL( l_files.size(), 101 );
+
+		for ( auto & l_file : l_files )
+		{
+			String l_name = boost::filesystem::path( l_file ).filename().string();
+			BOOST_CHECK( l_name == STR( "old.bin" ) || ReadFile( l_file ) == l_name );
+		}
+
+		boost::filesystem::remove_all( l_root );
+		CLogger::LogInfo( StringStream() << "**** End TestCase_FileUtilsWriter ****" );
+	}
+}
+END_NAMESPACE_SHADER_PARSER_TEST
@@ -0,0 +1,681 @@
+/************************************************************************//**
+ * @file ShaderParserLoggerTest.cpp
+ * @author Sylvain Doremus
+ * @version 1.0
+ * @date 11/23/2015
+ *
+ *
+ * @brief Class testing CLogger internals
+*
+***************************************************************************/
+
+#include "ShaderParserTestPch.h"
+
+#include "ShaderParserLoggerTest.h"
+
+#include "ShaderParserTestHelpers.h"
+
+#include <ShaderParserLogFormat.h>
+#include <ShaderParserLogSink.h>
+#include <ShaderParserMessageQueue.h>
+
+#include <fstream>
+#include <set>
+#include <thread>
+
+extern NAMESPACE_SHADER_PARSER::String g_path;
+
+BEGIN_NAMESPACE_SHADER_PARSER_TEST
+{
+	CShaderParserLoggerTest::CShaderParserLoggerTest()
+	{
+	}
+
+	CShaderParserLoggerTest::~CShaderParserLoggerTest()
+	{
+	}
+
+	boost::unit_test::test_suite * CShaderParserLoggerTest::Init_Test_Suite()
+	{
+		//!@remarks Create the internal TS instance.
+#if BOOST_VERSION < 105900
+		testSuite = new boost::unit_test::test_suite( "CShaderParserLoggerTest" );
+#else
+		testSuite = new boost::unit_test::test_suite( "CShaderParserLoggerTest", __FILE__, __LINE__ );
+#endif
+
+		//!@remarks Add the TC to the internal TS.
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserLoggerTest::TestCase_LoggerMessageQueue, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserLoggerTest::TestCase_LoggerFlush, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserLoggerTest::TestCase_LoggerDeferredFormat, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserLoggerTest::TestCase_LoggerBinaryLog, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserLoggerTest::TestCase_LoggerLevelMacros, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserLoggerTest::TestCase_LoggerTimestamps, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserLoggerTest::TestCase_LoggerMessageRing, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserLoggerTest::TestCase_LoggerQueueCapacity, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserLoggerTest::TestCase_LoggerSinks, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserLoggerTest::TestCase_LoggerRepeats, this ) ) );
+
+		//!@remarks Return the TS instance.
+		return testSuite;
+	}
+
+	namespace
+	{
+		void CaptureArguments( std::string & arguments, char const * format, ... )
+		{
+			va_list vaList;
+			va_start( vaList, format );
+			LogFormat::Capture( arguments, format, vaList );
+			va_end( vaList );
+		}
+
+		template< typename ... Params >
+		std::string CaptureAndFormat( char const * format, Params ... params )
+		{
+			std::string arguments;
+			CaptureArguments( arguments, format, params... );
+			std::string result;
+			LogFormat::Format( result, format, arguments );
+			return result;
+		}
+	}
+
+	namespace
+	{
+		uint32_t CountLogLines( std::string const & text )
+		{
+			std::ifstream file( g_path + STR( "ShaderParserTest.log" ) );
+			std::string line;
+			uint32_t count = 0;
+
+			while ( std::getline( file, line ) )
+			{
+				if ( line.find( text ) != std::string::npos && line.find( "****" ) == std::string::npos )
+				{
+					++count;
+				}
+			}
+
+			return count;
+		}
+	}
+
+	void CShaderParserLoggerTest::TestCase_LoggerMessageQueue()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_LoggerMessageQueue ****" );
+
+		static const uint32_t PRODUCERS = 4;
+		static const uint32_t MESSAGES = 10000;
+		CMessageQueue queue;
+		std::vector< std::unique_ptr< SMessageCache > > caches;
+		std::vector< std::thread > producers;
+
+		for ( uint32_t i = 0; i < PRODUCERS; ++i )
+		{
+			caches.push_back( std::make_unique< SMessageCache >() );
+		}
+
+		for ( uint32_t i = 0; i < PRODUCERS; ++i )
+		{
+			SMessageCache & cache = *caches[i];
+			producers.emplace_back( [&queue, &cache]()
+			{
+				for ( uint32_t j = 0; j < MESSAGES; ++j )
+				{
+					SMessage * message = cache.Acquire();
+					message->m_type = ELogType_DEBUG;
+					message->m_wide = false;
+					message->m_message = std::to_string( j );
+					queue.Push( message );
+				}
+			} );
+		}
+
+		// Consume concurrently, checking the per producer ordering
+		std::vector< uint32_t > next( PRODUCERS, 0 );
+		uint32_t received = 0;
+
+		while ( received < PRODUCERS * MESSAGES )
+		{
+			SMessage * message = queue.Pop();
+
+			if ( message )
+			{
+				size_t producer = 0;
+
+				while ( caches[producer].get() != message->m_cache )
+				{
+					++producer;
+				}
+
+				BOOST_REQUIRE_LT( producer, PRODUCERS );
+				BOOST_CHECK_EQUAL( message->GetMessage(), std::to_string( next[producer] ) );
+				++next[producer];
+				++received;
+				message->m_cache->Release( message );
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		for ( auto & producer : producers )
+		{
+			producer.join();
+		}
+
+		BOOST_CHECK( queue.Pop() == NULL );
+
+		// Once released, the messages are reused instead of being allocated
+		SMessageCache cache;
+		std::set< SMessage * > used;
+
+		for ( uint32_t i = 0; i < MESSAGES; ++i )
+		{
+			SMessage * message = cache.Acquire();
+			used.insert( message );
+			queue.Push( message );
+			message = queue.Pop();
+			BOOST_REQUIRE( message != NULL );
+			message->m_cache->Release( message );
+		}
+
+		BOOST_CHECK_EQUAL( used.size(), 1 );
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_LoggerMessageQueue ****" );
+	}
+
+	void CShaderParserLoggerTest::TestCase_LoggerFlush()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_LoggerFlush ****" );
+
+		static const uint32_t PRODUCERS = 4;
+		static const uint32_t MESSAGES = 100;
+		std::vector< std::thread > producers;
+
+		for ( uint32_t i = 0; i < PRODUCERS; ++i )
+		{
+			producers.emplace_back( [i]()
+			{
+				for ( uint32_t j = 0; j < MESSAGES; ++j )
+				{
+					CLogger::LogInfo( StringStream() << "TestCase_LoggerFlush " << i << " " << j );
+				}
+			} );
+		}
+
+		for ( auto & producer : producers )
+		{
+			producer.join();
+		}
+
+		BOOST_CHECK_NO_THROW( CLogger::Flush() );
+
+		// Once flushed, every message is in the log file
+		BOOST_CHECK_EQUAL( CountLogLines( "TestCase_LoggerFlush " ), PRODUCERS * MESSAGES );
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_LoggerFlush ****" );
+	}
+
+	void CShaderParserLoggerTest::TestCase_LoggerDeferredFormat()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_LoggerDeferredFormat ****" );
+
+		BOOST_CHECK_EQUAL( CaptureAndFormat( "no argument, 100%%" ), "no argument, 100%" );
+		BOOST_CHECK_EQUAL( CaptureAndFormat( "%d %i %u %x %X %o", -1, 2, 3u, 255u, 255u, 8u ), "-1 2 3 ff FF 10" );
+		BOOST_CHECK_EQUAL( CaptureAndFormat( "%hhd %hu %ld %llu %zu", 257, 65537, -3L, 4ULL, size_t( 5 ) ), "1 1 -3 4 5" );
+		BOOST_CHECK_EQUAL( CaptureAndFormat( "%010i|%-4d|%+d", 100, 1, 2 ), "0000000100|1   |+2" );
+		BOOST_CHECK_EQUAL( CaptureAndFormat( "%*d|%.*f", 4, 7, 2, 3.14159 ), "   7|3.14" );
+		BOOST_CHECK_EQUAL( CaptureAndFormat( "%.2f %e %Lg", 100.0f, 1.5, 2.5L ), "100.00 1.500000e+00 2.5" );
+		BOOST_CHECK_EQUAL( CaptureAndFormat( "%c%s%.3s", 'a', "bcd", "efgh" ), "abcdefg" );
+		BOOST_CHECK_EQUAL( CaptureAndFormat( "%s", static_cast< char const * >( NULL ) ), "(null)" );
+		BOOST_CHECK_EQUAL( CaptureAndFormat( "%ls", L"wide" ), "wide" );
+
+		// A precision bounds the captured string, which needs not be null terminated
+		char const unterminated[] = { 'a', 'b', 'c', 'd' };
+		BOOST_CHECK_EQUAL( CaptureAndFormat( "%.*s|%.2s", 3, unterminated, unterminated ), "abc|ab" );
+		BOOST_CHECK_EQUAL( CaptureAndFormat( "%.*s", -1, "negative" ), "negative" );
+
+		// The captured strings are copies, the formatting can happen after the source is gone
+		std::string arguments;
+		{
+			std::string text( 1000, 'x' );
+			CaptureArguments( arguments, "%s", text.c_str() );
+		}
+		std::string result;
+		LogFormat::Format( result, "%s", arguments );
+		BOOST_CHECK_EQUAL( result, std::string( 1000, 'x' ) );
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_LoggerDeferredFormat ****" );
+	}
+
+	void CShaderParserLoggerTest::TestCase_LoggerBinaryLog()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_LoggerBinaryLog ****" );
+
+		static char const * const FORMAT = "shader %s: %d errors";
+		std::string buffer;
+		LogFormat::WriteBinaryHeader( buffer );
+		LogFormat::WriteBinaryFormat( buffer, 1, FORMAT );
+		std::string arguments;
+		CaptureArguments( arguments, FORMAT, "main.frag", 3 );
+		LogFormat::WriteBinaryMessage( buffer, ELogType_ERROR, 1000, 1, arguments );
+		LogFormat::WriteBinaryMessage( buffer, ELogType_INFO, 2000, 0, "already formatted" );
+
+		FILE * file = tmpfile();
+		BOOST_REQUIRE( file != NULL );
+		fwrite( buffer.data(), 1, buffer.size(), file );
+		rewind( file );
+
+		std::vector< std::tuple< ELogType, int64_t, std::string > > messages;
+		BOOST_CHECK( LogFormat::DecodeBinary( file, [&messages]( ELogType type, int64_t time, std::string const & message )
+		{
+			messages.emplace_back( type, time, message );
+		} ) );
+		fclose( file );
+
+		BOOST_REQUIRE_EQUAL( messages.size(), 2 );
+		BOOST_CHECK_EQUAL( std::get< 0 >( messages[0] ), ELogType_ERROR );
+		BOOST_CHECK_EQUAL( std::get< 1 >( messages[0] ), 1000 );
+		BOOST_CHECK_EQUAL( std::get< 2 >( messages[0] ), "shader main.frag: 3 errors" );
+		BOOST_CHECK_EQUAL( std::get< 0 >( messages[1] ), ELogType_INFO );
+		BOOST_CHECK_EQUAL( std::get< 2 >( messages[1] ), "already formatted" );
+
+		// A truncated file is detected
+		file = tmpfile();
+		BOOST_REQUIRE( file != NULL );
+		fwrite( buffer.data(), 1, buffer.size() - 3, file );
+		rewind( file );
+		BOOST_CHECK( !LogFormat::DecodeBinary( file, []( ELogType, int64_t, std::string const & )
+		{
+		} ) );
+		fclose( file );
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_LoggerBinaryLog ****" );
+	}
+
+	void CShaderParserLoggerTest::TestCase_LoggerLevelMacros()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_LoggerLevelMacros ****" );
+
+		uint32_t evaluated = 0;
+		auto message = [&evaluated]( char const * text )
+		{
+			++evaluated;
+			return std::string( text );
+		};
+
+		CLogger::SetLevel( ELogType_WARNING );
+		BOOST_CHECK( !CLogger::IsEnabled( ELogType_INFO ) );
+		BOOST_CHECK( CLogger::IsEnabled( ELogType_WARNING ) );
+
+		// The arguments of the disabled levels are not evaluated
+		PARSER_LOG_DEBUG( message( "TestCase_LoggerLevelMacros debug" ) );
+		PARSER_LOG_INFO( message( "TestCase_LoggerLevelMacros info" ) );
+		BOOST_CHECK_EQUAL( evaluated, 0 );
+		PARSER_LOG_WARNING( message( "TestCase_LoggerLevelMacros warning" ) );
+		PARSER_LOG_ERROR( "TestCase_LoggerLevelMacros %s", message( "error" ).c_str() );
+		BOOST_CHECK_EQUAL( evaluated, 2 );
+
+#if defined( NDEBUG )
+		CLogger::SetLevel( ELogType_INFO );
+#else
+		CLogger::SetLevel( ELogType_DEBUG );
+#endif
+
+		// The debug logs are compiled out of release builds
+		PARSER_LOG_DEBUG( message( "TestCase_LoggerLevelMacros debug" ) );
+#if defined( NDEBUG )
+		BOOST_CHECK_EQUAL( evaluated, 2 );
+#else
+		BOOST_CHECK_EQUAL( evaluated, 3 );
+#endif
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_LoggerLevelMacros ****" );
+	}
+
+	void CShaderParserLoggerTest::TestCase_LoggerTimestamps()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_LoggerTimestamps ****" );
+
+		time_t seconds = 1446000000;
+		char expected[33] = { 0 };
+		strftime( expected, 32, "%Y-%m-%d %H:%M:%S", localtime( &seconds ) );
+		LogFormat::CTimestampFormatter formatter;
+		std::string timestamp;
+		formatter.Format( timestamp, int64_t( seconds ) * 1000000 + 42 );
+		BOOST_CHECK_EQUAL( timestamp, std::string( expected ) + ".000042" );
+
+		// Same second, only the microseconds change
+		timestamp.clear();
+		formatter.Format( timestamp, int64_t( seconds ) * 1000000 + 999999 );
+		BOOST_CHECK_EQUAL( timestamp, std::string( expected ) + ".999999" );
+
+		// Next second
+		++seconds;
+		strftime( expected, 32, "%Y-%m-%d %H:%M:%S", localtime( &seconds ) );
+		timestamp.clear();
+		formatter.Format( timestamp, int64_t( seconds ) * 1000000 );
+		BOOST_CHECK_EQUAL( timestamp, std::string( expected ) + ".000000" );
+
+		// The steady clock times are converted to the system clock
+		int64_t offset = LogFormat::GetSteadyToSystemOffset();
+		int64_t now = std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::system_clock::now().time_since_epoch() ).count();
+		BOOST_CHECK_LT( std::abs( LogFormat::ToSystemTime( std::chrono::steady_clock::now(), offset ) - now ), 1000000 );
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_LoggerTimestamps ****" );
+	}
+
+	void CShaderParserLoggerTest::TestCase_LoggerMessageRing()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_LoggerMessageRing ****" );
+
+		SMessage messages[8];
+		CMessageRing ring( 3 );
+		BOOST_CHECK_EQUAL( ring.GetCapacity(), 4 );
+		BOOST_CHECK( ring.IsEmpty() );
+
+		for ( size_t i = 0; i < 4; ++i )
+		{
+			BOOST_CHECK( ring.TryPush( &messages[i] ) );
+		}
+
+		// Full
+		BOOST_CHECK( !ring.TryPush( &messages[4] ) );
+		BOOST_CHECK( !ring.IsEmpty() );
+		BOOST_CHECK( ring.TryPop() == &messages[0] );
+		BOOST_CHECK( ring.TryPush( &messages[4] ) );
+
+		for ( size_t i = 1; i < 5; ++i )
+		{
+			BOOST_CHECK( ring.TryPop() == &messages[i] );
+		}
+
+		BOOST_CHECK( ring.TryPop() == NULL );
+		BOOST_CHECK( ring.IsEmpty() );
+
+		// The smallest rings hold two messages, none is overwritten
+		for ( size_t capacity : { 0, 1, 2 } )
+		{
+			CMessageRing small( capacity );
+			BOOST_CHECK_EQUAL( small.GetCapacity(), 2 );
+			BOOST_CHECK( small.TryPush( &messages[0] ) );
+			BOOST_CHECK( small.TryPush( &messages[1] ) );
+			BOOST_CHECK( !small.TryPush( &messages[2] ) );
+			BOOST_CHECK( small.TryPop() == &messages[0] );
+			BOOST_CHECK( small.TryPop() == &messages[1] );
+			BOOST_CHECK( small.TryPop() == NULL );
+			BOOST_CHECK( small.IsEmpty() );
+		}
+
+		// Concurrent producers and consumer, every message goes through once
+		static const uint32_t PRODUCERS = 4;
+		static const uint32_t MESSAGES = 10000;
+		std::vector< SMessage > pool( PRODUCERS * MESSAGES );
+		std::vector< std::thread > producers;
+
+		for ( uint32_t i = 0; i < PRODUCERS; ++i )
+		{
+			producers.emplace_back( [&ring, &pool, i]()
+			{
+				for ( uint32_t j = 0; j < MESSAGES; ++j )
+				{
+					while ( !ring.TryPush( &pool[i * MESSAGES + j] ) )
+					{
+						std::this_thread::yield();
+					}
+				}
+			} );
+		}
+
+		std::set< SMessage * > received;
+
+		while ( received.size() < pool.size() )
+		{
+			SMessage * message = ring.TryPop();
+
+			if ( message )
+			{
+				BOOST_CHECK( received.insert( message ).second );
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		for ( auto & producer : producers )
+		{
+			producer.join();
+		}
+
+		BOOST_CHECK( ring.IsEmpty() );
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_LoggerMessageRing ****" );
+	}
+
+	void CShaderParserLoggerTest::TestCase_LoggerQueueCapacity()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_LoggerQueueCapacity ****" );
+
+		static const uint32_t PRODUCERS = 4;
+		static const uint32_t MESSAGES = 2000;
+		static char const * const NAMES[EBackpressure_COUNT] = { "block", "reject", "drop_oldest" };
+
+		for ( int policy = 0; policy < EBackpressure_COUNT; ++policy )
+		{
+			uint64_t dropped = CLogger::GetDroppedCount( ELogType_INFO );
+			CLogger::SetQueueCapacity( 4, EBackpressure( policy ) );
+			std::string text = std::string( "TestCase_LoggerQueueCapacity " ) + NAMES[policy] + " ";
+			std::vector< std::thread > producers;
+
+			for ( uint32_t i = 0; i < PRODUCERS; ++i )
+			{
+				producers.emplace_back( [&text]()
+				{
+					for ( uint32_t j = 0; j < MESSAGES; ++j )
+					{
+						CLogger::LogInfo( text + std::to_string( j ) );
+					}
+				} );
+			}
+
+			for ( auto & producer : producers )
+			{
+				producer.join();
+			}
+
+			CLogger::Flush();
+			dropped = CLogger::GetDroppedCount( ELogType_INFO ) - dropped;
+
+			// Every message is either logged or dropped, and the drops are reported
+			BOOST_CHECK_EQUAL( CountLogLines( text ) + dropped, PRODUCERS * MESSAGES );
+
+			if ( policy == EBackpressure_BLOCK )
+			{
+				BOOST_CHECK_EQUAL( dropped, 0 );
+			}
+			else if ( dropped )
+			{
+				BOOST_CHECK_GT( CountLogLines( "Logger queue full" ), 0 );
+			}
+		}
+
+		// A one message capacity still gives a working ring, every blocked message gets logged
+		CLogger::SetQueueCapacity( 1, EBackpressure_BLOCK );
+
+		for ( uint32_t j = 0; j < MESSAGES; ++j )
+		{
+			CLogger::LogInfo( "TestCase_LoggerQueueCapacity single " + std::to_string( j ) );
+		}
+
+		CLogger::Flush();
+		BOOST_CHECK_EQUAL( CountLogLines( "TestCase_LoggerQueueCapacity single " ), MESSAGES );
+
+		CLogger::SetQueueCapacity( 0 );
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_LoggerQueueCapacity ****" );
+	}
+
+	void CShaderParserLoggerTest::TestCase_LoggerSinks()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_LoggerSinks ****" );
+
+		static const uint32_t MESSAGES = 100;
+		std::shared_ptr< CMemoryLogSink > memory = std::make_shared< CMemoryLogSink >( 10 );
+		std::shared_ptr< CMemoryLogSink > threaded = std::make_shared< CMemoryLogSink >( MESSAGES );
+		String path = g_path + STR( "ShaderParserTestSink.log" );
+		LogSinkSPtr file = std::make_shared< CFileLogSink >( path );
+		size_t called = 0;
+		std::thread::id caller;
+		LogSinkSPtr callback = std::make_shared< CCallbackLogSink >( [&called, &caller]( LogRecordArray const & records )
+		{
+			for ( auto && record : records )
+			{
+				if ( record.m_text.find( "TestCase_LoggerSinks " ) == 0 )
+				{
+					++called;
+				}
+			}
+
+			caller = std::this_thread::get_id();
+		} );
+
+		CLogger::AddSink( memory );
+		CLogger::AddSink( threaded, true );
+		CLogger::AddSink( file, true );
+		CLogger::AddSink( callback );
+
+		for ( uint32_t i = 0; i < MESSAGES; ++i )
+		{
+			CLogger::LogWarning( StringStream() << "TestCase_LoggerSinks " << i );
+		}
+
+		CLogger::Flush();
+
+		// The callback is called from the logging thread
+		BOOST_CHECK_EQUAL( called, MESSAGES );
+		BOOST_CHECK( caller != std::this_thread::get_id() );
+
+		// The memory sink keeps the last messages only
+		LogRecordArray records = memory->GetRecords();
+		BOOST_CHECK_EQUAL( records.size(), 10 );
+		BOOST_CHECK_EQUAL( records.back().m_text, "TestCase_LoggerSinks 99" );
+		BOOST_CHECK_EQUAL( records.back().m_type, ELogType_WARNING );
+
+		// Once flushed, the sinks having their own thread have received every message
+		records = threaded->GetRecords();
+		BOOST_CHECK_EQUAL( records.size(), MESSAGES );
+
+		for ( uint32_t i = 0; i < records.size(); ++i )
+		{
+			BOOST_CHECK_EQUAL( records[i].m_text, "TestCase_LoggerSinks " + std::to_string( i ) );
+		}
+
+		CLogger::RemoveSink( memory );
+		CLogger::RemoveSink( threaded );
+		CLogger::RemoveSink( file );
+		CLogger::RemoveSink( callback );
+		memory->Clear();
+		CLogger::LogWarning( "TestCase_LoggerSinks removed" );
+		CLogger::Flush();
+
+		// The removed sinks don't receive the messages anymore
+		BOOST_CHECK( memory->GetRecords().empty() );
+		BOOST_CHECK_EQUAL( called, MESSAGES );
+
+		// The file sink writes the messages with their timestamp and header
+		file.reset();
+		std::ifstream stream( path );
+		std::string line;
+		uint32_t count = 0;
+
+		while ( std::getline( stream, line ) )
+		{
+			if ( line.find( CLogger::GetHeader( ELogType_WARNING ) + "TestCase_LoggerSinks " ) != std::string::npos )
+			{
+				++count;
+			}
+		}
+
+		BOOST_CHECK_EQUAL( count, MESSAGES );
+		stream.close();
+		std::remove( path.c_str() );
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_LoggerSinks ****" );
+	}
+
+	void CShaderParserLoggerTest::TestCase_LoggerRepeats()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_LoggerRepeats ****" );
+
+		static const uint32_t MESSAGES = 100;
+		std::shared_ptr< CMemoryLogSink > sink = std::make_shared< CMemoryLogSink >( 4 * MESSAGES );
+		CLogger::AddSink( sink );
+		auto count = [&sink]( std::string const & text )
+		{
+			LogRecordArray records = sink->GetRecords();
+			return std::count_if( records.begin(), records.end(), [&text]( SLogRecord const & record )
+			{
+				return record.m_text.find( text ) != std::string::npos;
+			} );
+		};
+
+		// The repeats of a message are collapsed, whatever the way it is logged
+		uint64_t repeated = CLogger::GetRepeatedCount( ELogType_WARNING );
+		CLogger::SetRepeatWindow( std::chrono::minutes( 1 ) );
+
+		for ( uint32_t i = 0; i < MESSAGES; ++i )
+		{
+			CLogger::LogWarning( "TestCase_LoggerRepeats same %d", 1 );
+			CLogger::LogWarning( "TestCase_LoggerRepeats other" );
+		}
+
+		CLogger::Flush();
+		BOOST_CHECK_EQUAL( count( "TestCase_LoggerRepeats same 1" ), 2 );
+		BOOST_CHECK_EQUAL( count( "Message repeated 99 times: TestCase_LoggerRepeats same 1" ), 1 );
+		BOOST_CHECK_EQUAL( count( "Message repeated 99 times: TestCase_LoggerRepeats other" ), 1 );
+		BOOST_CHECK_EQUAL( CLogger::GetRepeatedCount( ELogType_WARNING ) - repeated, 2 * ( MESSAGES - 1 ) );
+
+		// The same message with another level is not a repeat
+		CLogger::LogError( "TestCase_LoggerRepeats other" );
+		CLogger::Flush();
+		BOOST_CHECK_EQUAL( count( "TestCase_LoggerRepeats other" ), 3 );
+
+		// Once the window has elapsed, the message is written again
+		sink->Clear();
+		CLogger::SetRepeatWindow( std::chrono::milliseconds( 50 ) );
+		CLogger::LogWarning( "TestCase_LoggerRepeats window" );
+		CLogger::LogWarning( "TestCase_LoggerRepeats window" );
+		std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+		CLogger::LogWarning( "TestCase_LoggerRepeats window" );
+		CLogger::Flush();
+		BOOST_CHECK_EQUAL( count( "TestCase_LoggerRepeats window" ), 3 );
+		BOOST_CHECK_EQUAL( count( "Message repeated 1 times: TestCase_LoggerRepeats window" ), 1 );
+		CLogger::SetRepeatWindow( std::chrono::milliseconds( 0 ) );
+
+		// The messages exceeding the rate limit are dropped, and reported
+		sink->Clear();
+		uint64_t limited = CLogger::GetRateLimitedCount( ELogType_WARNING );
+		CLogger::SetRateLimit( ELogType_WARNING, 10 );
+
+		for ( uint32_t i = 0; i < MESSAGES; ++i )
+		{
+			CLogger::LogWarning( StringStream() << "TestCase_LoggerRepeats limited " << i );
+		}
+
+		CLogger::Flush();
+		CLogger::SetRateLimit( ELogType_WARNING, 0 );
+		limited = CLogger::GetRateLimitedCount( ELogType_WARNING ) - limited;
+		BOOST_CHECK_GT( limited, 0 );
+		BOOST_CHECK_EQUAL( count( "TestCase_LoggerRepeats limited " ) + limited, MESSAGES );
+		BOOST_CHECK_GT( count( "Logger rate limit reached" ), 0 );
+
+		CLogger::RemoveSink( sink );
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_LoggerRepeats ****" );
+	}
+}
+END_NAMESPACE_SHADER_PARSER_TEST
@@ -0,0 +1,101 @@
+/************************************************************************//**
+ * @file ShaderParserLoggerTest.h
+ * @author Sylvain Doremus
+ * @version 1.0
+ * @date 11/23/2015
+ *
+ *
+ * @brief Class testing CLogger internals
+*
+***************************************************************************/
+
+#ifndef ___SHADER_PARSER_LOGGER_TEST_H___
+#define ___SHADER_PARSER_LOGGER_TEST_H___
+
+#include "ShaderParserTestPrerequisites.h"
+
+#include <boost/test/unit_test_suite.hpp>
+
+BEGIN_NAMESPACE_SHADER_PARSER_TEST
+{
+	/** ShaderParser unit test class
+	*/
+	class CShaderParserLoggerTest
+	{
+		/** @name Default constructor / Destructor */
+		//!@{
+	public:
+		/** Default constructor.
+		*/
+		CShaderParserLoggerTest();
+
+		/** Destructor.
+		*/
+		~CShaderParserLoggerTest();
+		//!@}
+
+	public:
+		/** @name Master TS implementation
+		*  Required Master TS implementation in TC
+		*/
+		//!@{
+		/** @brief  Initialization of the Internal TS
+		 @return testSuite Pointer on the TS to be included in the Master TS.
+		*/
+		boost::unit_test::test_suite * Init_Test_Suite();
+
+	private:
+		boost::unit_test::test_suite * testSuite; //!< Instance of the internal TS.
+		//!@}
+
+	private:
+		/** @name TCs' implementation
+		*/
+		//!@{
+
+		/** Test CMessageQueue with concurrent producers, and SMessageCache recycling
+		*/
+		void TestCase_LoggerMessageQueue();
+
+		/** Test CLogger::Flush with concurrent producers
+		*/
+		void TestCase_LoggerFlush();
+
+		/** Test LogFormat::Capture and LogFormat::Format functions
+		*/
+		void TestCase_LoggerDeferredFormat();
+
+		/** Test the binary log files writing and decoding
+		*/
+		void TestCase_LoggerBinaryLog();
+
+		/** Test the PARSER_LOG_* macros
+		*/
+		void TestCase_LoggerLevelMacros();
+
+		/** Test LogFormat::CTimestampFormatter class
+		*/
+		void TestCase_LoggerTimestamps();
+
+		/** Test CMessageRing class
+		*/
+		void TestCase_LoggerMessageRing();
+
+		/** Test CLogger::SetQueueCapacity overflow policies
+		*/
+		void TestCase_LoggerQueueCapacity();
+
+		/** Test the log sinks, given the messages on the logging thread or on their own thread
+		*/
+		void TestCase_LoggerSinks();
+
+		/** Test the repeated messages suppression and the rate limits
+		*/
+		void TestCase_LoggerRepeats();
+
+		//!@}
+	};
+}
+END_NAMESPACE_SHADER_PARSER_TEST
+
+#endif // ___SHADER_PARSER_LOGGER_TEST_H___
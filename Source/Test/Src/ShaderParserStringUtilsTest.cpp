@@ -15,6 +15,10 @@
 
 #include "ShaderParserTestHelpers.h"
 
+#include <ShaderParserException.h>
+#include <ShaderParserFormat.h>
+#include <ShaderParserReplacer.h>
+
 BEGIN_NAMESPACE_SHADER_PARSER_TEST
 {
 	CShaderParserStringUtilsTest::CShaderParserStringUtilsTest()
@@ -40,9 +44,12 @@ BEGIN_NAMESPACE_SHADER_PARSER_TEST
 		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserStringUtilsTest::TestCase_StringUtilsToUpperToLower, this ) ) );
 		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserStringUtilsTest::TestCase_StringUtilsConversions, this ) ) );
 		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserStringUtilsTest::TestCase_StringUtilsSplit, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserStringUtilsTest::TestCase_StringUtilsSplitView, this ) ) );
 		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserStringUtilsTest::TestCase_StringUtilsTrim, this ) ) );
 		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserStringUtilsTest::TestCase_StringUtilsReplace, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserStringUtilsTest::TestCase_StringUtilsReplaceAll, this ) ) );
 		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserStringUtilsTest::TestCase_StringUtilsFormalize, this ) ) );
+		testSuite->add( BOOST_TEST_CASE( std::bind( &CShaderParserStringUtilsTest::TestCase_StringUtilsFormat, this ) ) );
 
 		//!@remarks Return the TS instance.
 		return testSuite;
@@ -61,6 +68,25 @@ BEGIN_NAMESPACE_SHADER_PARSER_TEST
 		BOOST_CHECK( !StringUtils::IsLowerCase( L"NoTlOwErCaSe" ) );
 		BOOST_CHECK( StringUtils::IsLowerCase( L"lowercase" ) );
 
+		std::string sascii;
+
+		for ( int i = 1; i < 0x80; ++i )
+		{
+			sascii.push_back( char( i ) );
+		}
+
+		std::string sasciiupper = sascii;
+		std::string sasciilower = sascii;
+		std::transform( sasciiupper.begin(), sasciiupper.end(), sasciiupper.begin(), []( char c ) { return char( std::toupper( c ) ); } );
+		std::transform( sasciilower.begin(), sasciilower.end(), sasciilower.begin(), []( char c ) { return char( std::tolower( c ) ); } );
+		BOOST_CHECK( StringUtils::IsUpperCase( sasciiupper ) );
+		BOOST_CHECK( StringUtils::IsLowerCase( sasciilower ) );
+		BOOST_CHECK( StringUtils::IsUpperCase( sasciiupper + "\xC3\xA9" + sasciiupper ) );
+		BOOST_CHECK( !StringUtils::IsUpperCase( sasciiupper + "\xC3\xA9" + sasciilower ) );
+		BOOST_CHECK( !StringUtils::IsLowerCase( sasciilower + "\xC3\xA9" + sasciiupper ) );
+		BOOST_CHECK( StringUtils::IsLowerCase( std::wstring( L"lower case with a long tail, voilà" ) ) );
+		BOOST_CHECK( !StringUtils::IsLowerCase( std::wstring( L"lower case with a long tail, voilà, but Not" ) ) );
+
 		CLogger::LogInfo( StringStream() << "**** End TestCase_StringUtilsIsUpperIsLower ****" );
 	}
 
@@ -110,6 +136,32 @@ BEGIN_NAMESPACE_SHADER_PARSER_TEST
 		BOOST_CHECK_EQUAL( wnotlower, L"notlowercase" );
 		BOOST_CHECK_EQUAL( wlower, L"lowercase" );
 
+		std::string sascii;
+
+		for ( int i = 1; i < 0x80; ++i )
+		{
+			sascii.push_back( char( i ) );
+		}
+
+		std::string sasciiupper = sascii;
+		std::string sasciilower = sascii;
+		std::transform( sasciiupper.begin(), sasciiupper.end(), sasciiupper.begin(), []( char c ) { return char( std::toupper( c ) ); } );
+		std::transform( sasciilower.begin(), sasciilower.end(), sasciilower.begin(), []( char c ) { return char( std::tolower( c ) ); } );
+
+		for ( size_t offset = 0; offset < 17; ++offset )
+		{
+			std::string sshifted = sascii.substr( offset );
+			BOOST_CHECK_EQUAL( StringUtils::UpperCase( sshifted ), sasciiupper.substr( offset ) );
+			BOOST_CHECK_EQUAL( StringUtils::LowerCase( sshifted ), sasciilower.substr( offset ) );
+		}
+
+		std::string smixed = sascii + "\xC3\xA9" + sascii;
+		BOOST_CHECK_EQUAL( StringUtils::ToUpperCase( smixed ), sasciiupper + "\xC3\xA9" + sasciiupper );
+		BOOST_CHECK_EQUAL( StringUtils::ToLowerCase( smixed ), sasciilower + "\xC3\xA9" + sasciilower );
+		std::wstring wmixed = L"gl_FragColor = vec4( voilà );";
+		BOOST_CHECK_EQUAL( StringUtils::UpperCase( wmixed ), L"GL_FRAGCOLOR = VEC4( VOILà );" );
+		BOOST_CHECK_EQUAL( StringUtils::LowerCase( wmixed ), L"gl_fragcolor = vec4( voilà );" );
+
 		CLogger::LogInfo( StringStream() << "**** End TestCase_StringUtilsToUpperToLower ****" );
 	}
 
@@ -129,6 +181,28 @@ BEGIN_NAMESPACE_SHADER_PARSER_TEST
 		BOOST_CHECK_EQUAL( StringUtils::ToUtf8( s, "UTF-8" ), utf8 );
 		BOOST_CHECK_EQUAL( StringUtils::ToUtf8( ws, "UTF-8" ), utf8 );
 #endif
+		CLogger::LogInfo( StringStream() << "  Utf8ToUtf16/Utf8ToUtf32" );
+		// ASCII runs longer than the checked blocks, surrounded by 2, 3 and 4 bytes sequences
+		std::string ascii( 40, 'a' );
+		std::string mixed = ascii + "\xC3\x82" + ascii + "\xE2\x82\xAC" + ascii + "\xF0\x9F\x98\x80" + ascii;
+		std::u16string mixed16 = std::u16string( 40, u'a' ) + u'\u00C2' + std::u16string( 40, u'a' ) + u'\u20AC' + std::u16string( 40, u'a' ) + u"\U0001F600" + std::u16string( 40, u'a' );
+		std::u32string mixed32 = std::u32string( 40, U'a' ) + U'\u00C2' + std::u32string( 40, U'a' ) + U'\u20AC' + std::u32string( 40, U'a' ) + U'\U0001F600' + std::u32string( 40, U'a' );
+		BOOST_CHECK_EQUAL( StringUtils::AsciiLength( mixed.data(), mixed.size() ), ascii.size() );
+		BOOST_CHECK_EQUAL( StringUtils::AsciiLength( ascii.data(), ascii.size() ), ascii.size() );
+		BOOST_CHECK( StringUtils::Utf8ToUtf16( mixed ) == mixed16 );
+		BOOST_CHECK( StringUtils::Utf8ToUtf32( mixed ) == mixed32 );
+		CLogger::LogInfo( StringStream() << "  Utf16ToUtf8/Utf32ToUtf8" );
+		BOOST_CHECK_EQUAL( StringUtils::Utf16ToUtf8( mixed16 ), mixed );
+		BOOST_CHECK_EQUAL( StringUtils::Utf32ToUtf8( mixed32 ), mixed );
+		BOOST_CHECK_EQUAL( StringUtils::ToStr( StringUtils::ToWStr( mixed ) ), mixed );
+		CLogger::LogInfo( StringStream() << "  Invalid sequences" );
+		// Lone continuation byte, overlong encoding, truncated sequence, encoded surrogate
+		BOOST_CHECK( StringUtils::Utf8ToUtf32( "a\x80" "b" ) == U"a\uFFFDb" );
+		BOOST_CHECK( StringUtils::Utf8ToUtf32( "a\xC0\xAF" "b" ) == U"a\uFFFD\uFFFDb" );
+		BOOST_CHECK( StringUtils::Utf8ToUtf32( "a\xE2\x82" ) == U"a\uFFFD" );
+		BOOST_CHECK( StringUtils::Utf8ToUtf32( "\xED\xA0\x80" ) == U"\uFFFD" );
+		BOOST_CHECK_EQUAL( StringUtils::Utf16ToUtf8( std::u16string( 1, char16_t( 0xD800 ) ) + u"a" ), "\xEF\xBF\xBD" "a" );
+		BOOST_CHECK_EQUAL( StringUtils::Utf32ToUtf8( std::u32string( 1, char32_t( 0x110000 ) ) ), "\xEF\xBF\xBD" );
 		CLogger::LogInfo( StringStream() << "**** End TestCase_StringUtilsConversions ****" );
 	}
 
@@ -160,6 +234,57 @@ BEGIN_NAMESPACE_SHADER_PARSER_TEST
 		CLogger::LogInfo( StringStream() << "**** End TestCase_StringUtilsSplit ****" );
 	}
 
+	void CShaderParserStringUtilsTest::TestCase_StringUtilsSplitView()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_StringUtilsSplitView ****" );
+
+		std::string stosplit = "dsfs,gsdg,,sdfh,sdh,dshgh,dfh,dsfh,dsfhsdfhsd,fhsdfh,dfhdsh,";
+		std::vector< StringView > spieces;
+
+		for ( auto && piece : StringUtils::SplitView( stosplit, ',' ) )
+		{
+			spieces.push_back( piece );
+		}
+
+		// The pieces are views over the split string, the empty ones are kept
+		uint32_t scount = uint32_t( std::count( stosplit.begin(), stosplit.end(), ',' ) );
+		BOOST_CHECK_EQUAL( spieces.size(), scount + 1 );
+		BOOST_CHECK_EQUAL( spieces[0], StringView( "dsfs" ) );
+		BOOST_CHECK_EQUAL( spieces[2], StringView( "" ) );
+		BOOST_CHECK_EQUAL( spieces[10], StringView( "dfhdsh" ) );
+		BOOST_CHECK( spieces[1].data() == stosplit.data() + 5 );
+		BOOST_CHECK( spieces.back().empty() );
+
+		// The empty pieces are skipped
+		spieces.assign( StringUtils::SplitView( stosplit, ',', false ).begin(), StringUtils::SplitView( stosplit, ',', false ).end() );
+		BOOST_CHECK_EQUAL( spieces.size(), scount - 1 );
+		BOOST_CHECK_EQUAL( spieces.back(), StringView( "dfhdsh" ) );
+
+		// Any of multiple delimiters separates the pieces
+		std::string delims = ",;";
+		auto split = StringUtils::SplitView( "a,b;c;;d", delims, false );
+		BOOST_CHECK_EQUAL( std::distance( split.begin(), split.end() ), 4 );
+		BOOST_CHECK_EQUAL( *std::next( split.begin(), 3 ), StringView( "d" ) );
+
+		// An empty string gives one empty piece, or none
+		BOOST_CHECK_EQUAL( std::distance( StringUtils::SplitView( "", ',' ).begin(), StringUtils::SplitView( "", ',' ).end() ), 1 );
+		BOOST_CHECK_EQUAL( std::distance( StringUtils::SplitView( "", ',', false ).begin(), StringUtils::SplitView( "", ',', false ).end() ), 0 );
+
+		std::wstring wtosplit = L"dsfs\ngsdg\n\nsdfh";
+		std::vector< WStringView > wpieces;
+
+		for ( auto && piece : StringUtils::SplitView( wtosplit, L'\n' ) )
+		{
+			wpieces.push_back( piece );
+		}
+
+		BOOST_CHECK_EQUAL( wpieces.size(), 4 );
+		BOOST_CHECK( wpieces[1] == WStringView( L"gsdg" ) );
+		BOOST_CHECK( wpieces[3] == WStringView( L"sdfh" ) );
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_StringUtilsSplitView ****" );
+	}
+
 	void CShaderParserStringUtilsTest::TestCase_StringUtilsTrim()
 	{
 		CLogger::LogInfo( StringStream() << "**** Start TestCase_StringUtilsTrim ****" );
@@ -230,6 +355,41 @@ BEGIN_NAMESPACE_SHADER_PARSER_TEST
 		CLogger::LogInfo( StringStream() << "**** End TestCase_StringUtilsReplace ****" );
 	}
 
+	void CShaderParserStringUtilsTest::TestCase_StringUtilsReplaceAll()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_StringUtilsReplaceAll ****" );
+
+		std::string sreplace = "${NAME} = ${NAME_LONG}; ${NAME}${NAME}; ${NAM}";
+		BOOST_CHECK_EQUAL( StringUtils::ReplaceAll( sreplace, { { "${NAME}", "a" }, { "${NAME_LONG}", "a_long" } } ), "a = a_long; aa; ${NAM}" );
+		BOOST_CHECK_EQUAL( sreplace, "a = a_long; aa; ${NAM}" );
+		sreplace = "abcd bc abc";
+		BOOST_CHECK_EQUAL( StringUtils::ReplaceAll( sreplace, { { "abcd", "1" }, { "bc", "2" }, { "abc", "3" } } ), "1 2 3" );
+		sreplace = "aaaa";
+		BOOST_CHECK_EQUAL( StringUtils::ReplaceAll( sreplace, { { "aa", "a" } } ), "aa" );
+		sreplace = "x";
+		BOOST_CHECK_EQUAL( StringUtils::ReplaceAll( sreplace, { { "x", "xx" }, { "", "y" } } ), "xx" );
+		sreplace = "unchanged";
+		BOOST_CHECK_EQUAL( StringUtils::ReplaceAll( sreplace, {} ), "unchanged" );
+		BOOST_CHECK_EQUAL( StringUtils::ReplaceAll( sreplace, { { "changed", "" } } ), "un" );
+
+		std::wstring wreplace = L"${NAME} = ${NAME_LONG}; ${NAME}${NAME}; ${NAM}";
+		BOOST_CHECK_EQUAL( StringUtils::ReplaceAll( wreplace, { { L"${NAME}", L"voilà" }, { L"${NAME_LONG}", L"a" } } ), L"voilà = a; voilàvoilà; ${NAM}" );
+		BOOST_CHECK_EQUAL( wreplace, L"voilà = a; voilàvoilà; ${NAM}" );
+
+		CReplacer shrink( { { "float", "f" }, { "vec4", "v" } } );
+		CReplacer grow( { { "f", "float" }, { "v", "vec4" } } );
+		BOOST_CHECK( shrink.IsInPlace() );
+		BOOST_CHECK( !grow.IsInPlace() );
+
+		for ( auto && source : { std::string( "float4 vec4 floatvec4" ), std::string( "vec4float" ), std::string() } )
+		{
+			std::string text = source;
+			BOOST_CHECK_EQUAL( grow.Replace( shrink.Replace( text ) ), source );
+		}
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_StringUtilsReplaceAll ****" );
+	}
+
 	void CShaderParserStringUtilsTest::TestCase_StringUtilsFormalize()
 	{
 		CLogger::LogInfo( StringStream() << "**** Start TestCase_StringUtilsFormalize ****" );
@@ -255,5 +415,44 @@ BEGIN_NAMESPACE_SHADER_PARSER_TEST
 
 		CLogger::LogInfo( StringStream() << "**** End TestCase_StringUtilsFormalize ****" );
 	}
+
+	void CShaderParserStringUtilsTest::TestCase_StringUtilsFormat()
+	{
+		CLogger::LogInfo( StringStream() << "**** Start TestCase_StringUtilsFormat ****" );
+
+		enum ETest
+		{
+			ETest_Value = 3
+		};
+
+		int * pointer = reinterpret_cast< int * >( 0xBEEF );
+		BOOST_CHECK_EQUAL( PARSER_FORMAT( "{} {} {} {}", 42, -17, uint64_t( 18446744073709551615ULL ), int64_t( INT64_MIN ) ), "42 -17 18446744073709551615 -9223372036854775808" );
+		BOOST_CHECK_EQUAL( PARSER_FORMAT( "{}{}{}{}", 'c', true, false, ETest_Value ), "ctruefalse3" );
+		BOOST_CHECK_EQUAL( PARSER_FORMAT( "{} {} {}", 1.5, 0.1f, pointer ), "1.5 0.1 0xbeef" );
+		BOOST_CHECK_EQUAL( PARSER_FORMAT( "[{}] [{}] [{}]", "literal", std::string( "string" ), StringView( "view" ) ), "[literal] [string] [view]" );
+		BOOST_CHECK_EQUAL( PARSER_FORMAT( "{{{}}} }}{{", 0 ), "{0} }{" );
+		BOOST_CHECK_EQUAL( PARSER_FORMAT( "{}", std::wstring( L"wide" ).size() ), "4" );
+		BOOST_CHECK_EQUAL( PARSER_FORMAT( "{} {} {}", std::wstring( L"wide" ), L"caf\u00E9", static_cast< wchar_t const * >( NULL ) ), "wide caf\xC3\xA9 (null)" );
+		BOOST_CHECK_EQUAL( PARSER_FORMAT( "no argument {{}}" ), "no argument {}" );
+
+		std::string long_text( 1000, 'x' );
+		BOOST_CHECK_EQUAL( PARSER_FORMAT( "{}{}", long_text, long_text ), long_text + long_text );
+
+		std::string output = "prefix ";
+		BOOST_CHECK_EQUAL( PARSER_FORMAT_TO( output, "{} {}", "and", 1 ), "prefix and 1" );
+		BOOST_CHECK_EQUAL( StringUtils::FormatTo( output, std::string( ", {}" ), 2 ), "prefix and 1, 2" );
+		BOOST_CHECK_EQUAL( PARSER_FORMAT_TO( output, "." ), "prefix and 1, 2." );
+		BOOST_CHECK_EQUAL( StringUtils::FormatString( "{}-{}", "a", "b" ), "a-b" );
+
+		BOOST_CHECK_THROW( StringUtils::FormatString( "{} {}", 1 ), CShaderParserException );
+		BOOST_CHECK_THROW( StringUtils::FormatString( "{}", 1, 2 ), CShaderParserException );
+		BOOST_CHECK_THROW( StringUtils::FormatString( "{0}", 1 ), CShaderParserException );
+		BOOST_CHECK_THROW( StringUtils::FormatString( "}", 1 ), CShaderParserException );
+
+		static_assert( StringUtils::detail::format_placeholders( "{} {{}} {}" ) == 2, "Placeholders count" );
+		static_assert( StringUtils::detail::format_placeholders( "{ }" ) < 0, "Invalid format string" );
+
+		CLogger::LogInfo( StringStream() << "**** End TestCase_StringUtilsFormat ****" );
+	}
 }
 END_NAMESPACE_SHADER_PARSER_TEST
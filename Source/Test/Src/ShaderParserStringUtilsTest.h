@@ -73,6 +73,10 @@ BEGIN_NAMESPACE_SHADER_PARSER_TEST
 		*/
 		void TestCase_StringUtilsSplit();
 
+		/** Test StringUtils::SplitView function
+		*/
+		void TestCase_StringUtilsSplitView();
+
 		/** Test StringUtils::Trim functions
 		*/
 		void TestCase_StringUtilsTrim();
@@ -81,10 +85,18 @@ BEGIN_NAMESPACE_SHADER_PARSER_TEST
 		*/
 		void TestCase_StringUtilsReplace();
 
+		/** Test StringUtils::ReplaceAll functions, and CReplacer class
+		*/
+		void TestCase_StringUtilsReplaceAll();
+
 		/** Test StringUtils::Formalize functions
 		*/
 		void TestCase_StringUtilsFormalize();
 
+		/** Test StringUtils::FormatString functions, and PARSER_FORMAT macros
+		*/
+		void TestCase_StringUtilsFormat();
+
 		//!@}
 	};
 }
@@ -15,6 +15,9 @@
 
 #include "ShaderParserTest.h"
 #include "ShaderParserStringUtilsTest.h"
+#include "ShaderParserFileUtilsTest.h"
+#include "ShaderParserLoggerTest.h"
+#include "ShaderParserExceptionTest.h"
 #include "ShaderParserTestPluginsStaticLoader.h"
 
 #include <boost/test/unit_test.hpp>
@@ -22,6 +25,9 @@
 NAMESPACE_SHADER_PARSER::String g_path;
 
 std::unique_ptr< NAMESPACE_SHADER_PARSER_TEST::CShaderParserStringUtilsTest > g_databaseStringUtilsTest;
+std::unique_ptr< NAMESPACE_SHADER_PARSER_TEST::CShaderParserFileUtilsTest > g_fileUtilsTest;
+std::unique_ptr< NAMESPACE_SHADER_PARSER_TEST::CShaderParserLoggerTest > g_loggerTest;
+std::unique_ptr< NAMESPACE_SHADER_PARSER_TEST::CShaderParserExceptionTest > g_exceptionTest;
 std::unique_ptr< NAMESPACE_SHADER_PARSER_TEST::CTestPluginsLoader > g_pluginsLoader;
 
 void Startup( char * arg )
@@ -41,12 +47,18 @@ void Startup( char * arg )
 	NAMESPACE_SHADER_PARSER::CLogger::SetFileName( g_path + STR( "ShaderParserTest.log" ) );
 
 	g_databaseStringUtilsTest = std::make_unique< NAMESPACE_SHADER_PARSER_TEST::CShaderParserStringUtilsTest >();
+	g_fileUtilsTest = std::make_unique< NAMESPACE_SHADER_PARSER_TEST::CShaderParserFileUtilsTest >();
+	g_loggerTest = std::make_unique< NAMESPACE_SHADER_PARSER_TEST::CShaderParserLoggerTest >();
+	g_exceptionTest = std::make_unique< NAMESPACE_SHADER_PARSER_TEST::CShaderParserExceptionTest >();
 	g_pluginsLoader = std::make_unique< NAMESPACE_SHADER_PARSER_TEST::CTestPluginsLoader >();
 }
 
 void Shutdown()
 {
 	g_pluginsLoader.reset();
+	g_exceptionTest.reset();
+	g_loggerTest.reset();
+	g_fileUtilsTest.reset();
 	g_databaseStringUtilsTest.reset();
 	NAMESPACE_SHADER_PARSER::CLogger::Cleanup();
 }
@@ -113,6 +125,9 @@ BEGIN_NAMESPACE_SHADER_PARSER_TEST
 
 		//!@remarks Create the TS' sequences
 		TS_List.push_back( g_databaseStringUtilsTest->Init_Test_Suite() );
+		TS_List.push_back( g_fileUtilsTest->Init_Test_Suite() );
+		TS_List.push_back( g_loggerTest->Init_Test_Suite() );
+		TS_List.push_back( g_exceptionTest->Init_Test_Suite() );
 
 #if defined( TESTING_PLUGIN_GLSL )
 #endif
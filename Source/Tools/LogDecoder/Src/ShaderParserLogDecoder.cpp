@@ -0,0 +1,85 @@
+/************************************************************************//**
+ * @file ShaderParserLogDecoder.cpp
+ * @author Sylvain Doremus
+ * @version 1.0
+ * @date 11/23/2015
+ *
+ *
+ * @brief Decodes a binary log file, written by CLogger, to a text log file.
+ *
+ * @details Usage: ShaderParserLogDecoder <binary log file> [<text log file>]
+ *	The text is written to the standard output if no text log file is given.
+ *
+ ***************************************************************************/
+
+#include "ShaderParserLogDecoderPch.h"
+
+int main( int argc, char * argv[] )
+{
+	using namespace NAMESPACE_SHADER_PARSER;
+
+	if ( argc < 2 )
+	{
+		fprintf( stderr, "Usage: %s <binary log file> [<text log file>]\n", argv[0] );
+		return EXIT_FAILURE;
+	}
+
+	static char const * const HEADERS[ELogType_COUNT] =
+	{
+		"***DEBUG*** ",
+		"",
+		"***WARNING*** ",
+		"***ERROR*** ",
+	};
+
+	FILE * input = fopen( argv[1], "rb" );
+
+	if ( !input )
+	{
+		fprintf( stderr, "Couldn't open %s\n", argv[1] );
+		return EXIT_FAILURE;
+	}
+
+	FILE * output = argc > 2 ? fopen( argv[2], "w" ) : stdout;
+
+	if ( !output )
+	{
+		fprintf( stderr, "Couldn't open %s\n", argv[2] );
+		fclose( input );
+		return EXIT_FAILURE;
+	}
+
+	LogFormat::CTimestampFormatter formatter;
+	std::string timestamp;
+	bool result = LogFormat::DecodeBinary( input, [output, &formatter, &timestamp]( ELogType type, int64_t time, std::string const & message )
+	{
+		timestamp.clear();
+		formatter.Format( timestamp, time );
+		size_t begin = 0;
+
+		//!@remarks Multiple lines messages give one text line per message line, as in the text log files.
+		do
+		{
+			size_t end = message.find( '\n', begin );
+			std::string line = message.substr( begin, end - begin );
+			fprintf( output, "%s - %s%s\n", timestamp.c_str(), HEADERS[type], line.c_str() );
+			begin = end == std::string::npos ? end : end + 1;
+		}
+		while ( begin != std::string::npos );
+	} );
+
+	if ( output != stdout )
+	{
+		fclose( output );
+	}
+
+	fclose( input );
+
+	if ( !result )
+	{
+		fprintf( stderr, "%s is not a valid binary log file, or is truncated\n", argv[1] );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
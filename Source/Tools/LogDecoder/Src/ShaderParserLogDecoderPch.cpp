@@ -0,0 +1,14 @@
+/************************************************************************//**
+ * @file ShaderParserLogDecoderPch.cpp
+ * @author Sylvain Doremus
+ * @version 1.0
+ * @date 11/23/2015
+ *
+ *
+ * @brief ShaderParserLogDecoder precompiled header.
+ *
+ * @details This file contains all ShaderParserLogDecoder precompiled header.
+ *
+ ***************************************************************************/
+
+#include "ShaderParserLogDecoderPch.h"
@@ -0,0 +1,22 @@
+/************************************************************************//**
+ * @file ShaderParserLogDecoderPch.h
+ * @author Sylvain Doremus
+ * @version 1.0
+ * @date 11/23/2015
+ *
+ *
+ * @brief ShaderParserLogDecoder precompiled header.
+ *
+ * @details This file contains all ShaderParserLogDecoder precompiled header.
+ *
+ ***************************************************************************/
+
+#ifndef ___SHADER_PARSER_LOG_DECODER_PCH_H___
+#define ___SHADER_PARSER_LOG_DECODER_PCH_H___
+
+#include <cstdio>
+
+#include <ShaderParserPrerequisites.h>
+#include <ShaderParserLogFormat.h>
+
+#endif //___SHADER_PARSER_LOG_DECODER_PCH_H___
@@ -0,0 +1,225 @@
+/************************************************************************//**
+ * @file ShaderParserLoggerBench.cpp
+ * @author Sylvain Doremus
+ * @version 1.0
+ * @date 11/23/2015
+ *
+ *
+ * @brief Measures the CLogger throughput and latencies.
+ *
+ * @details Usage: ShaderParserLoggerBench [<max threads> [<messages per thread> [<log file>]]]
+ *	For 1 to max threads producers, with a log file or with a null sink only, and with narrow or wide messages,
+ *	prints the submission and end to end throughputs, the submission latency percentiles,
+ *	and the delivery latency percentiles, from the submission to the log sinks.
+ *	The results are printed to the standard error, since the logger prints the messages written
+ *	to the log file to the standard output, which may be redirected to exclude the console from the measures.
+ *
+ ***************************************************************************/
+
+#include "ShaderParserLoggerBenchPch.h"
+
+namespace
+{
+	using namespace NAMESPACE_SHADER_PARSER;
+
+	/** A benchmark run configuration
+	*/
+	struct SRun
+	{
+		//! The log file, empty for a null sink only
+		String m_file;
+		//! Tells if the messages are wide strings
+		bool m_wide;
+		//! The producer threads count
+		uint32_t m_threads;
+		//! The messages count, per producer thread
+		uint32_t m_messages;
+	};
+
+	/** Retrieves the given percentile of a latencies array
+	@param[in] latencies
+		The latencies, partially sorted by the function
+	@param[in] percentile
+		The percentile, in [0, 1]
+	@return
+		The latency, 0 if the array is empty.
+	*/
+	int64_t Percentile( std::vector< int64_t > & latencies, double percentile )
+	{
+		if ( latencies.empty() )
+		{
+			return 0;
+		}
+
+		auto nth = latencies.begin() + std::min( latencies.size() - 1, size_t( percentile * latencies.size() ) );
+		std::nth_element( latencies.begin(), nth, latencies.end() );
+		return *nth;
+	}
+
+	/** Logs the messages of one producer thread, measuring each submission latency
+	@param[in] run
+		The run configuration
+	@param[in] index
+		The producer index
+	@param[out] latencies
+		Receives the submission latencies, in nanoseconds
+	*/
+	void Produce( SRun const & run, uint32_t index, std::vector< int64_t > & latencies )
+	{
+		latencies.resize( run.m_messages );
+		std::string narrow = "Benchmark message from producer " + std::to_string( index ) + ", number ";
+		std::wstring wide = L"Benchmark message from producer " + std::to_wstring( index ) + L", number ";
+		size_t narrowSize = narrow.size();
+		size_t wideSize = wide.size();
+
+		for ( uint32_t i = 0; i < run.m_messages; ++i )
+		{
+			//!@remarks The message is built outside of the measured section, only the submission is measured.
+			if ( run.m_wide )
+			{
+				wide.resize( wideSize );
+				wide += std::to_wstring( i );
+				auto begin = std::chrono::steady_clock::now();
+				CLogger::LogInfo( wide );
+				latencies[i] = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - begin ).count();
+			}
+			else
+			{
+				narrow.resize( narrowSize );
+				narrow += std::to_string( i );
+				auto begin = std::chrono::steady_clock::now();
+				CLogger::LogInfo( narrow );
+				latencies[i] = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - begin ).count();
+			}
+		}
+	}
+
+	/** Runs a benchmark configuration, and prints its results
+	@param[in] run
+		The run configuration
+	*/
+	void Run( SRun const & run )
+	{
+		CLogger::Initialise( ELogType_INFO );
+
+		if ( !run.m_file.empty() )
+		{
+			CLogger::SetFileName( run.m_file );
+		}
+
+		//!@remarks The null sink only measures the delivery latency, sampled so it stays negligible.
+		std::vector< int64_t > delivery;
+		delivery.reserve( size_t( run.m_threads ) * run.m_messages / 16 + 1 );
+		uint64_t delivered = 0;
+		LogSinkSPtr sink = std::make_shared< CCallbackLogSink >( [&delivery, &delivered]( LogRecordArray const & records )
+		{
+			int64_t now = std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::system_clock::now().time_since_epoch() ).count();
+
+			for ( auto && record : records )
+			{
+				if ( ( delivered++ % 16 ) == 0 )
+				{
+					delivery.push_back( now - record.m_time );
+				}
+			}
+		} );
+		CLogger::AddSink( sink );
+
+		std::vector< std::vector< int64_t > > latencies( run.m_threads );
+		std::vector< std::thread > producers;
+		auto begin = std::chrono::steady_clock::now();
+
+		for ( uint32_t i = 0; i < run.m_threads; ++i )
+		{
+			producers.emplace_back( Produce, std::cref( run ), i, std::ref( latencies[i] ) );
+		}
+
+		for ( auto & producer : producers )
+		{
+			producer.join();
+		}
+
+		auto submitted = std::chrono::steady_clock::now();
+		CLogger::Flush();
+		auto end = std::chrono::steady_clock::now();
+		CLogger::RemoveSink( sink );
+		CLogger::Cleanup();
+
+		std::vector< int64_t > submission;
+		submission.reserve( size_t( run.m_threads ) * run.m_messages );
+
+		for ( auto && thread : latencies )
+		{
+			submission.insert( submission.end(), thread.begin(), thread.end() );
+		}
+
+		double total = double( submission.size() );
+		fprintf( stderr, "%-5s %-6s %7u %12.0f %12.0f %9lld %9lld %9lld %9lld %9lld %9lld\n"
+				, run.m_file.empty() ? "null" : "file"
+				, run.m_wide ? "wide" : "narrow"
+				, run.m_threads
+				, total / std::chrono::duration< double >( submitted - begin ).count()
+				, total / std::chrono::duration< double >( end - begin ).count()
+				, ( long long )Percentile( submission, 0.5 )
+				, ( long long )Percentile( submission, 0.99 )
+				, ( long long )Percentile( submission, 0.999 )
+				, ( long long )Percentile( delivery, 0.5 )
+				, ( long long )Percentile( delivery, 0.99 )
+				, ( long long )Percentile( delivery, 0.999 ) );
+		fflush( stderr );
+	}
+}
+
+int main( int argc, char * argv[] )
+{
+	uint32_t maxThreads = std::max( 1u, std::thread::hardware_concurrency() );
+	uint32_t messages = 100000;
+	String file = STR( "ShaderParserLoggerBench.log" );
+
+	if ( argc > 1 )
+	{
+		maxThreads = std::max( 1, atoi( argv[1] ) );
+	}
+
+	if ( argc > 2 )
+	{
+		messages = std::max( 1, atoi( argv[2] ) );
+	}
+
+	if ( argc > 3 )
+	{
+		file = argv[3];
+	}
+
+#if !defined( NDEBUG )
+	fprintf( stderr, "Warning: debug build, the messages are also printed to the console, the results are not representative\n" );
+#endif
+
+	std::vector< uint32_t > threads;
+
+	for ( uint32_t count = 1; count < maxThreads; count *= 2 )
+	{
+		threads.push_back( count );
+	}
+
+	threads.push_back( maxThreads );
+
+	fprintf( stderr, "%-5s %-6s %7s %12s %12s %9s %9s %9s %9s %9s %9s\n"
+			, "sink", "text", "threads", "submit/s", "deliver/s"
+			, "p50 ns", "p99 ns", "p999 ns"
+			, "dlv50 us", "dlv99 us", "dlv999 us" );
+
+	for ( auto && path : { String(), file } )
+	{
+		for ( bool wide : { false, true } )
+		{
+			for ( uint32_t count : threads )
+			{
+				Run( SRun{ path, wide, count, messages } );
+			}
+		}
+	}
+
+	std::remove( file.c_str() );
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,14 @@
+/************************************************************************//**
+ * @file ShaderParserLoggerBenchPch.cpp
+ * @author Sylvain Doremus
+ * @version 1.0
+ * @date 11/23/2015
+ *
+ *
+ * @brief ShaderParserLoggerBench precompiled header.
+ *
+ * @details This file contains all ShaderParserLoggerBench precompiled header.
+ *
+ ***************************************************************************/
+
+#include "ShaderParserLoggerBenchPch.h"
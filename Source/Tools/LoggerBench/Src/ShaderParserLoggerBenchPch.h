@@ -0,0 +1,26 @@
+/************************************************************************//**
+ * @file ShaderParserLoggerBenchPch.h
+ * @author Sylvain Doremus
+ * @version 1.0
+ * @date 11/23/2015
+ *
+ *
+ * @brief ShaderParserLoggerBench precompiled header.
+ *
+ * @details This file contains all ShaderParserLoggerBench precompiled header.
+ *
+ ***************************************************************************/
+
+#ifndef ___SHADER_PARSER_LOGGER_BENCH_PCH_H___
+#define ___SHADER_PARSER_LOGGER_BENCH_PCH_H___
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include <ShaderParserPrerequisites.h>
+#include <ShaderParserLogger.h>
+#include <ShaderParserLogSink.h>
+
+#endif //___SHADER_PARSER_LOGGER_BENCH_PCH_H___